@@ -31,6 +31,10 @@
 #include "View/MapDocumentCommandFacade.h"
 #include "View/MapFrame.h"
 
+#include "kdl/task_scheduler.h"
+
+#include <cstdlib>
+
 extern void qt_set_sequence_auto_mnemonic(bool b);
 
 int main(int argc, char* argv[])
@@ -79,6 +83,15 @@ int main(int argc, char* argv[])
         QSettings::setPath(
           QSettings::IniFormat, QSettings::UserScope, QString("./config"));
       }
+      // the worker count must be set before the global task scheduler is first used
+      else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+      {
+        const auto workerCount = std::strtol(argv[i + 1], nullptr, 10);
+        if (workerCount > 0)
+        {
+          kdl::set_global_task_scheduler_worker_count(size_t(workerCount - 1));
+        }
+      }
     }
   }
 
@@ -0,0 +1,87 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+
+#include <cstdlib>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+// clang-format off
+#include <windows.h>
+#include <psapi.h>
+// clang-format on
+#else
+#include <sys/resource.h>
+#endif
+
+size_t peakMemoryUsage()
+{
+#if defined(_WIN32)
+  auto counters = PROCESS_MEMORY_COUNTERS{};
+  return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))
+           ? size_t(counters.PeakWorkingSetSize)
+           : 0;
+#else
+  auto usage = rusage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return size_t(usage.ru_maxrss);
+#else
+  return size_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+void recordBenchmarkResult(const std::string& name, const double milliseconds)
+{
+  const auto* path = std::getenv("TB_BENCHMARK_JSON");
+  if (!path || !*path)
+  {
+    return;
+  }
+
+  auto* file = std::fopen(path, "a");
+  if (!file)
+  {
+    return;
+  }
+
+  auto escapedName = std::string{};
+  for (const auto c : name)
+  {
+    if (c == '"' || c == '\\')
+    {
+      escapedName += '\\';
+    }
+    escapedName += c;
+  }
+
+  std::fprintf(
+    file,
+    "{\"name\": \"%s\", \"milliseconds\": %f, \"peakMemoryBytes\": %zu}\n",
+    escapedName.c_str(),
+    milliseconds,
+    peakMemoryUsage());
+  std::fclose(file);
+}
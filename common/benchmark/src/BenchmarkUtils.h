@@ -20,6 +20,8 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <cstdio>
 #include <string>
 
 #ifdef __GNUC__
@@ -28,6 +30,19 @@
 #define TB_NOINLINE
 #endif
 
+/**
+ * Returns the peak resident set size of this process in bytes, or 0 if it cannot be
+ * determined.
+ */
+size_t peakMemoryUsage();
+
+/**
+ * If the environment variable TB_BENCHMARK_JSON is set, appends the given result to the
+ * file it names as a single line JSON object, so that the results of several runs can
+ * be collected and compared by external tools.
+ */
+void recordBenchmarkResult(const std::string& name, double milliseconds);
+
 // the noinline is so you can see the timeLambda when profiling
 template <class L>
 TB_NOINLINE static void timeLambda(L&& lambda, const std::string& message)
@@ -36,8 +51,7 @@ TB_NOINLINE static void timeLambda(L&& lambda, const std::string& message)
   lambda();
   const auto end = std::chrono::high_resolution_clock::now();
 
-  printf(
-    "Time elapsed for '%s': %fms\n",
-    message.c_str(),
-    std::chrono::duration<double>(end - start).count() * 1000.0);
+  const auto milliseconds = std::chrono::duration<double>(end - start).count() * 1000.0;
+  printf("Time elapsed for '%s': %fms\n", message.c_str(), milliseconds);
+  recordBenchmarkResult(message, milliseconds);
 }
@@ -0,0 +1,268 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "IO/NodeWriter.h"
+#include "IO/StandardMapParser.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNodeIndex.h"
+#include "Model/EntityProperties.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+const auto worldBounds = vm::bbox3{32768.0};
+
+std::unique_ptr<Model::WorldNode> makeWorld(
+  const Model::MapFormat mapFormat, const size_t brushCount)
+{
+  auto world = std::make_unique<Model::WorldNode>(
+    Model::EntityPropertyConfig{}, Model::Entity{}, mapFormat);
+  const auto builder = Model::BrushBuilder{mapFormat, worldBounds};
+
+  auto brushNodes = std::vector<Model::Node*>{};
+  brushNodes.reserve(brushCount);
+  for (size_t i = 0; i < brushCount; ++i)
+  {
+    const auto offset = vm::vec3{
+      FloatType(i % 256) * 64.0,
+      FloatType((i / 256) % 256) * 64.0,
+      FloatType(i / 65536) * 64.0};
+    auto brush = builder.createCuboid(
+                   vm::bbox3{offset, offset + vm::vec3{32, 32, 32}},
+                   "material_" + std::to_string(i % 64))
+                 | kdl::value();
+    brushNodes.push_back(new Model::BrushNode{std::move(brush)});
+  }
+  world->defaultLayer()->addChildren(brushNodes);
+  return world;
+}
+
+std::string makeEntityMap(const size_t entityCount)
+{
+  static const auto classnames = std::vector<std::string>{
+    "light",
+    "info_player_deathmatch",
+    "item_health",
+    "weapon_supershotgun",
+    "monster_ogre",
+    "trigger_relay",
+    "path_corner",
+    "misc_explobox",
+  };
+
+  auto str = std::stringstream{};
+  str << "{\n\"classname\" \"worldspawn\"\n}\n";
+  for (size_t i = 0; i < entityCount; ++i)
+  {
+    str << "{\n"
+        << "\"classname\" \"" << classnames[i % classnames.size()] << "\"\n"
+        << "\"origin\" \"" << (i % 256) * 64 << " " << ((i / 256) % 256) * 64 << " "
+        << (i / 65536) * 64 << "\"\n"
+        << "\"angle\" \"" << (i % 8) * 45 << "\"\n"
+        << "\"spawnflags\" \"" << i % 4 << "\"\n"
+        << "\"targetname\" \"t" << i << "\"\n"
+        << "\"target\" \"t" << (i + 1) % entityCount << "\"\n"
+        << "}\n";
+  }
+  return str.str();
+}
+
+std::vector<std::vector<Model::BrushFace>> collectBrushFaces(
+  const Model::WorldNode& world)
+{
+  auto result = std::vector<std::vector<Model::BrushFace>>{};
+  for (const auto* child : world.defaultLayer()->children())
+  {
+    if (const auto* brushNode = dynamic_cast<const Model::BrushNode*>(child))
+    {
+      result.push_back(brushNode->brush().faces());
+    }
+  }
+  return result;
+}
+} // namespace
+
+// The peak memory usage only grows, so run this test on its own to see how much memory
+// the entities and their properties use.
+TEST_CASE("MapBenchmark.loadEntities")
+{
+  using namespace Model;
+
+  const auto entityCount = size_t(50'000);
+  const auto prefix = std::to_string(entityCount) + " entities: ";
+  const auto str = makeEntityMap(entityCount);
+
+  const auto memoryBefore = peakMemoryUsage();
+  auto world = std::unique_ptr<WorldNode>{};
+  timeLambda(
+    [&]() {
+      auto status = TestParserStatus{};
+      auto reader = WorldReader{str, MapFormat::Standard, {}};
+      world = reader.read(worldBounds, status);
+    },
+    prefix + "read");
+  REQUIRE(world != nullptr);
+  CHECK(world->defaultLayer()->childCount() == entityCount);
+
+  const auto memoryAfter = peakMemoryUsage();
+  printf(
+    "Peak memory growth for '%s': %zu KiB\n",
+    (prefix + "read").c_str(),
+    (memoryAfter - memoryBefore) / 1024);
+
+  auto targetCount = size_t(0);
+  timeLambda(
+    [&]() {
+      const auto& index = world->entityNodeIndex();
+      const auto query = EntityNodeIndexQuery::exact(EntityPropertyKeys::Targetname);
+      for (size_t i = 0; i < entityCount; ++i)
+      {
+        targetCount += index.findEntityNodes(query, "t" + std::to_string(i)).size();
+      }
+    },
+    prefix + "find targets");
+  CHECK(targetCount == entityCount);
+}
+
+TEST_CASE("MapBenchmark.loadAndSave")
+{
+  using namespace Model;
+
+  const auto mapFormat = GENERATE(
+    MapFormat::Standard,
+    MapFormat::Quake2,
+    MapFormat::Quake2_Valve,
+    MapFormat::Valve,
+    MapFormat::Hexen2,
+    MapFormat::Daikatana,
+    MapFormat::Quake3_Legacy,
+    MapFormat::Quake3_Valve,
+    MapFormat::Quake3);
+  const auto brushCount = GENERATE(size_t(50'000), size_t(200'000));
+
+  const auto prefix =
+    formatName(mapFormat) + " " + std::to_string(brushCount) + " brushes: ";
+
+  const auto world = makeWorld(mapFormat, brushCount);
+
+  auto str = std::string{};
+  timeLambda(
+    [&]() {
+      auto stream = std::stringstream{};
+      auto writer = NodeWriter{*world, stream};
+      writer.writeMap();
+      str = stream.str();
+    },
+    prefix + "serialize");
+
+  auto tokenCount = size_t{0};
+  timeLambda(
+    [&]() {
+      auto tokenizer = QuakeMapTokenizer{str};
+      while (!tokenizer.nextToken().hasType(QuakeMapToken::Eof))
+      {
+        ++tokenCount;
+      }
+    },
+    prefix + "tokenize");
+  CHECK(tokenCount > brushCount);
+
+  auto numberSum = 0.0;
+  timeLambda(
+    [&]() {
+      auto tokenizer = QuakeMapTokenizer{str};
+      for (auto token = tokenizer.nextToken(); !token.hasType(QuakeMapToken::Eof);
+           token = tokenizer.nextToken())
+      {
+        if (token.hasType(QuakeMapToken::Number))
+        {
+          numberSum += token.toFloat<double>();
+        }
+      }
+    },
+    prefix + "tokenize and convert numbers");
+  CHECK(numberSum != 0.0);
+
+  auto serialWorld = std::unique_ptr<WorldNode>{};
+  timeLambda(
+    [&]() {
+      auto status = TestParserStatus{};
+      auto reader = WorldReader{str, mapFormat, {}};
+      reader.setParallelParsingThreshold(std::numeric_limits<size_t>::max());
+      serialWorld = reader.read(worldBounds, status);
+    },
+    prefix + "read (serial parsing)");
+  REQUIRE(serialWorld != nullptr);
+  CHECK(serialWorld->defaultLayer()->childCount() == brushCount);
+  serialWorld.reset();
+
+  auto parallelWorld = std::unique_ptr<WorldNode>{};
+  timeLambda(
+    [&]() {
+      auto status = TestParserStatus{};
+      auto reader = WorldReader{str, mapFormat, {}};
+      reader.setParallelParsingThreshold(0);
+      parallelWorld = reader.read(worldBounds, status);
+    },
+    prefix + "read (parallel parsing)");
+  REQUIRE(parallelWorld != nullptr);
+  CHECK(parallelWorld->defaultLayer()->childCount() == brushCount);
+
+  // the geometry is already built when reading, time it separately to see how much it
+  // contributes to the read timings
+  const auto brushFaces = collectBrushFaces(*parallelWorld);
+  auto brushes = std::vector<Brush>{};
+  brushes.reserve(brushFaces.size());
+  timeLambda(
+    [&]() {
+      for (const auto& faces : brushFaces)
+      {
+        brushes.push_back(Brush::create(worldBounds, faces) | kdl::value());
+      }
+    },
+    prefix + "build brush geometry");
+  CHECK(brushes.size() == brushCount);
+}
+
+} // namespace TrenchBroom::IO
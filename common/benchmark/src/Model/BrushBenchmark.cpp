@@ -0,0 +1,381 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/BrushGeometry.h"
+#include "Model/MapFormat.h"
+#include "Model/Polyhedron.h"
+#include "Model/Polyhedron3.h"
+
+#include "kdl/parallel.h"
+#include "kdl/result.h"
+#include "kdl/vector_utils.h"
+
+#include "vm/approx.h"
+#include "vm/bbox.h"
+#include "vm/intersection.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <cmath>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t NumBrushes = 100'000;
+constexpr size_t NumTransformedBrushes = 20'000;
+constexpr size_t NumSubtractedBrushes = 5'000;
+constexpr size_t NumConvexHulls = 200;
+constexpr size_t NumConvexHullPoints = 2'000;
+
+const auto worldBounds = vm::bbox3{8192.0};
+
+std::vector<std::vector<BrushFace>> makeBrushFaces(const size_t count = NumBrushes)
+{
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto result = std::vector<std::vector<BrushFace>>{};
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto offset = vm::vec3{
+      FloatType(i % 100) * 64.0, FloatType((i / 100) % 100) * 64.0, FloatType(i / 10000) * 64.0};
+    const auto brush =
+      builder.createCuboid(vm::bbox3{offset, offset + vm::vec3{32, 32, 32}}, "material")
+      | kdl::value();
+    result.push_back(brush.faces());
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("BrushBenchmark.createCopyClip")
+{
+  const auto brushFaces = makeBrushFaces();
+
+  auto brushes = std::vector<Brush>{};
+  brushes.reserve(NumBrushes);
+  timeLambda(
+    [&]() {
+      for (const auto& faces : brushFaces)
+      {
+        brushes.push_back(Brush::create(worldBounds, faces) | kdl::value());
+      }
+    },
+    "create " + std::to_string(NumBrushes) + " brushes");
+
+  auto copies = std::vector<Brush>{};
+  copies.reserve(NumBrushes);
+  timeLambda(
+    [&]() {
+      for (const auto& brush : brushes)
+      {
+        copies.push_back(brush);
+      }
+    },
+    "copy " + std::to_string(NumBrushes) + " brushes");
+
+  auto clipErrors = size_t{0};
+  timeLambda(
+    [&]() {
+      for (auto& brush : copies)
+      {
+        // cut off one corner of the brush
+        const auto bounds = brush.bounds();
+        const auto& min = bounds.min;
+        const auto& max = bounds.max;
+        auto face = BrushFace::create(
+                      vm::vec3{max.x(), min.y(), max.z()},
+                      vm::vec3{min.x(), max.y(), max.z()},
+                      vm::vec3{max.x(), max.y(), min.z()},
+                      BrushFaceAttributes{"material"},
+                      MapFormat::Standard)
+                    | kdl::value();
+        if (brush.clip(worldBounds, std::move(face)).is_error())
+        {
+          ++clipErrors;
+        }
+      }
+    },
+    "clip " + std::to_string(NumBrushes) + " brushes");
+  CHECK(clipErrors == 0u);
+
+  timeLambda([&]() { copies.clear(); }, "destroy " + std::to_string(NumBrushes) + " brushes");
+}
+
+TEST_CASE("BrushBenchmark.transform")
+{
+  auto brushes = kdl::vec_transform(makeBrushFaces(NumTransformedBrushes), [](auto faces) {
+    return Brush::create(worldBounds, std::move(faces)) | kdl::value();
+  });
+
+  const auto timeTransform = [&](
+                               const vm::mat4x4& transformation, const std::string& name) {
+    auto errors = size_t{0};
+    timeLambda(
+      [&]() {
+        // simulate dragging the brushes with the mouse
+        for (size_t i = 0; i < 10; ++i)
+        {
+          for (auto& brush : brushes)
+          {
+            if (brush.transform(worldBounds, transformation, true).is_error())
+            {
+              ++errors;
+            }
+          }
+        }
+      },
+      name + " " + std::to_string(NumTransformedBrushes) + " brushes 10 times");
+    CHECK(errors == 0u);
+  };
+
+  timeTransform(vm::translation_matrix(vm::vec3{16, 0, 0}), "move");
+
+  // rotate about the center of the brushes so that they remain within the world bounds
+  const auto center = vm::vec3{3200, 3200, 0};
+  timeTransform(
+    vm::translation_matrix(center)
+      * vm::rotation_matrix(vm::vec3::pos_z(), vm::to_radians(15.0))
+      * vm::translation_matrix(-center),
+    "rotate");
+}
+
+TEST_CASE("BrushBenchmark.pick")
+{
+  const auto brushes = kdl::vec_transform(makeBrushFaces(), [](auto faces) {
+    return Brush::create(worldBounds, std::move(faces)) | kdl::value();
+  });
+
+  // aim a ray at the center of each brush from above and from the side
+  const auto rays = kdl::vec_transform(brushes, [](const auto& brush) {
+    const auto center = brush.bounds().center();
+    const auto origin = center + vm::vec3{-100, -40, 70};
+    return vm::ray3{origin, vm::normalize(center - origin)};
+  });
+
+  auto faceHits = std::vector<std::optional<FloatType>>(NumBrushes);
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumBrushes; ++i)
+      {
+        for (const auto& face : brushes[i].faces())
+        {
+          if (const auto distance = face.intersectWithRay(rays[i]))
+          {
+            faceHits[i] = distance;
+            break;
+          }
+        }
+      }
+    },
+    "pick " + std::to_string(NumBrushes) + " brushes by face");
+
+  auto planes = kdl::vec_transform(brushes, [](const auto& brush) {
+    const auto count = brush.faceCount();
+    auto result = std::vector<FloatType>(4u * count);
+    for (size_t i = 0u; i < count; ++i)
+    {
+      const auto& boundary = brush.face(i).boundary();
+      result[i] = boundary.normal.x();
+      result[count + i] = boundary.normal.y();
+      result[2u * count + i] = boundary.normal.z();
+      result[3u * count + i] = boundary.distance;
+    }
+    return result;
+  });
+
+  auto planeHits = std::vector<std::optional<FloatType>>(NumBrushes);
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumBrushes; ++i)
+      {
+        const auto count = brushes[i].faceCount();
+        const auto* data = planes[i].data();
+        if (
+          const auto hit = vm::intersect_ray_convex_polyhedron(
+            rays[i], data, data + count, data + 2u * count, data + 3u * count, count))
+        {
+          planeHits[i] = hit->first;
+        }
+      }
+    },
+    "pick " + std::to_string(NumBrushes) + " brushes by plane");
+
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    REQUIRE(planeHits[i].has_value() == faceHits[i].has_value());
+    if (planeHits[i])
+    {
+      CHECK(*planeHits[i] == vm::approx{*faceHits[i]});
+    }
+  }
+}
+
+TEST_CASE("BrushBenchmark.subtract")
+{
+  // the brushes form a grid of 100 x 50 cubes, the cylinder carves a hole into its center
+  const auto brushes =
+    kdl::vec_transform(makeBrushFaces(NumSubtractedBrushes), [](auto faces) {
+      return Brush::create(worldBounds, std::move(faces)) | kdl::value();
+    });
+
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+  const auto cylinder =
+    builder.createCylinder(
+      vm::bbox3{{800, 400, -16}, {5600, 2800, 48}},
+      256,
+      RadiusMode::ToEdge,
+      vm::axis::z,
+      "material")
+    | kdl::value();
+  const auto subtrahends = std::vector<const Brush*>{&cylinder};
+
+  const auto subtract = [&](const Brush& minuend) {
+    return minuend.subtract(MapFormat::Standard, worldBounds, "material", subtrahends);
+  };
+
+  auto serialResults = std::vector<std::vector<Result<Brush>>>{};
+  timeLambda(
+    [&]() {
+      // Brush::subtract computes the fragments in parallel, too
+      const auto serial = kdl::serial_scope{};
+      serialResults = kdl::vec_transform(brushes, subtract);
+    },
+    "subtract cylinder from " + std::to_string(NumSubtractedBrushes)
+      + " brushes serially");
+
+  auto parallelResults = std::vector<std::vector<Result<Brush>>>{};
+  timeLambda(
+    [&]() { parallelResults = kdl::vec_parallel_transform(brushes, subtract); },
+    "subtract cylinder from " + std::to_string(NumSubtractedBrushes)
+      + " brushes in parallel");
+
+  const auto toBounds = [](const auto& results) {
+    return kdl::vec_transform(kdl::vec_flatten(results), [](const auto& result) {
+      return result | kdl::transform([](const auto& brush) { return brush.bounds(); })
+             | kdl::value();
+    });
+  };
+  CHECK(toBounds(parallelResults) == toBounds(serialResults));
+}
+
+TEST_CASE("BrushBenchmark.convexHull")
+{
+  SECTION("Move a vertex of a sphere")
+  {
+    // this is what the vertex tool does when a vertex is dragged
+    const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+    const auto sphere =
+      builder.createUVSphere(
+        vm::bbox3{{-512, -512, -512}, {512, 512, 512}},
+        32,
+        16,
+        RadiusMode::ToEdge,
+        vm::axis::z,
+        "material")
+      | kdl::value();
+
+    auto positions = sphere.vertexPositions();
+    positions.front() = positions.front() * 1.5;
+
+    auto vertexCount = size_t(0);
+    timeLambda(
+      [&]() {
+        for (size_t i = 0; i < NumConvexHulls; ++i)
+        {
+          vertexCount += BrushGeometry{positions}.vertexCount();
+        }
+      },
+      "compute convex hull of " + std::to_string(positions.size()) + " sphere vertices "
+        + std::to_string(NumConvexHulls) + " times");
+    CHECK(vertexCount > 0);
+
+    auto incrementalVertexCount = size_t(0);
+    timeLambda(
+      [&]() {
+        for (size_t i = 0; i < NumConvexHulls; ++i)
+        {
+          incrementalVertexCount +=
+            BrushGeometry::incrementalConvexHull(positions).vertexCount();
+        }
+      },
+      "compute convex hull of " + std::to_string(positions.size())
+        + " sphere vertices one by one " + std::to_string(NumConvexHulls) + " times");
+    CHECK(incrementalVertexCount == vertexCount);
+  }
+
+  SECTION("Random points")
+  {
+    auto rng = std::mt19937{0};
+    auto dist = std::uniform_real_distribution<FloatType>{-1.0, 1.0};
+
+    // most of the points are inside of the hull
+    auto points = std::vector<vm::vec3>{};
+    points.reserve(NumConvexHullPoints);
+    while (points.size() < NumConvexHullPoints)
+    {
+      const auto point = vm::vec3{dist(rng), dist(rng), dist(rng)};
+      if (vm::squared_length(point) <= 1.0)
+      {
+        points.push_back(vm::round(point * 1024.0));
+      }
+    }
+
+    auto vertexCount = size_t(0);
+    timeLambda(
+      [&]() {
+        for (size_t i = 0; i < NumConvexHulls / 10; ++i)
+        {
+          vertexCount += Polyhedron3{points}.vertexCount();
+        }
+      },
+      "compute convex hull of " + std::to_string(NumConvexHullPoints) + " random points "
+        + std::to_string(NumConvexHulls / 10) + " times");
+    CHECK(vertexCount > 0);
+
+    auto incrementalVertexCount = size_t(0);
+    timeLambda(
+      [&]() {
+        for (size_t i = 0; i < NumConvexHulls / 10; ++i)
+        {
+          incrementalVertexCount +=
+            Polyhedron3::incrementalConvexHull(points).vertexCount();
+        }
+      },
+      "compute convex hull of " + std::to_string(NumConvexHullPoints)
+        + " random points one by one " + std::to_string(NumConvexHulls / 10) + " times");
+    CHECK(incrementalVertexCount == vertexCount);
+  }
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,185 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/EditorContext.h"
+#include "Model/Entity.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/NodeTree.h"
+#include "Model/PickResult.h"
+#include "Model/WorldNode.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t RoomCount = 8;
+constexpr FloatType RoomSize = 2048.0;
+constexpr size_t DetailBrushesPerRoom = 500;
+constexpr size_t NumQueries = 10'000;
+
+const auto worldBounds = vm::bbox3{32768.0};
+
+/**
+ * Creates a world that resembles a real map: a grid of rooms enclosed by large wall
+ * brushes, each filled with many small detail brushes, and a skybox that encloses the
+ * entire map.
+ */
+std::unique_ptr<WorldNode> makeWorld(std::mt19937& rng)
+{
+  auto world =
+    std::make_unique<WorldNode>(EntityPropertyConfig{}, Entity{}, MapFormat::Standard);
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto brushNodes = std::vector<Node*>{};
+  const auto addBrush = [&](const vm::bbox3& bounds) {
+    brushNodes.push_back(
+      new BrushNode{builder.createCuboid(bounds, "material") | kdl::value()});
+  };
+
+  const auto mapSize = FloatType(RoomCount) * RoomSize;
+  const auto wall = FloatType(64);
+  addBrush({{-wall, -wall, -wall}, {mapSize + wall, mapSize + wall, 0}});
+  addBrush({{-wall, -wall, RoomSize}, {mapSize + wall, mapSize + wall, RoomSize + wall}});
+  addBrush({{-wall, -wall, 0}, {0, mapSize + wall, RoomSize}});
+  addBrush({{mapSize, -wall, 0}, {mapSize + wall, mapSize + wall, RoomSize}});
+  addBrush({{0, -wall, 0}, {mapSize, 0, RoomSize}});
+  addBrush({{0, mapSize, 0}, {mapSize, mapSize + wall, RoomSize}});
+
+  auto position = std::uniform_real_distribution<FloatType>{0, RoomSize - 64};
+  auto size = std::uniform_int_distribution<int>{1, 8};
+
+  for (size_t x = 0; x < RoomCount; ++x)
+  {
+    for (size_t y = 0; y < RoomCount; ++y)
+    {
+      const auto origin = vm::vec3{FloatType(x) * RoomSize, FloatType(y) * RoomSize, 0};
+      addBrush({origin, origin + vm::vec3{RoomSize - wall, wall, RoomSize}});
+      addBrush({origin, origin + vm::vec3{wall, RoomSize - wall, RoomSize}});
+
+      for (size_t i = 0; i < DetailBrushesPerRoom; ++i)
+      {
+        const auto min = vm::round(
+          origin + vm::vec3{position(rng), position(rng), position(rng)});
+        const auto extent = vm::vec3{
+          FloatType(size(rng) * 8), FloatType(size(rng) * 8), FloatType(size(rng) * 8)};
+        addBrush({min, min + extent});
+      }
+    }
+  }
+
+  world->defaultLayer()->addChildren(brushNodes);
+  return world;
+}
+} // namespace
+
+TEST_CASE("NodeTreeBenchmark.queries")
+{
+  auto rng = std::mt19937{0};
+  auto world = makeWorld(rng);
+
+  const auto mapSize = FloatType(RoomCount) * RoomSize;
+  auto coordinate = std::uniform_real_distribution<FloatType>{0, mapSize};
+  auto height = std::uniform_real_distribution<FloatType>{0, RoomSize};
+  auto direction = std::uniform_real_distribution<FloatType>{-1, 1};
+
+  auto rays = std::vector<vm::ray3>{};
+  auto points = std::vector<vm::vec3>{};
+  auto boxes = std::vector<vm::bbox3>{};
+  for (size_t i = 0; i < NumQueries; ++i)
+  {
+    const auto point = vm::vec3{coordinate(rng), coordinate(rng), height(rng)};
+    rays.emplace_back(
+      point, vm::normalize(vm::vec3{direction(rng), direction(rng), direction(rng)}));
+    points.push_back(point);
+    boxes.emplace_back(point - vm::vec3{64, 64, 64}, point + vm::vec3{64, 64, 64});
+  }
+
+  const auto nodeTreeType = GENERATE(NodeTreeType::Octree, NodeTreeType::Bvh);
+  const auto prefix =
+    std::string{nodeTreeType == NodeTreeType::Octree ? "octree" : "bvh"} + ": ";
+
+  world->setNodeTreeType(nodeTreeType);
+  timeLambda([&]() { world->rebuildNodeTree(); }, prefix + "rebuild node tree");
+
+  const auto editorContext = EditorContext{};
+  auto hitCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        auto pickResult = PickResult{};
+        world->pick(editorContext, ray, pickResult);
+        hitCount += pickResult.size();
+      }
+    },
+    prefix + "pick " + std::to_string(NumQueries) + " rays");
+
+  auto containerCount = size_t(0);
+  timeLambda(
+    [&]() {
+      auto nodes = std::vector<Node*>{};
+      for (const auto& point : points)
+      {
+        world->findNodesContaining(point, nodes);
+        containerCount += nodes.size();
+        nodes.clear();
+      }
+    },
+    prefix + "find nodes containing " + std::to_string(NumQueries) + " points");
+
+  auto intersectorCount = size_t(0);
+  timeLambda(
+    [&]() {
+      // the octree returns candidates, so the bounds of the found nodes must be tested
+      for (const auto& box : boxes)
+      {
+        for (const auto* node : world->nodeTree().find_intersectors(box))
+        {
+          if (box.intersects(node->physicalBounds()))
+          {
+            ++intersectorCount;
+          }
+        }
+      }
+    },
+    prefix + "find intersectors of " + std::to_string(NumQueries) + " boxes");
+
+  CHECK(hitCount > 0);
+  CHECK(containerCount > 0);
+  CHECK(intersectorCount > 0);
+}
+
+} // namespace TrenchBroom::Model
@@ -30,11 +30,13 @@
 #include "Model/MapFormat.h"
 #include "Model/WorldNode.h"
 #include "Renderer/BrushRenderer.h"
+#include "Renderer/BrushRendererBrushCache.h"
 
 #include "kdl/result.h"
 
 #include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -43,14 +45,13 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
-static constexpr size_t NumBrushes = 64'000;
 static constexpr size_t NumMaterials = 256;
 
 /**
  * Both returned vectors need to be freed with VecUtils::clearAndDelete
  */
 static std::pair<std::vector<Model::BrushNode*>, std::vector<Assets::Material*>>
-makeBrushes()
+makeBrushes(const size_t brushCount)
 {
   // make materials
   std::vector<Assets::Material*> materials;
@@ -69,7 +70,7 @@ makeBrushes()
 
   std::vector<Model::BrushNode*> result;
   size_t currentMaterialIndex = 0;
-  for (size_t i = 0; i < NumBrushes; ++i)
+  for (size_t i = 0; i < brushCount; ++i)
   {
     Model::Brush brush = builder.createCube(64.0, "") | kdl::value();
     for (Model::BrushFace& face : brush.faces())
@@ -97,7 +98,10 @@ makeBrushes()
 
 TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
 {
-  auto [brushes, materials] = makeBrushes();
+  const auto brushCount = GENERATE(size_t(64'000), size_t(256'000));
+  auto [brushes, materials] = makeBrushes(brushCount);
+
+  const auto prefix = std::to_string(brushCount) + " brushes: ";
 
   BrushRenderer r;
 
@@ -120,7 +124,7 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
       + " brushes to BrushRenderer");
 
   // Tiny change: remove the last brush
-  timeLambda([&]() { r.removeBrush(brushes.back()); }, "call removeBrush once");
+  timeLambda([&]() { r.removeBrush(brushes.back()); }, prefix + "call removeBrush once");
   timeLambda(
     [&]() {
       if (!r.valid())
@@ -128,7 +132,7 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
         r.validate();
       }
     },
-    "validate after removing one brush");
+    prefix + "validate after removing one brush");
 
   // Large change: keep every second brush
   timeLambda(
@@ -141,16 +145,62 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
         }
       }
     },
-    "remove every second brush");
+    prefix + "remove every second brush");
+
+  timeLambda(
+    [&]() {
+      if (!r.valid())
+      {
+        r.validate();
+      }
+    },
+    prefix + "validate remaining brushes");
 
+  // Rebuild the vertex caches of all remaining brushes
   timeLambda(
     [&]() {
+      for (size_t i = 0; i < brushes.size(); ++i)
+      {
+        if ((i % 2) != 0)
+        {
+          brushes[i]->brushRendererBrushCache().invalidateVertexCache();
+          r.invalidateBrush(brushes[i]);
+        }
+      }
       if (!r.valid())
       {
         r.validate();
       }
     },
-    "validate remaining brushes");
+    prefix + "validate remaining brushes with invalid vertex caches");
+
+  kdl::vec_clear_and_delete(brushes);
+  kdl::vec_clear_and_delete(materials);
+}
+
+TEST_CASE("BrushRendererBenchmark.packVertices")
+{
+  const auto brushCount = size_t(256'000);
+  auto [brushes, materials] = makeBrushes(brushCount);
+
+  for (const auto packVertices : {false, true})
+  {
+    const auto prefix = std::to_string(brushCount) + " brushes with "
+                        + (packVertices ? "packed" : "unpacked") + " vertices: ";
+
+    BrushRenderer r;
+    r.setPackVertices(packVertices);
+    for (auto* brush : brushes)
+    {
+      r.addBrush(brush);
+    }
+
+    timeLambda([&]() { r.validate(); }, prefix + "validate");
+    printf(
+      "Vertex buffer size for '%s': %zu KiB\n",
+      prefix.c_str(),
+      r.vertexBufferSize() / 1024);
+  }
 
   kdl::vec_clear_and_delete(brushes);
   kdl::vec_clear_and_delete(materials);
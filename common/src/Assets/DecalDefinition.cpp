@@ -73,6 +73,7 @@ DecalDefinition::DecalDefinition(const FileLocation& location)
 
 DecalDefinition::DecalDefinition(EL::ExpressionNode expression)
   : m_expression{std::move(expression)}
+  , m_variableNames{m_expression.variableNames()}
 {
 }
 
@@ -83,6 +84,12 @@ void DecalDefinition::append(const DecalDefinition& other)
   auto cases =
     std::vector<EL::ExpressionNode>{std::move(m_expression), other.m_expression};
   m_expression = EL::ExpressionNode{EL::SwitchExpression{std::move(cases)}, location};
+  m_variableNames = m_expression.variableNames();
+}
+
+const std::vector<std::string>& DecalDefinition::variableNames() const
+{
+  return m_variableNames;
 }
 
 DecalSpecification DecalDefinition::decalSpecification(
@@ -24,6 +24,8 @@
 #include "kdl/reflection_decl.h"
 
 #include <iosfwd>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -49,6 +51,7 @@ class DecalDefinition
 {
 private:
   EL::ExpressionNode m_expression;
+  std::vector<std::string> m_variableNames;
 
 public:
   DecalDefinition();
@@ -57,6 +60,13 @@ public:
 
   void append(const DecalDefinition& other);
 
+  /**
+   * Returns the names of the entity properties that the decal expression reads, sorted
+   * and without duplicates. The decal specification of an entity only changes if one of
+   * these properties changes.
+   */
+  const std::vector<std::string>& variableNames() const;
+
   /**
    * Evaluates the decal expresion, using the given variable store to interpolate
    * variables.
@@ -207,14 +207,21 @@ size_t Material::usageCount() const
 
 void Material::incUsageCount()
 {
-  ++m_usageCount;
+  if (m_usageCount++ == 0)
+  {
+    // materials that are used in the map are loaded before the rest
+    m_textureResource->setPriority(ResourcePriority::High);
+  }
 }
 
 void Material::decUsageCount()
 {
   const size_t previous = m_usageCount--;
   assert(previous > 0);
-  unused(previous);
+  if (previous == 1)
+  {
+    m_textureResource->setPriority(ResourcePriority::Normal);
+  }
 }
 
 void Material::activate(const int minFilter, const int magFilter) const
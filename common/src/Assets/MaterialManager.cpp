@@ -90,6 +90,7 @@ void MaterialManager::clear()
 {
   m_collections.clear();
   m_materialsByName.clear();
+  m_materialsByInternedName.clear();
   m_materials.clear();
 
   // Remove logging because it might fail when the document is already destroyed.
@@ -106,6 +107,22 @@ Material* MaterialManager::material(const std::string& name)
   return const_cast<Material*>(const_cast<const MaterialManager*>(this)->material(name));
 }
 
+const Material* MaterialManager::material(const kdl::interned_string& name) const
+{
+  auto it = m_materialsByInternedName.find(name);
+  if (it == m_materialsByInternedName.end())
+  {
+    auto* material = const_cast<Material*>(this->material(name.str()));
+    it = m_materialsByInternedName.emplace(name, material).first;
+  }
+  return it->second;
+}
+
+Material* MaterialManager::material(const kdl::interned_string& name)
+{
+  return const_cast<Material*>(const_cast<const MaterialManager*>(this)->material(name));
+}
+
 const std::vector<const Material*> MaterialManager::findMaterialsByTextureResourceId(
   const std::vector<ResourceId>& textureResourceIds) const
 {
@@ -129,6 +146,7 @@ const std::vector<MaterialCollection>& MaterialManager::collections() const
 void MaterialManager::updateMaterials()
 {
   m_materialsByName.clear();
+  m_materialsByInternedName.clear();
   m_materials.clear();
 
   for (auto& collection : m_collections)
@@ -22,6 +22,8 @@
 #include "Assets/MaterialCollection.h"
 #include "Assets/TextureResource.h"
 
+#include "kdl/interned_string.h"
+
 #include <filesystem>
 #include <string>
 #include <unordered_map>
@@ -55,6 +57,9 @@ private:
   std::vector<MaterialCollection> m_collections;
 
   std::unordered_map<std::string, Material*> m_materialsByName;
+  // caches lookups by interned name, which avoids converting the name to lower case and
+  // hashing it for every face
+  mutable std::unordered_map<kdl::interned_string, Material*> m_materialsByInternedName;
   std::vector<const Material*> m_materials;
 
 public:
@@ -77,6 +82,8 @@ public:
 
   const Material* material(const std::string& name) const;
   Material* material(const std::string& name);
+  const Material* material(const kdl::interned_string& name) const;
+  Material* material(const kdl::interned_string& name);
 
   const std::vector<const Material*> findMaterialsByTextureResourceId(
     const std::vector<ResourceId>& textureResourceIds) const;
@@ -50,6 +50,7 @@ ModelDefinition::ModelDefinition(const FileLocation& location)
 
 ModelDefinition::ModelDefinition(EL::ExpressionNode expression)
   : m_expression{std::move(expression)}
+  , m_variableNames{m_expression.variableNames()}
 {
 }
 
@@ -59,6 +60,12 @@ void ModelDefinition::append(ModelDefinition other)
 
   auto cases = std::vector{std::move(m_expression), std::move(other.m_expression)};
   m_expression = EL::ExpressionNode{EL::SwitchExpression{std::move(cases)}, location};
+  m_variableNames = m_expression.variableNames();
+}
+
+const std::vector<std::string>& ModelDefinition::variableNames() const
+{
+  return m_variableNames;
 }
 
 static std::filesystem::path path(const EL::Value& value)
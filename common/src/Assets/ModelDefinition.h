@@ -30,6 +30,8 @@
 #include <filesystem>
 #include <iosfwd>
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -51,6 +53,7 @@ class ModelDefinition
 {
 private:
   EL::ExpressionNode m_expression;
+  std::vector<std::string> m_variableNames;
 
 public:
   ModelDefinition();
@@ -60,6 +63,13 @@ public:
 
   void append(ModelDefinition other);
 
+  /**
+   * Returns the names of the entity properties that the model expression reads, sorted
+   * and without duplicates. The model specification of an entity only changes if one of
+   * these properties changes.
+   */
+  const std::vector<std::string>& variableNames() const;
+
   /**
    * Evaluates the model expresion, using the given variable store to interpolate
    * variables.
@@ -27,6 +27,8 @@
 #include "kdl/reflection_impl.h"
 #include "kdl/result.h"
 
+#include <atomic>
+#include <exception>
 #include <functional>
 #include <future>
 #include <iostream>
@@ -44,6 +46,16 @@ struct ProcessContext
   bool glContextAvailable;
 };
 
+/**
+ * Determines the order in which resources are loaded. Resources with a higher priority
+ * are loaded first.
+ */
+enum class ResourcePriority
+{
+  Normal,
+  High,
+};
+
 class TaskResult
 {
 };
@@ -79,6 +91,12 @@ struct ResourceLoading
 {
   std::future<std::unique_ptr<TaskResult>> future;
 
+  /**
+   * The loading task holds a weak reference to this token. If the resource is dropped
+   * before the task has started, the token expires and the task does nothing.
+   */
+  std::shared_ptr<bool> cancellationToken;
+
   kdl_reflect_inline_empty(ResourceLoading);
 };
 
@@ -141,10 +159,18 @@ namespace detail
 template <typename T>
 ResourceState<T> triggerLoading(ResourceUnloaded<T> state, TaskRunner taskRunner)
 {
-  auto future = taskRunner([loader = std::move(state.loader)]() {
-    return std::make_unique<LoaderTaskResult<T>>(loader());
-  });
-  return ResourceLoading<T>{std::move(future)};
+  auto cancellationToken = std::make_shared<bool>(true);
+  auto future = taskRunner(
+    [loader = std::move(state.loader),
+     weakCancellationToken =
+       std::weak_ptr{cancellationToken}]() -> std::unique_ptr<TaskResult> {
+      if (weakCancellationToken.expired())
+      {
+        return nullptr;
+      }
+      return std::make_unique<LoaderTaskResult<T>>(loader());
+    });
+  return ResourceLoading<T>{std::move(future), std::move(cancellationToken)};
 }
 
 template <typename T>
@@ -157,7 +183,21 @@ ResourceState<T> finishLoading(ResourceLoading<T> state)
       return ResourceFailed{"Invalid future"};
     }
 
-    auto taskResult = state.future.get();
+    auto taskResult = std::unique_ptr<TaskResult>{};
+    try
+    {
+      taskResult = state.future.get();
+    }
+    catch (const std::exception& e)
+    {
+      return ResourceFailed{e.what()};
+    }
+
+    if (!taskResult)
+    {
+      return ResourceFailed{"Loading was cancelled"};
+    }
+
     auto loaderTaskResult = static_cast<LoaderTaskResult<T>*>(taskResult.get());
 
     return std::move(loaderTaskResult->get())
@@ -232,6 +272,7 @@ class Resource
 private:
   ResourceId m_id;
   ResourceState<T> m_state;
+  std::atomic<ResourcePriority> m_priority = ResourcePriority::Normal;
 
   kdl_reflect_inline(Resource, m_state);
 
@@ -246,12 +287,34 @@ public:
   {
   }
 
-  moveOnly(Resource);
+  Resource(Resource&& other)
+    : m_id{std::move(other.m_id)}
+    , m_state{std::move(other.m_state)}
+    , m_priority{other.m_priority.load()}
+  {
+  }
+
+  Resource& operator=(Resource&& other)
+  {
+    m_id = std::move(other.m_id);
+    m_state = std::move(other.m_state);
+    m_priority = other.m_priority.load();
+    return *this;
+  }
+
+  deleteCopy(Resource);
 
   const ResourceId& id() const { return m_id; }
 
   const ResourceState<T>& state() const { return m_state; }
 
+  ResourcePriority priority() const { return m_priority; }
+
+  /**
+   * Sets the loading priority of this resource. This can be called from any thread.
+   */
+  void setPriority(const ResourcePriority priority) { m_priority = priority; }
+
   const T* get() const
   {
     return std::visit(
@@ -272,6 +335,13 @@ public:
       m_state);
   }
 
+  bool isUnloaded() const
+  {
+    return std::holds_alternative<ResourceUnloaded<T>>(m_state);
+  }
+
+  bool isLoading() const { return std::holds_alternative<ResourceLoading<T>>(m_state); }
+
   bool isDropped() const { return std::holds_alternative<ResourceDropped>(m_state); }
 
   bool needsProcessing() const
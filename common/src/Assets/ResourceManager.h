@@ -25,7 +25,9 @@
 #include "kdl/reflection_impl.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -40,7 +42,10 @@ public:
   virtual const ResourceId& id() const = 0;
 
   virtual long useCount() const = 0;
+  virtual ResourcePriority priority() const = 0;
 
+  virtual bool isUnloaded() const = 0;
+  virtual bool isLoading() const = 0;
   virtual bool isDropped() const = 0;
   virtual bool needsProcessing() const = 0;
 
@@ -64,6 +69,9 @@ public:
 
   const ResourceId& id() const override { return m_resource->id(); }
   long useCount() const override { return m_resource.use_count(); }
+  ResourcePriority priority() const override { return m_resource->priority(); }
+  bool isUnloaded() const override { return m_resource->isUnloaded(); }
+  bool isLoading() const override { return m_resource->isLoading(); }
   bool isDropped() const override { return m_resource->isDropped(); }
   bool needsProcessing() const override { return m_resource->needsProcessing(); }
   void drop() override { m_resource->drop(); }
@@ -73,12 +81,27 @@ public:
   }
 };
 
+/**
+ * Manages the lifecycle of resources.
+ *
+ * At most `maxLoadingResources` resources are loading at the same time. This bounds the
+ * number of tasks that are passed to the task runner, so resources that are dropped
+ * before their loading was triggered don't cause any work. When loading is triggered,
+ * resources with a higher priority are loaded first.
+ */
 class ResourceManager
 {
 private:
   std::vector<std::unique_ptr<ResourceWrapperBase>> m_resources;
+  size_t m_maxLoadingResources;
 
 public:
+  explicit ResourceManager(
+    const size_t maxLoadingResources = std::numeric_limits<size_t>::max())
+    : m_maxLoadingResources{maxLoadingResources}
+  {
+  }
+
   bool needsProcessing() const
   {
     return kdl::any_of(m_resources, [](const auto& resourceWrapper) {
@@ -100,6 +123,14 @@ public:
       std::make_unique<ResourceWrapper<ResourceT>>(std::move(resource)));
   }
 
+  size_t loadingResourceCount() const
+  {
+    return size_t(std::count_if(
+      m_resources.begin(), m_resources.end(), [](const auto& resourceWrapper) {
+        return resourceWrapper->isLoading();
+      }));
+  }
+
   std::vector<ResourceId> process(
     TaskRunner taskRunner,
     const ProcessContext& processContext,
@@ -113,6 +144,7 @@ public:
               : std::function{[]() { return true; }};
 
     auto result = std::vector<ResourceId>{};
+    auto unloadedResources = std::vector<ResourceWrapperBase*>{};
 
     for (auto it = m_resources.begin(); it != m_resources.end() && checkTimeout();)
     {
@@ -122,7 +154,12 @@ public:
         resourceWrapper->drop();
       }
 
-      if (resourceWrapper->needsProcessing())
+      if (resourceWrapper->isUnloaded())
+      {
+        // loading is triggered below in order of priority
+        unloadedResources.push_back(resourceWrapper.get());
+      }
+      else if (resourceWrapper->needsProcessing())
       {
         if (resourceWrapper->process(taskRunner, processContext))
         {
@@ -135,6 +172,30 @@ public:
              : std::next(it);
     }
 
+    std::stable_sort(
+      unloadedResources.begin(),
+      unloadedResources.end(),
+      [](const auto* lhs, const auto* rhs) { return lhs->priority() > rhs->priority(); });
+
+    auto loadingResources = loadingResourceCount();
+    for (auto* resourceWrapper : unloadedResources)
+    {
+      if (loadingResources >= m_maxLoadingResources)
+      {
+        break;
+      }
+
+      if (resourceWrapper->process(taskRunner, processContext))
+      {
+        result.push_back(resourceWrapper->id());
+      }
+
+      if (resourceWrapper->isLoading())
+      {
+        ++loadingResources;
+      }
+    }
+
     return result;
   }
 };
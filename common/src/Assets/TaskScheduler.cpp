@@ -0,0 +1,147 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskScheduler.h"
+
+#include "kdl/reflection_impl.h"
+
+#include <algorithm>
+
+namespace TrenchBroom::Assets
+{
+
+kdl_reflect_impl(TaskSchedulerStats);
+
+namespace
+{
+// more threads than this only add disk contention
+constexpr size_t MaxDefaultThreadCount = 8;
+
+auto toMicroseconds(const std::chrono::steady_clock::duration duration)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration);
+}
+} // namespace
+
+size_t TaskScheduler::defaultThreadCount()
+{
+  const auto hardwareThreads = size_t(std::thread::hardware_concurrency());
+  return std::clamp(hardwareThreads, size_t(1), MaxDefaultThreadCount);
+}
+
+TaskScheduler::TaskScheduler(const size_t threadCount)
+{
+  m_threads.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; ++i)
+  {
+    m_threads.emplace_back([&]() { runThread(); });
+  }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+  {
+    auto lock = std::lock_guard{m_mutex};
+    m_stop = true;
+    m_queue.clear();
+  }
+  m_condition.notify_all();
+
+  for (auto& thread : m_threads)
+  {
+    thread.join();
+  }
+}
+
+size_t TaskScheduler::threadCount() const
+{
+  return m_threads.size();
+}
+
+std::future<std::unique_ptr<TaskResult>> TaskScheduler::run(Task task)
+{
+  auto promise = std::promise<std::unique_ptr<TaskResult>>{};
+  auto future = promise.get_future();
+
+  {
+    auto lock = std::lock_guard{m_mutex};
+    m_queue.push_back(QueuedTask{std::move(task), std::move(promise), Clock::now()});
+    m_maxQueuedTasks = std::max(m_maxQueuedTasks, m_queue.size());
+  }
+  m_condition.notify_one();
+
+  return future;
+}
+
+TaskSchedulerStats TaskScheduler::stats() const
+{
+  auto lock = std::lock_guard{m_mutex};
+
+  const auto completedTasks = std::max(m_completedTasks, size_t(1));
+  return TaskSchedulerStats{
+    m_queue.size(),
+    m_maxQueuedTasks,
+    m_runningTasks,
+    m_completedTasks,
+    toMicroseconds(m_totalQueueLatency / completedTasks),
+    toMicroseconds(m_maxQueueLatency),
+    toMicroseconds(m_totalRunTime / completedTasks),
+  };
+}
+
+void TaskScheduler::runThread()
+{
+  while (true)
+  {
+    auto lock = std::unique_lock{m_mutex};
+    m_condition.wait(lock, [&]() { return m_stop || !m_queue.empty(); });
+    if (m_stop)
+    {
+      return;
+    }
+
+    auto queuedTask = std::move(m_queue.front());
+    m_queue.pop_front();
+
+    const auto startTime = Clock::now();
+    const auto queueLatency = startTime - queuedTask.submitTime;
+    ++m_runningTasks;
+    lock.unlock();
+
+    try
+    {
+      queuedTask.promise.set_value(queuedTask.task());
+    }
+    catch (...)
+    {
+      queuedTask.promise.set_exception(std::current_exception());
+    }
+
+    const auto runTime = Clock::now() - startTime;
+
+    lock.lock();
+    --m_runningTasks;
+    ++m_completedTasks;
+    m_totalQueueLatency += queueLatency;
+    m_maxQueueLatency = std::max(m_maxQueueLatency, queueLatency);
+    m_totalRunTime += runTime;
+  }
+}
+
+} // namespace TrenchBroom::Assets
@@ -0,0 +1,127 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Assets/Resource.h"
+#include "Macros.h"
+
+#include "kdl/reflection_decl.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom::Assets
+{
+
+struct TaskSchedulerStats
+{
+  /** The number of tasks that are waiting to be executed. */
+  size_t queuedTasks = 0;
+  /** The largest number of tasks that were waiting at the same time. */
+  size_t maxQueuedTasks = 0;
+  /** The number of tasks that are currently being executed. */
+  size_t runningTasks = 0;
+  /** The number of tasks that have been executed. */
+  size_t completedTasks = 0;
+
+  /** The average and maximum time a task had to wait before it was executed. */
+  std::chrono::microseconds averageQueueLatency = std::chrono::microseconds{0};
+  std::chrono::microseconds maxQueueLatency = std::chrono::microseconds{0};
+
+  /** The average time it took to execute a task. */
+  std::chrono::microseconds averageRunTime = std::chrono::microseconds{0};
+
+  kdl_reflect_decl(
+    TaskSchedulerStats,
+    queuedTasks,
+    maxQueuedTasks,
+    runningTasks,
+    completedTasks,
+    averageQueueLatency,
+    maxQueueLatency,
+    averageRunTime);
+};
+
+/**
+ * Executes resource loading tasks on a fixed number of background threads.
+ *
+ * Tasks are executed in the order in which they are submitted. Since loading resources
+ * is mostly I/O and decoding work, this scheduler is kept separate from the general
+ * purpose task scheduler used for parallel algorithms. The number of tasks that are
+ * submitted at the same time is bounded by the ResourceManager, which also decides the
+ * order in which resources are loaded.
+ *
+ * When the scheduler is destroyed, all tasks that haven't started yet are discarded
+ * (their futures report a broken promise), and the destructor waits for the running
+ * tasks to finish.
+ */
+class TaskScheduler
+{
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct QueuedTask
+  {
+    Task task;
+    std::promise<std::unique_ptr<TaskResult>> promise;
+    Clock::time_point submitTime;
+  };
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<QueuedTask> m_queue;
+  std::vector<std::thread> m_threads;
+  bool m_stop = false;
+
+  size_t m_maxQueuedTasks = 0;
+  size_t m_runningTasks = 0;
+  size_t m_completedTasks = 0;
+  Clock::duration m_totalQueueLatency = Clock::duration::zero();
+  Clock::duration m_maxQueueLatency = Clock::duration::zero();
+  Clock::duration m_totalRunTime = Clock::duration::zero();
+
+public:
+  /**
+   * Returns a thread count suitable for loading resources on this machine.
+   */
+  static size_t defaultThreadCount();
+
+  explicit TaskScheduler(size_t threadCount = defaultThreadCount());
+  ~TaskScheduler();
+
+  deleteCopyAndMove(TaskScheduler);
+
+  size_t threadCount() const;
+
+  std::future<std::unique_ptr<TaskResult>> run(Task task);
+
+  TaskSchedulerStats stats() const;
+
+private:
+  void runThread();
+};
+
+} // namespace TrenchBroom::Assets
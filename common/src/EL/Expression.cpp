@@ -1177,6 +1177,46 @@ ExpressionNode ExpressionNode::optimize() const
     std::make_shared<Expression>(optimizeExpression(*m_expression)), m_location};
 }
 
+std::vector<std::string> ExpressionNode::variableNames() const
+{
+  auto variableNames = std::vector<std::string>{};
+  accept(kdl::overload(
+    [](const LiteralExpression&) {},
+    [&](const VariableExpression& variableExpression) {
+      variableNames.push_back(variableExpression.variableName);
+    },
+    [](const auto& thisLambda, const ArrayExpression& arrayExpression) {
+      for (const auto& element : arrayExpression.elements)
+      {
+        element.accept(thisLambda);
+      }
+    },
+    [](const auto& thisLambda, const MapExpression& mapExpression) {
+      for (const auto& [key, element] : mapExpression.elements)
+      {
+        element.accept(thisLambda);
+      }
+    },
+    [](const auto& thisLambda, const UnaryExpression& unaryExpression) {
+      unaryExpression.operand.accept(thisLambda);
+    },
+    [](const auto& thisLambda, const BinaryExpression& binaryExpression) {
+      binaryExpression.leftOperand.accept(thisLambda);
+      binaryExpression.rightOperand.accept(thisLambda);
+    },
+    [](const auto& thisLambda, const SubscriptExpression& subscriptExpression) {
+      subscriptExpression.leftOperand.accept(thisLambda);
+      subscriptExpression.rightOperand.accept(thisLambda);
+    },
+    [](const auto& thisLambda, const SwitchExpression& switchExpression) {
+      for (const auto& caseExpression : switchExpression.cases)
+      {
+        caseExpression.accept(thisLambda);
+      }
+    }));
+  return kdl::vec_sort_and_remove_duplicates(std::move(variableNames));
+}
+
 const std::optional<FileLocation>& ExpressionNode::location() const
 {
   return m_location;
@@ -125,6 +125,13 @@ public:
 
   ExpressionNode optimize() const;
 
+  /**
+   * Returns the names of the variables read by this expression, sorted and without
+   * duplicates. Evaluating this expression yields the same value for any two variable
+   * stores that agree on the values of these variables.
+   */
+  std::vector<std::string> variableNames() const;
+
   const std::optional<FileLocation>& location() const;
 
   std::string asString() const;
@@ -146,6 +146,12 @@ Result<std::vector<std::filesystem::path>> find(
 }
 
 Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path)
+{
+  return openFile(path, CFileMode::Stream);
+}
+
+Result<std::shared_ptr<CFile>> openFile(
+  const std::filesystem::path& path, const CFileMode mode)
 {
   const auto fixedPath = fixPath(path);
   if (pathInfo(fixedPath) != PathInfo::File)
@@ -154,7 +160,7 @@ Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path)
       "Failed to open '" + fixedPath.string() + "': path does not denote a file"};
   }
 
-  return createCFile(fixedPath);
+  return createCFile(fixedPath, mode);
 }
 
 Result<bool> createDirectory(const std::filesystem::path& path)
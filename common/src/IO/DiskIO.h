@@ -34,6 +34,7 @@
 namespace TrenchBroom::IO
 {
 class CFile;
+enum class CFileMode;
 class File;
 enum class PathInfo;
 struct TraversalMode;
@@ -51,8 +52,17 @@ Result<std::vector<std::filesystem::path>> find(
   const TraversalMode& traversalMode,
   const PathMatcher& pathMatcher = matchAnyPath);
 
+/**
+ * Opens the file at the given path for reading with CFileMode::Stream.
+ */
 Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path);
 
+/**
+ * Opens the file at the given path for reading with the given mode, see CFileMode.
+ */
+Result<std::shared_ptr<CFile>> openFile(
+  const std::filesystem::path& path, CFileMode mode);
+
 template <typename Stream, typename F>
 auto withStream(
   const std::filesystem::path& path, const std::ios::openmode mode, const F& function)
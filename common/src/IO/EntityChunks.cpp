@@ -0,0 +1,314 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityChunks.h"
+
+#include "kdl/reflection_impl.h"
+
+namespace TrenchBroom::IO
+{
+
+namespace
+{
+
+bool isWhitespace(const char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/**
+ * Indicates whether a brace followed by the given character is a token of its own rather
+ * than the beginning of a word.
+ */
+bool isBraceDelimiter(const char c)
+{
+  return c == 0 || isWhitespace(c) || c == '"' || c == '(' || c == '{' || c == '}'
+         || c == '/' || c == ';';
+}
+
+/**
+ * Walks over a map file and keeps track of lines and columns in the same way as the
+ * tokenizer used by StandardMapParser.
+ */
+class Scanner
+{
+private:
+  const char* m_cur;
+  const char* m_end;
+  size_t m_line = 1;
+  size_t m_column = 1;
+  bool m_escaped = false;
+
+public:
+  explicit Scanner(const std::string_view str)
+    : m_cur{str.data()}
+    , m_end{str.data() + str.size()}
+  {
+  }
+
+  bool eof() const { return m_cur >= m_end; }
+
+  char curChar() const { return *m_cur; }
+
+  char lookAhead(const size_t offset = 1) const
+  {
+    return m_cur + offset < m_end ? *(m_cur + offset) : 0;
+  }
+
+  const char* curPos() const { return m_cur; }
+
+  size_t line() const { return m_line; }
+
+  size_t column() const { return m_column; }
+
+  void advance()
+  {
+    switch (curChar())
+    {
+    case '\r':
+      if (lookAhead() == '\n')
+      {
+        ++m_column;
+        break;
+      }
+      ++m_line;
+      m_column = 1;
+      m_escaped = false;
+      break;
+    case '\n':
+      ++m_line;
+      m_column = 1;
+      m_escaped = false;
+      break;
+    default:
+      ++m_column;
+      m_escaped = curChar() == '\\' ? !m_escaped : false;
+      break;
+    }
+    ++m_cur;
+  }
+
+  void advance(const size_t count)
+  {
+    for (size_t i = 0; i < count && !eof(); ++i)
+    {
+      advance();
+    }
+  }
+
+  void discardUntilEol()
+  {
+    while (!eof() && curChar() != '\n' && curChar() != '\r')
+    {
+      advance();
+    }
+  }
+
+  void discardWord()
+  {
+    while (!eof() && !isWhitespace(curChar()))
+    {
+      advance();
+    }
+  }
+
+  /**
+   * Skips a quoted string, including the closing quotation mark. Returns false if the
+   * string is not terminated.
+   */
+  bool discardQuotedString()
+  {
+    // opening quotation mark
+    advance();
+
+    while (!eof() && (curChar() != '"' || m_escaped))
+    {
+      // the tokenizer treats an escaped quotation mark at the end of a line or before a
+      // closing brace as the end of the string
+      if (curChar() == '"' && (lookAhead() == '\n' || lookAhead() == '}'))
+      {
+        m_escaped = false;
+        break;
+      }
+      advance();
+    }
+
+    if (eof())
+    {
+      return false;
+    }
+
+    // closing quotation mark
+    advance();
+    return true;
+  }
+
+  MapChunk chunk(const MapChunk& start) const
+  {
+    return {
+      std::string_view{
+        start.str.data(), static_cast<size_t>(m_cur - start.str.data())},
+      start.line,
+      start.column};
+  }
+
+  MapChunk chunkStart() const { return {std::string_view{m_cur, 0}, m_line, m_column}; }
+};
+
+} // namespace
+
+kdl_reflect_impl(MapChunk);
+
+kdl_reflect_impl(EntityChunks);
+
+std::optional<std::vector<EntityChunks>> findEntityChunks(
+  const std::string_view str, const size_t maxBodySize)
+{
+  auto scanner = Scanner{str};
+  auto result = std::vector<EntityChunks>{};
+
+  // depth 1 is inside of an entity, depth 2 is inside of a brush or patch
+  size_t depth = 0;
+  auto entity = EntityChunks{};
+  auto headerDone = false;
+  auto body = std::optional<MapChunk>{};
+
+  while (!scanner.eof())
+  {
+    const auto c = scanner.curChar();
+    if (isWhitespace(c))
+    {
+      scanner.advance();
+    }
+    else if (c == '/')
+    {
+      if (scanner.lookAhead(1) != '/')
+      {
+        // the tokenizer skips a single slash
+        scanner.advance();
+      }
+      else if (scanner.lookAhead(2) == '/' && scanner.lookAhead(3) == ' ')
+      {
+        // a comment token, the remainder of the line is tokenized normally
+        if (depth == 0)
+        {
+          return std::nullopt;
+        }
+        scanner.advance(3);
+      }
+      else
+      {
+        scanner.discardUntilEol();
+      }
+    }
+    else if (c == ';')
+    {
+      scanner.discardUntilEol();
+    }
+    else if (c == '"')
+    {
+      if (depth == 0 || !scanner.discardQuotedString())
+      {
+        return std::nullopt;
+      }
+    }
+    else if (c == '{' && (depth < 2 || isBraceDelimiter(scanner.lookAhead())))
+    {
+      if (depth == 0)
+      {
+        entity = EntityChunks{};
+        entity.header = scanner.chunkStart();
+        headerDone = false;
+      }
+      else if (depth == 1)
+      {
+        if (!headerDone)
+        {
+          entity.header = scanner.chunk(entity.header);
+          headerDone = true;
+        }
+        if (!body)
+        {
+          body = scanner.chunkStart();
+        }
+      }
+
+      ++depth;
+      scanner.advance();
+    }
+    else if (c == '}' && (depth < 2 || isBraceDelimiter(scanner.lookAhead())))
+    {
+      if (depth == 0)
+      {
+        return std::nullopt;
+      }
+
+      if (depth == 1)
+      {
+        if (!headerDone)
+        {
+          entity.header = scanner.chunk(entity.header);
+        }
+        if (body)
+        {
+          entity.bodies.push_back(*body);
+          body = std::nullopt;
+        }
+        entity.endLine = scanner.line();
+        entity.endColumn = scanner.column();
+        result.push_back(std::move(entity));
+      }
+
+      --depth;
+      scanner.advance();
+
+      if (depth == 1)
+      {
+        // the end of a brush or patch
+        *body = scanner.chunk(*body);
+        if (body->str.size() >= maxBodySize)
+        {
+          entity.bodies.push_back(*body);
+          body = std::nullopt;
+        }
+      }
+    }
+    else if (depth == 0)
+    {
+      return std::nullopt;
+    }
+    else if (c == '(' || c == ')' || c == '[' || c == ']')
+    {
+      scanner.advance();
+    }
+    else
+    {
+      scanner.discardWord();
+    }
+  }
+
+  if (depth != 0)
+  {
+    return std::nullopt;
+  }
+
+  return result;
+}
+
+} // namespace TrenchBroom::IO
@@ -0,0 +1,85 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "kdl/reflection_decl.h"
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace TrenchBroom::IO
+{
+
+/**
+ * A portion of a map file together with the line and column at which it starts.
+ */
+struct MapChunk
+{
+  std::string_view str;
+  size_t line = 1;
+  size_t column = 1;
+
+  kdl_reflect_decl(MapChunk, str, line, column);
+};
+
+/**
+ * The chunks that make up a top level entity of a map file.
+ */
+struct EntityChunks
+{
+  /**
+   * The opening brace and the properties of the entity, but none of its brushes or
+   * patches and not the closing brace.
+   */
+  MapChunk header;
+
+  /**
+   * Groups of consecutive brushes and patches of the entity.
+   */
+  std::vector<MapChunk> bodies;
+
+  /**
+   * The line and column of the entity's closing brace.
+   */
+  size_t endLine = 1;
+  size_t endColumn = 1;
+
+  kdl_reflect_decl(EntityChunks, header, bodies, endLine, endColumn);
+};
+
+/**
+ * Splits the given map file into chunks that can be parsed independently of each other.
+ *
+ * The map file is scanned for opening and closing braces while skipping quoted strings
+ * and comments. A brace only counts if it is not immediately followed by a character
+ * that can be part of a word, so that material names such as `{fence` are skipped.
+ *
+ * The brushes and patches of each entity are grouped into body chunks of roughly the
+ * given size in bytes.
+ *
+ * Returns nullopt if the structure of the map file isn't recognized, e.g. because of
+ * unbalanced braces, unterminated strings or text outside of any entity. In that case,
+ * the file must be parsed serially to report the errors.
+ */
+std::optional<std::vector<EntityChunks>> findEntityChunks(
+  std::string_view str, size_t maxBodySize);
+
+} // namespace TrenchBroom::IO
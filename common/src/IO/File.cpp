@@ -26,6 +26,13 @@
 #include <cstdio>
 #include <cstring>
 
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
 namespace TrenchBroom::IO
 {
 
@@ -101,17 +108,77 @@ Result<size_t> fileSize(std::FILE* file)
 
   return static_cast<size_t>(size);
 }
+
+kdl::resource<const char*> noMapping()
+{
+  return kdl::resource<const char*>{nullptr, [](auto) {}};
+}
+
+/**
+ * Maps the given file into memory. Returns a null mapping if the file cannot be mapped.
+ */
+kdl::resource<const char*> mapFile(std::FILE* file, const size_t size)
+{
+  if (size == 0)
+  {
+    // empty files cannot be mapped
+    return noMapping();
+  }
+
+#ifdef _WIN32
+  const auto fileHandle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+  if (fileHandle == INVALID_HANDLE_VALUE)
+  {
+    return noMapping();
+  }
+
+  auto* mappingHandle =
+    CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mappingHandle)
+  {
+    return noMapping();
+  }
+
+  // the view keeps the mapping object alive
+  const auto* address = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, size);
+  CloseHandle(mappingHandle);
+  if (!address)
+  {
+    return noMapping();
+  }
+
+  return kdl::resource{
+    static_cast<const char*>(address),
+    [](const char* mapping) { UnmapViewOfFile(mapping); }};
+#else
+  auto* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+  if (address == MAP_FAILED)
+  {
+    return noMapping();
+  }
+
+  return kdl::resource{
+    static_cast<const char*>(address), [size](const char* mapping) {
+      munmap(const_cast<char*>(mapping), size); // NOLINT
+    }};
+#endif
+}
 } // namespace
 
-CFile::CFile(kdl::resource<std::FILE*> file, const size_t size)
+CFile::CFile(
+  kdl::resource<std::FILE*> file,
+  const size_t size,
+  kdl::resource<const char*> mapping)
   : m_file{std::move(file)}
   , m_size{size}
+  , m_mapping{std::move(mapping)}
 {
 }
 
 Reader CFile::reader() const
 {
-  return Reader::from(*this, m_size);
+  return *m_mapping ? Reader::from(*m_mapping, *m_mapping + m_size)
+                    : Reader::from(*this, m_size);
 }
 
 size_t CFile::size() const
@@ -124,8 +191,21 @@ std::FILE* CFile::file() const
   return *m_file;
 }
 
+const char* CFile::mapping() const
+{
+  return *m_mapping;
+}
+
 std::unique_ptr<OwningBufferFile> CFile::buffer() const
 {
+  if (*m_mapping)
+  {
+    auto buffer = std::make_unique<char[]>(size());
+    std::memcpy(buffer.get(), *m_mapping, size());
+    return std::make_unique<OwningBufferFile>(std::move(buffer), size());
+  }
+
+  auto guard = std::lock_guard{m_mutex};
   if (std::fseek(file(), 0, SEEK_SET))
   {
     return nullptr;
@@ -184,12 +264,16 @@ Error CFile::makeError(const std::string& msg) const
                             : Error{msg + ": " + std::strerror(errno)};
 }
 
-Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path)
+Result<std::shared_ptr<CFile>> createCFile(
+  const std::filesystem::path& path, const CFileMode mode)
 {
-  return openPathAsFILE(path, "rb") | kdl::and_then([](auto file) {
+  return openPathAsFILE(path, "rb") | kdl::and_then([&](auto file) {
            return fileSize(*file) | kdl::transform([&](auto size) {
+                    auto mapping = mode == CFileMode::MemoryMap ? mapFile(*file, size)
+                                                                : noMapping();
                     // NOLINTNEXTLINE
-                    return std::shared_ptr<CFile>{new CFile{std::move(file), size}};
+                    return std::shared_ptr<CFile>{
+                      new CFile{std::move(file), size, std::move(mapping)}};
                   });
          });
 }
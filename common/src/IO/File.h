@@ -78,9 +78,33 @@ public:
   size_t size() const override;
 };
 
+/**
+ * Determines how the contents of a CFile are accessed.
+ */
+enum class CFileMode
+{
+  /**
+   * The contents are read with fread. Concurrent reads are serialized.
+   */
+  Stream,
+  /**
+   * The file is mapped into memory if possible. Readers access the mapped memory
+   * directly, so they don't copy the file contents and don't need to lock. If the file
+   * cannot be mapped, it falls back to Stream.
+   *
+   * Only map files that are read and closed right away. If a mapped file is truncated
+   * while it is open, accessing the missing pages crashes the process with SIGBUS, and
+   * on Windows, a mapped file cannot be replaced. Files that stay open for a long time,
+   * such as mounted archives, must use Stream.
+   */
+  MemoryMap,
+};
+
 /**
  * A file that is backed by a physical file on the disk. The file is opened in the
  * constructor and closed in the destructor.
+ *
+ * The file may be mapped into memory, see CFileMode.
  */
 class CFile : public File
 {
@@ -95,15 +119,18 @@ public:
 private:
   kdl::resource<std::FILE*> m_file;
   size_t m_size;
+  kdl::resource<const char*> m_mapping;
   mutable std::mutex m_mutex;
 
   /**
-   * Creates a new file with the given file ptr and size in bytes.
+   * Creates a new file with the given file ptr and size in bytes. If the given mapping is
+   * not null, it must point to the contents of the file mapped into memory.
    */
-  CFile(kdl::resource<std::FILE*> file, size_t size);
+  CFile(kdl::resource<std::FILE*> file, size_t size, kdl::resource<const char*> mapping);
 
 public:
-  friend Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
+  friend Result<std::shared_ptr<CFile>> createCFile(
+    const std::filesystem::path& path, CFileMode mode);
 
   Reader reader() const override;
   size_t size() const override;
@@ -113,6 +140,12 @@ public:
    */
   std::FILE* file() const;
 
+  /**
+   * Returns a pointer to the mapped contents of this file, or null if this file is not
+   * mapped into memory.
+   */
+  const char* mapping() const;
+
   std::unique_ptr<OwningBufferFile> buffer() const;
 
 private:
@@ -124,10 +157,20 @@ private:
   Error makeError(const std::string& msg) const;
 };
 
-Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
+/**
+ * Opens the file at the given path for reading.
+ *
+ * If the given mode is CFileMode::MemoryMap, then the file is mapped into memory unless
+ * it cannot be mapped, e.g. because it is empty or because the platform refuses to map
+ * it. In that case, the returned file reads its contents with fread. See CFileMode for
+ * when it is safe to map a file.
+ */
+Result<std::shared_ptr<CFile>> createCFile(
+  const std::filesystem::path& path, CFileMode mode = CFileMode::Stream);
 
 /**
- * A file that is backed by a portion of a physical file.
+ * A file that is backed by a portion of a physical file. If the host file is a memory
+ * buffer or a memory mapped file, then reading from the view does not copy any data.
  */
 class FileView : public File
 {
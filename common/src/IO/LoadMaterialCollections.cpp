@@ -44,6 +44,7 @@
 #include "kdl/functional.h"
 #include "kdl/grouped_range.h"
 #include "kdl/map_utils.h"
+#include "kdl/parallel.h"
 #include "kdl/path_hash.h"
 #include "kdl/path_utils.h"
 #include "kdl/result.h"
@@ -54,9 +55,12 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <optional>
 #include <ostream>
 #include <ranges>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom::IO
@@ -188,65 +192,60 @@ Result<std::filesystem::path> findShaderTexture(
          | kdl::transform_error([&](auto) { return DefaultTexturePath; });
 }
 
-Result<Assets::Material> loadShaderMaterial(
+Assets::Material loadShaderMaterial(
   const Assets::Quake3Shader& shader,
+  std::filesystem::path texturePath,
   const FileSystem& fs,
   const Model::MaterialConfig& materialConfig,
   const Assets::CreateTextureResource& createResource)
 {
-  return findShaderTexture(shader, fs, materialConfig) | kdl::transform([&](auto path) {
-           return [&, path = std::move(path)]() {
-             return fs.openFile(path) | kdl::and_then([&](auto file) {
-                      auto reader = file->reader().buffer();
-                      return readFreeImageTexture(reader).transform([](auto texture) {
-                        texture.setMask(Assets::TextureMask::Off);
-                        return texture;
-                      });
-                    });
-           };
-         })
-         | kdl::transform([&](auto textureLoader) {
-             const auto prefixLength = kdl::path_length(materialConfig.root);
-             auto shaderName =
-               getMaterialNameFromPathSuffix(shader.shaderPath, prefixLength);
-
-             auto textureResource = createResource(std::move(textureLoader));
-             auto material =
-               Assets::Material{std::move(shaderName), std::move(textureResource)};
-             material.setSurfaceParms(shader.surfaceParms);
-
-             // Note that Quake 3 has a different understanding of front and back, so we
-             // need to invert them.
-             switch (shader.culling)
-             {
-             case Assets::Quake3Shader::Culling::Front:
-               material.setCulling(Assets::MaterialCulling::Back);
-               break;
-             case Assets::Quake3Shader::Culling::Back:
-               material.setCulling(Assets::MaterialCulling::Front);
-               break;
-             case Assets::Quake3Shader::Culling::None:
-               material.setCulling(Assets::MaterialCulling::None);
-               break;
-             }
+  auto textureLoader = [&, path = std::move(texturePath)]() {
+    return fs.openFile(path) | kdl::and_then([&](auto file) {
+             auto reader = file->reader().buffer();
+             return readFreeImageTexture(reader).transform([](auto texture) {
+               texture.setMask(Assets::TextureMask::Off);
+               return texture;
+             });
+           });
+  };
 
-             if (!shader.stages.empty())
-             {
-               const auto& stage = shader.stages.front();
-               if (stage.blendFunc.enable())
-               {
-                 material.setBlendFunc(
-                   glGetEnum(stage.blendFunc.srcFactor),
-                   glGetEnum(stage.blendFunc.destFactor));
-               }
-               else
-               {
-                 material.disableBlend();
-               }
-             }
+  const auto prefixLength = kdl::path_length(materialConfig.root);
+  auto shaderName = getMaterialNameFromPathSuffix(shader.shaderPath, prefixLength);
 
-             return material;
-           });
+  auto textureResource = createResource(std::move(textureLoader));
+  auto material = Assets::Material{std::move(shaderName), std::move(textureResource)};
+  material.setSurfaceParms(shader.surfaceParms);
+
+  // Note that Quake 3 has a different understanding of front and back, so we need to
+  // invert them.
+  switch (shader.culling)
+  {
+  case Assets::Quake3Shader::Culling::Front:
+    material.setCulling(Assets::MaterialCulling::Back);
+    break;
+  case Assets::Quake3Shader::Culling::Back:
+    material.setCulling(Assets::MaterialCulling::Front);
+    break;
+  case Assets::Quake3Shader::Culling::None:
+    material.setCulling(Assets::MaterialCulling::None);
+    break;
+  }
+
+  if (!shader.stages.empty())
+  {
+    const auto& stage = shader.stages.front();
+    if (stage.blendFunc.enable())
+    {
+      material.setBlendFunc(
+        glGetEnum(stage.blendFunc.srcFactor), glGetEnum(stage.blendFunc.destFactor));
+    }
+    else
+    {
+      material.disableBlend();
+    }
+  }
+
+  return material;
 }
 
 Assets::ResourceLoader<Assets::Texture> makeTextureResourceLoader(
@@ -323,7 +322,7 @@ Assets::ResourceLoader<Assets::Texture> makeTextureResourceLoader(
   };
 }
 
-Result<Assets::Material> loadTextureMaterial(
+Assets::Material loadTextureMaterial(
   const std::filesystem::path& texturePath,
   const FileSystem& fs,
   const Model::MaterialConfig& materialConfig,
@@ -331,9 +330,6 @@ Result<Assets::Material> loadTextureMaterial(
   const std::optional<Result<Assets::Palette>>& paletteResult)
 {
   const auto prefixLength = kdl::path_length(materialConfig.root);
-  const auto pathMatcher = !materialConfig.extensions.empty()
-                             ? makeExtensionPathMatcher(materialConfig.extensions)
-                             : matchAnyPath;
 
   auto name = getMaterialNameFromPathSuffix(texturePath, prefixLength);
   auto textureLoader = makeTextureResourceLoader(texturePath, name, fs, paletteResult);
@@ -341,6 +337,78 @@ Result<Assets::Material> loadTextureMaterial(
   return Assets::Material{std::move(name), std::move(textureResource)};
 }
 
+/**
+ * The information needed to create a material that is looked up in the file system.
+ * Looking it up can be expensive, e.g. finding the texture of a shader may require
+ * searching several directories, but it does not create any resources, so it is done in
+ * parallel for all materials.
+ */
+struct MaterialSource
+{
+  std::filesystem::path materialPath;
+  const Assets::Quake3Shader* shader;
+  std::filesystem::path shaderTexturePath;
+  std::optional<std::filesystem::path> absolutePath;
+};
+
+using ShadersByPath = std::
+  unordered_map<std::filesystem::path, const Assets::Quake3Shader*, kdl::path_hash>;
+
+ShadersByPath makeShadersByPath(const std::vector<Assets::Quake3Shader>& shaders)
+{
+  auto result = ShadersByPath{};
+  for (const auto& shader : shaders)
+  {
+    // like std::find_if, prefer the first shader with a given path
+    result.emplace(shader.shaderPath, &shader);
+  }
+  return result;
+}
+
+MaterialSource findMaterialSource(
+  const FileSystem& fs,
+  const Model::MaterialConfig& materialConfig,
+  const std::filesystem::path& materialPath,
+  const Assets::Quake3Shader* shader)
+{
+  auto shaderTexturePath = shader ? findShaderTexture(*shader, fs, materialConfig)
+                                      | kdl::value_or(DefaultTexturePath)
+                                  : std::filesystem::path{};
+  auto absolutePath = fs.makeAbsolute(materialPath)
+                      | kdl::transform([](auto path) { return std::optional{path}; })
+                      | kdl::value_or(std::nullopt);
+
+  return {materialPath, shader, std::move(shaderTexturePath), std::move(absolutePath)};
+}
+
+Assets::Material createMaterial(
+  MaterialSource materialSource,
+  const FileSystem& fs,
+  const Model::MaterialConfig& materialConfig,
+  const Assets::CreateTextureResource& createResource,
+  const std::optional<Result<Assets::Palette>>& paletteResult)
+{
+  auto material = materialSource.shader ? loadShaderMaterial(
+                    *materialSource.shader,
+                    std::move(materialSource.shaderTexturePath),
+                    fs,
+                    materialConfig,
+                    createResource)
+                                        : loadTextureMaterial(
+                                          materialSource.materialPath,
+                                          fs,
+                                          materialConfig,
+                                          createResource,
+                                          paletteResult);
+
+  if (materialSource.absolutePath)
+  {
+    material.setAbsolutePath(std::move(*materialSource.absolutePath));
+  }
+  material.setRelativePath(std::move(materialSource.materialPath));
+  return material;
+}
+
 std::vector<Assets::MaterialCollection> groupMaterialsIntoCollections(
   std::vector<Assets::Material> materials, const Model::MaterialConfig& materialConfig)
 {
@@ -394,18 +462,14 @@ Result<Assets::Material> loadMaterial(
     std::find_if(shaders.begin(), shaders.end(), [&](const auto& shader) {
       return shader.shaderPath == materialPathStem;
     });
-
-  return (iShader != shaders.end()
-            ? loadShaderMaterial(*iShader, fs, materialConfig, createResource)
-            : loadTextureMaterial(
-              materialPath, fs, materialConfig, createResource, paletteResult))
-         | kdl::transform([&](auto material) {
-             fs.makeAbsolute(materialPath)
-               | kdl::transform([&](auto absPath) { material.setAbsolutePath(absPath); })
-               | kdl::or_else([](auto) { return kdl::void_success; });
-             material.setRelativePath(materialPath);
-             return material;
-           });
+  const auto* shader = iShader != shaders.end() ? &*iShader : nullptr;
+
+  return createMaterial(
+    findMaterialSource(fs, materialConfig, materialPath, shader),
+    fs,
+    materialConfig,
+    createResource,
+    paletteResult);
 }
 
 Result<std::vector<Assets::MaterialCollection>> loadMaterialCollections(
@@ -423,19 +487,32 @@ Result<std::vector<Assets::MaterialCollection>> loadMaterialCollections(
          })
          | kdl::and_then([&](auto shaders) {
              return findAllMaterialPaths(fs, materialConfig, shaders)
-                    | kdl::and_then([&](const auto& materialPaths) {
+                    | kdl::transform([&](auto materialPaths) {
+                        const auto shadersByPath = makeShadersByPath(shaders);
+
+                        // look up the materials in parallel, but create their resources
+                        // on this thread and in order, since createResource may not be
+                        // thread safe
+                        auto materialSources = kdl::vec_parallel_transform(
+                          std::move(materialPaths), [&](const auto& materialPath) {
+                            const auto shaderIt = shadersByPath.find(
+                              kdl::path_remove_extension(materialPath));
+                            const auto* shader = shaderIt != shadersByPath.end()
+                                                   ? shaderIt->second
+                                                   : nullptr;
+                            return findMaterialSource(
+                              fs, materialConfig, materialPath, shader);
+                          });
+
                         return kdl::vec_transform(
-                                 materialPaths,
-                                 [&](const auto& materialPath) {
-                                   return loadMaterial(
-                                     fs,
-                                     materialConfig,
-                                     materialPath,
-                                     createResource,
-                                     shaders,
-                                     paletteResult);
-                                 })
-                               | kdl::fold;
+                          std::move(materialSources), [&](auto materialSource) {
+                            return createMaterial(
+                              std::move(materialSource),
+                              fs,
+                              materialConfig,
+                              createResource,
+                              paletteResult);
+                          });
                       });
            })
          | kdl::transform([&](auto materials) {
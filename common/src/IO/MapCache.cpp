@@ -0,0 +1,487 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapCache.h"
+
+#include "Color.h"
+#include "Error.h" // IWYU pragma: keep
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+#include "Logger.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/MapFormat.h"
+
+#include "kdl/overload.h"
+#include "kdl/result.h"
+
+#include "vm/vec.h"
+
+#include <ostream>
+#include <string>
+#include <tuple>
+
+namespace TrenchBroom::IO
+{
+
+namespace
+{
+
+constexpr auto Magic = std::string_view{"TBCACHE", 8};
+constexpr uint32_t Version = 2;
+
+enum class ObjectType : uint8_t
+{
+  Entity = 0,
+  Brush = 1,
+  Patch = 2,
+};
+
+// writing
+
+template <typename T>
+void write(std::ostream& stream, const T value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeSize(std::ostream& stream, const size_t size)
+{
+  write(stream, static_cast<uint64_t>(size));
+}
+
+void writeString(std::ostream& stream, const std::string& str)
+{
+  writeSize(stream, str.size());
+  stream.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+template <typename T, size_t S>
+void writeVec(std::ostream& stream, const vm::vec<T, S>& vec)
+{
+  for (size_t i = 0; i < S; ++i)
+  {
+    write(stream, vec[i]);
+  }
+}
+
+template <typename T, typename W>
+void writeOptional(std::ostream& stream, const std::optional<T>& optional, const W& writeValue)
+{
+  write(stream, static_cast<uint8_t>(optional.has_value()));
+  if (optional)
+  {
+    writeValue(stream, *optional);
+  }
+}
+
+void writeLocation(std::ostream& stream, const FileLocation& location)
+{
+  writeSize(stream, location.line);
+  writeOptional(stream, location.column, writeSize);
+}
+
+void writeLocations(
+  std::ostream& stream,
+  const FileLocation& startLocation,
+  const std::optional<FileLocation>& endLocation)
+{
+  writeLocation(stream, startLocation);
+  writeOptional(stream, endLocation, writeLocation);
+}
+
+void writeAttributes(std::ostream& stream, const Model::BrushFaceAttributes& attributes)
+{
+  writeString(stream, attributes.materialName());
+  writeVec(stream, attributes.offset());
+  writeVec(stream, attributes.scale());
+  write(stream, attributes.rotation());
+  writeOptional(stream, attributes.surfaceContents(), write<int>);
+  writeOptional(stream, attributes.surfaceFlags(), write<int>);
+  writeOptional(stream, attributes.surfaceValue(), write<float>);
+  writeOptional(stream, attributes.color(), [](auto& s, const auto& color) {
+    writeVec<float, 4>(s, color);
+  });
+}
+
+void writeFace(std::ostream& stream, const Model::BrushFace& face)
+{
+  for (const auto& point : face.points())
+  {
+    writeVec(stream, point);
+  }
+  writeAttributes(stream, face.attributes());
+  writeVec(stream, face.uAxis());
+  writeVec(stream, face.vAxis());
+  writeSize(stream, face.lineNumber());
+}
+
+void writeObjectInfo(std::ostream& stream, const MapReader::EntityInfo& entityInfo)
+{
+  write(stream, ObjectType::Entity);
+  writeLocations(stream, entityInfo.startLocation, entityInfo.endLocation);
+  writeSize(stream, entityInfo.properties.size());
+  for (const auto& property : entityInfo.properties)
+  {
+    writeString(stream, property.key());
+    writeString(stream, property.value());
+  }
+}
+
+void writeObjectInfo(std::ostream& stream, const MapReader::BrushInfo& brushInfo)
+{
+  write(stream, ObjectType::Brush);
+  writeLocations(stream, brushInfo.startLocation, brushInfo.endLocation);
+  writeOptional(stream, brushInfo.parentIndex, writeSize);
+  writeSize(stream, brushInfo.faces.size());
+  for (const auto& face : brushInfo.faces)
+  {
+    writeFace(stream, face);
+  }
+}
+
+void writeMessage(std::ostream& stream, const MapCacheMessage& message)
+{
+  const auto& [level, str] = message;
+  write(stream, static_cast<uint8_t>(level));
+  writeString(stream, str);
+}
+
+void writeObjectInfo(std::ostream& stream, const MapReader::PatchInfo& patchInfo)
+{
+  write(stream, ObjectType::Patch);
+  writeLocations(stream, patchInfo.startLocation, patchInfo.endLocation);
+  writeOptional(stream, patchInfo.parentIndex, writeSize);
+  writeSize(stream, patchInfo.rowCount);
+  writeSize(stream, patchInfo.columnCount);
+  writeString(stream, patchInfo.materialName);
+  writeSize(stream, patchInfo.controlPoints.size());
+  for (const auto& controlPoint : patchInfo.controlPoints)
+  {
+    writeVec(stream, controlPoint);
+  }
+}
+
+// reading
+
+size_t readSize(Reader& reader)
+{
+  return reader.readSize<uint64_t>();
+}
+
+/**
+ * Reads the number of elements of a sequence in which every element takes up at least the
+ * given number of bytes. Throws a ReaderException if the remainder of the cache cannot
+ * hold that many elements, so that a corrupt count cannot cause a huge allocation.
+ */
+size_t readCount(Reader& reader, const size_t minElementSize)
+{
+  const auto count = readSize(reader);
+  if (count > (reader.size() - reader.position()) / minElementSize)
+  {
+    throw ReaderException{"Invalid element count: " + std::to_string(count)};
+  }
+  return count;
+}
+
+std::string readString(Reader& reader)
+{
+  return reader.readString(readCount(reader, 1));
+}
+
+template <typename T, typename R>
+std::optional<T> readOptional(Reader& reader, const R& readValue)
+{
+  return reader.readBool<uint8_t>() ? std::optional<T>{readValue(reader)} : std::nullopt;
+}
+
+FileLocation readLocation(Reader& reader)
+{
+  const auto line = readSize(reader);
+  const auto column = readOptional<size_t>(reader, readSize);
+  return FileLocation{line, column};
+}
+
+/**
+ * Reads the index of the entity that contains a brush or patch. Throws a ReaderException
+ * unless it refers to an object that precedes the brush or patch.
+ */
+std::optional<size_t> readParentIndex(Reader& reader, const size_t objectIndex)
+{
+  const auto parentIndex = readOptional<size_t>(reader, readSize);
+  if (parentIndex && *parentIndex >= objectIndex)
+  {
+    throw ReaderException{"Invalid parent index: " + std::to_string(*parentIndex)};
+  }
+  return parentIndex;
+}
+
+Model::BrushFaceAttributes readAttributes(Reader& reader)
+{
+  auto attributes = Model::BrushFaceAttributes{readString(reader)};
+  attributes.setOffset(reader.readVec<float, 2>());
+  attributes.setScale(reader.readVec<float, 2>());
+  attributes.setRotation(reader.readFloat<float>());
+  attributes.setSurfaceContents(
+    readOptional<int>(reader, [](auto& r) { return r.template readInt<int>(); }));
+  attributes.setSurfaceFlags(
+    readOptional<int>(reader, [](auto& r) { return r.template readInt<int>(); }));
+  attributes.setSurfaceValue(
+    readOptional<float>(reader, [](auto& r) { return r.template readFloat<float>(); }));
+  attributes.setColor(readOptional<Color>(
+    reader, [](auto& r) { return Color{r.template readVec<float, 4>()}; }));
+  return attributes;
+}
+
+std::optional<Model::BrushFace> readFace(
+  Reader& reader, const Model::MapFormat targetMapFormat)
+{
+  const auto point1 = reader.readVec<FloatType, 3>();
+  const auto point2 = reader.readVec<FloatType, 3>();
+  const auto point3 = reader.readVec<FloatType, 3>();
+  const auto attributes = readAttributes(reader);
+  const auto uAxis = reader.readVec<FloatType, 3>();
+  const auto vAxis = reader.readVec<FloatType, 3>();
+  const auto lineNumber = readSize(reader);
+
+  // the attributes were already converted to the target format, so the faces can be
+  // recreated without any further conversion
+  auto face =
+    Model::isParallelUVCoordSystem(targetMapFormat)
+      ? Model::BrushFace::createFromValve(
+        point1, point2, point3, attributes, uAxis, vAxis, targetMapFormat)
+      : Model::BrushFace::createFromStandard(
+        point1, point2, point3, attributes, targetMapFormat);
+
+  return std::move(face) | kdl::transform([&](auto f) {
+           f.setFilePosition(lineNumber, 1);
+           return std::optional{std::move(f)};
+         })
+         | kdl::value_or(std::nullopt);
+}
+
+std::optional<MapReader::ObjectInfo> readEntityInfo(Reader& reader)
+{
+  const auto startLocation = readLocation(reader);
+  const auto endLocation = readOptional<FileLocation>(reader, readLocation);
+
+  auto properties =
+    std::vector<Model::EntityProperty>(readCount(reader, 2 * sizeof(uint64_t)));
+  for (auto& property : properties)
+  {
+    auto key = readString(reader);
+    auto value = readString(reader);
+    property = Model::EntityProperty{std::move(key), std::move(value)};
+  }
+
+  return MapReader::EntityInfo{std::move(properties), startLocation, endLocation};
+}
+
+std::optional<MapReader::ObjectInfo> readBrushInfo(
+  Reader& reader, const size_t objectIndex, const Model::MapFormat targetMapFormat)
+{
+  const auto startLocation = readLocation(reader);
+  const auto endLocation = readOptional<FileLocation>(reader, readLocation);
+  const auto parentIndex = readParentIndex(reader, objectIndex);
+
+  const auto faceCount = readCount(reader, 9 * sizeof(FloatType));
+  auto faces = std::vector<Model::BrushFace>{};
+  faces.reserve(faceCount);
+  for (size_t i = 0; i < faceCount; ++i)
+  {
+    auto face = readFace(reader, targetMapFormat);
+    if (!face)
+    {
+      return std::nullopt;
+    }
+    faces.push_back(std::move(*face));
+  }
+
+  return MapReader::BrushInfo{std::move(faces), startLocation, endLocation, parentIndex};
+}
+
+std::optional<MapReader::ObjectInfo> readPatchInfo(
+  Reader& reader, const size_t objectIndex)
+{
+  const auto startLocation = readLocation(reader);
+  const auto endLocation = readOptional<FileLocation>(reader, readLocation);
+  const auto parentIndex = readParentIndex(reader, objectIndex);
+  const auto rowCount = readSize(reader);
+  const auto columnCount = readSize(reader);
+  auto materialName = readString(reader);
+
+  auto controlPoints =
+    std::vector<Model::BezierPatch::Point>(readCount(reader, 5 * sizeof(FloatType)));
+  for (auto& controlPoint : controlPoints)
+  {
+    controlPoint = reader.readVec<FloatType, 5>();
+  }
+
+  // the patch would fail to be created from the wrong number of control points
+  if (
+    rowCount < 3 || columnCount < 3 || rowCount % 2 == 0 || columnCount % 2 == 0
+    || controlPoints.size() / rowCount != columnCount
+    || controlPoints.size() % rowCount != 0)
+  {
+    return std::nullopt;
+  }
+
+  return MapReader::PatchInfo{
+    rowCount,
+    columnCount,
+    std::move(controlPoints),
+    std::move(materialName),
+    startLocation,
+    endLocation,
+    parentIndex};
+}
+
+std::optional<MapReader::ObjectInfo> readObjectInfo(
+  Reader& reader, const size_t objectIndex, const Model::MapFormat targetMapFormat)
+{
+  switch (static_cast<ObjectType>(reader.readUnsignedChar<uint8_t>()))
+  {
+  case ObjectType::Entity:
+    return readEntityInfo(reader);
+  case ObjectType::Brush:
+    return readBrushInfo(reader, objectIndex, targetMapFormat);
+  case ObjectType::Patch:
+    return readPatchInfo(reader, objectIndex);
+  }
+  return std::nullopt;
+}
+
+std::optional<MapCacheMessage> readMessage(Reader& reader)
+{
+  const auto level = reader.readUnsignedChar<uint8_t>();
+  if (level > static_cast<uint8_t>(LogLevel::Error))
+  {
+    return std::nullopt;
+  }
+  return MapCacheMessage{static_cast<LogLevel>(level), readString(reader)};
+}
+
+} // namespace
+
+std::filesystem::path mapCachePath(const std::filesystem::path& mapPath)
+{
+  auto result = mapPath;
+  result += ".tbcache";
+  return result;
+}
+
+uint64_t mapCacheKey(const std::string_view str)
+{
+  // 64 bit FNV-1a
+  auto hash = uint64_t(14695981039346656037ull);
+  for (const auto c : str)
+  {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= uint64_t(1099511628211ull);
+  }
+  return hash ^ static_cast<uint64_t>(str.size());
+}
+
+void writeMapCache(
+  std::ostream& stream,
+  const uint64_t key,
+  const Model::MapFormat sourceMapFormat,
+  const Model::MapFormat targetMapFormat,
+  const std::vector<MapReader::ObjectInfo>& objectInfos,
+  const std::vector<MapCacheMessage>& messages)
+{
+  stream.write(Magic.data(), static_cast<std::streamsize>(Magic.size()));
+  write(stream, Version);
+  write(stream, key);
+  write(stream, static_cast<int32_t>(sourceMapFormat));
+  write(stream, static_cast<int32_t>(targetMapFormat));
+
+  writeSize(stream, objectInfos.size());
+  for (const auto& objectInfo : objectInfos)
+  {
+    std::visit(
+      [&](const auto& info) { writeObjectInfo(stream, info); }, objectInfo);
+  }
+
+  writeSize(stream, messages.size());
+  for (const auto& message : messages)
+  {
+    writeMessage(stream, message);
+  }
+}
+
+std::optional<MapCacheContents> readMapCache(
+  const std::string_view cache,
+  const uint64_t key,
+  const Model::MapFormat sourceMapFormat,
+  const Model::MapFormat targetMapFormat)
+{
+  try
+  {
+    auto reader = Reader::from(cache.data(), cache.data() + cache.size());
+    if (
+      reader.readString(Magic.size()) != Magic.data()
+      || reader.readUnsignedInt<uint32_t>() != Version
+      || reader.readSize<uint64_t>() != key
+      || reader.readInt<int32_t>() != static_cast<int>(sourceMapFormat)
+      || reader.readInt<int32_t>() != static_cast<int>(targetMapFormat))
+    {
+      return std::nullopt;
+    }
+
+    auto result = MapCacheContents{};
+
+    const auto objectInfoCount = readCount(reader, sizeof(ObjectType));
+    result.objectInfos.reserve(objectInfoCount);
+    for (size_t i = 0; i < objectInfoCount; ++i)
+    {
+      auto objectInfo = readObjectInfo(reader, i, targetMapFormat);
+      if (!objectInfo)
+      {
+        return std::nullopt;
+      }
+      result.objectInfos.push_back(std::move(*objectInfo));
+    }
+
+    const auto messageCount = readCount(reader, sizeof(uint8_t) + sizeof(uint64_t));
+    result.messages.reserve(messageCount);
+    for (size_t i = 0; i < messageCount; ++i)
+    {
+      auto message = readMessage(reader);
+      if (!message)
+      {
+        return std::nullopt;
+      }
+      result.messages.push_back(std::move(*message));
+    }
+
+    if (!reader.eof())
+    {
+      return std::nullopt;
+    }
+
+    return result;
+  }
+  catch (const ReaderException&)
+  {
+    return std::nullopt;
+  }
+}
+
+} // namespace TrenchBroom::IO
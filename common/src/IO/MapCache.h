@@ -0,0 +1,107 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/MapReader.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace TrenchBroom
+{
+enum class LogLevel;
+}
+
+namespace TrenchBroom::Model
+{
+enum class MapFormat;
+}
+
+namespace TrenchBroom::IO
+{
+
+/**
+ * Map files of at least this many bytes are cached when they are loaded, unless the
+ * cache is disabled in the preferences.
+ */
+constexpr size_t MapCacheThreshold = 4 * 1024 * 1024;
+
+/**
+ * Returns the path of the cache file for the map file at the given path.
+ */
+std::filesystem::path mapCachePath(const std::filesystem::path& mapPath);
+
+/**
+ * Computes the key that identifies the contents of the given map file in its cache.
+ */
+uint64_t mapCacheKey(std::string_view str);
+
+/**
+ * A message that was logged while parsing a map file, including its prefix and location.
+ */
+using MapCacheMessage = std::tuple<LogLevel, std::string>;
+
+struct MapCacheContents
+{
+  std::vector<MapReader::ObjectInfo> objectInfos;
+  std::vector<MapCacheMessage> messages;
+};
+
+/**
+ * Writes the given object infos and parser messages to a binary cache.
+ *
+ * Brush faces are stored with their UV coordinate systems already converted to the
+ * target map format, so that they can be recreated without converting them again. The
+ * messages are stored so that they can be logged again when the cache is read.
+ *
+ * @param stream the stream to write to, must be opened in binary mode
+ * @param key the key of the map file contents, see mapCacheKey
+ * @param sourceMapFormat the format of the map file
+ * @param targetMapFormat the format that the object infos were converted to
+ * @param objectInfos the object infos to write
+ * @param messages the messages that were logged while parsing the object infos
+ */
+void writeMapCache(
+  std::ostream& stream,
+  uint64_t key,
+  Model::MapFormat sourceMapFormat,
+  Model::MapFormat targetMapFormat,
+  const std::vector<MapReader::ObjectInfo>& objectInfos,
+  const std::vector<MapCacheMessage>& messages);
+
+/**
+ * Reads the object infos and parser messages from the given binary cache.
+ *
+ * Returns nullopt if the cache is empty, malformed, was written by a different version
+ * or if it doesn't match the given key and map formats.
+ */
+std::optional<MapCacheContents> readMapCache(
+  std::string_view cache,
+  uint64_t key,
+  Model::MapFormat sourceMapFormat,
+  Model::MapFormat targetMapFormat);
+
+} // namespace TrenchBroom::IO
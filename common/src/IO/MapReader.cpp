@@ -21,7 +21,10 @@
 
 #include "Error.h" // IWYU pragma: keep
 #include "FileLocation.h"
+#include "IO/EntityChunks.h"
+#include "IO/MapCache.h"
 #include "IO/ParserStatus.h"
+#include "Logger.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushNode.h"
 #include "Model/Entity.h"
@@ -36,6 +39,7 @@
 #include "Model/WorldNode.h"
 #include "Uuid.h"
 
+#include "kdl/overload.h"
 #include "kdl/parallel.h"
 #include "kdl/result.h"
 #include "kdl/string_format.h"
@@ -51,7 +55,9 @@
 #include <cassert>
 #include <optional>
 #include <ostream>
+#include <sstream>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -70,22 +76,160 @@ auto getFilePosition(const T& info)
   return std::tuple{startLine, lineCount};
 }
 
+Logger& nullLogger()
+{
+  // never used because the parser statuses below override doLog
+  static auto logger = NullLogger{};
+  return logger;
+}
+
+/**
+ * Records the messages logged while parsing a chunk so that they can be logged in file
+ * order once all chunks have been parsed.
+ */
+class BufferedParserStatus : public ParserStatus
+{
+public:
+  using Message = MapCacheMessage;
+
+private:
+  std::vector<Message> m_messages;
+
+public:
+  explicit BufferedParserStatus(std::string prefix)
+    : ParserStatus{nullLogger(), std::move(prefix)}
+  {
+  }
+
+  std::vector<Message> messages() && { return std::move(m_messages); }
+
+private:
+  void doProgress(double) override {}
+
+  void doLog(const LogLevel level, const std::string& str) override
+  {
+    m_messages.emplace_back(level, str);
+  }
+};
+
+/**
+ * Forwards everything to another parser status and records the logged messages so that
+ * they can be stored in the map cache.
+ */
+class RecordingParserStatus : public ParserStatus
+{
+private:
+  ParserStatus& m_status;
+  std::vector<MapCacheMessage> m_messages;
+
+public:
+  explicit RecordingParserStatus(ParserStatus& status)
+    : ParserStatus{nullLogger(), status.prefix()}
+    , m_status{status}
+  {
+  }
+
+  std::vector<MapCacheMessage> messages() && { return std::move(m_messages); }
+
+private:
+  void doProgress(const double progress) override { m_status.progress(progress); }
+
+  void doLog(const LogLevel level, const std::string& str) override
+  {
+    m_messages.emplace_back(level, str);
+    m_status.logMessage(level, str);
+  }
+};
+
+void logMessages(const std::vector<MapCacheMessage>& messages, ParserStatus& status)
+{
+  for (const auto& [level, message] : messages)
+  {
+    status.logMessage(level, message);
+  }
+}
+
 } // namespace
 
+/**
+ * Parses a single chunk of a map file and records the object infos for it.
+ */
+class MapReader::ChunkReader : public MapReader
+{
+public:
+  ChunkReader(
+    const MapChunk& chunk,
+    const Model::MapFormat sourceMapFormat,
+    const Model::MapFormat targetMapFormat)
+    : MapReader{chunk.str, sourceMapFormat, targetMapFormat, {}, chunk.line, chunk.column}
+  {
+  }
+
+  std::vector<ObjectInfo> readHeader(ParserStatus& status) &&
+  {
+    parseEntityHeader(status);
+    return std::move(m_objectInfos);
+  }
+
+  std::vector<ObjectInfo> readBody(ParserStatus& status) &&
+  {
+    parseEntityBody(status);
+    return std::move(m_objectInfos);
+  }
+
+private:
+  Model::Node* onWorldNode(std::unique_ptr<Model::WorldNode>, ParserStatus&) override
+  {
+    return nullptr;
+  }
+
+  void onLayerNode(std::unique_ptr<Model::Node>, ParserStatus&) override {}
+
+  void onNode(Model::Node*, std::unique_ptr<Model::Node>, ParserStatus&) override {}
+};
+
 MapReader::MapReader(
   const std::string_view str,
   const Model::MapFormat sourceMapFormat,
   const Model::MapFormat targetMapFormat,
-  Model::EntityPropertyConfig entityPropertyConfig)
-  : StandardMapParser{str, sourceMapFormat, targetMapFormat}
+  Model::EntityPropertyConfig entityPropertyConfig,
+  const size_t line,
+  const size_t column)
+  : StandardMapParser{str, sourceMapFormat, targetMapFormat, line, column}
+  , m_str{str}
   , m_entityPropertyConfig{std::move(entityPropertyConfig)}
 {
 }
 
+void MapReader::setParallelParsingThreshold(const size_t parallelParsingThreshold)
+{
+  m_parallelParsingThreshold = parallelParsingThreshold;
+}
+
+void MapReader::setCache(const std::string_view cache)
+{
+  m_cache = cache;
+  m_cacheKey = mapCacheKey(m_str);
+  m_updatedCache = std::nullopt;
+}
+
+const std::optional<std::string>& MapReader::updatedCache() const
+{
+  return m_updatedCache;
+}
+
 void MapReader::readEntities(const vm::bbox3& worldBounds, ParserStatus& status)
 {
   m_worldBounds = worldBounds;
-  parseEntities(status);
+  if (!readCachedEntities(status))
+  {
+    auto recordingStatus = RecordingParserStatus{status};
+    if (!parseEntityChunks(recordingStatus))
+    {
+      parseEntities(recordingStatus);
+    }
+    updateCache(std::move(recordingStatus).messages());
+  }
   createNodes(status);
 }
 
@@ -905,6 +1049,114 @@ std::unordered_map<Model::Node*, Model::Node*> buildNodeToParentMap(
 }
 } // namespace
 
+bool MapReader::parseEntityChunks(ParserStatus& status)
+{
+  if (m_str.size() < m_parallelParsingThreshold)
+  {
+    return false;
+  }
+
+  const auto entityChunks = findEntityChunks(m_str, ParallelParsingChunkSize);
+  if (!entityChunks)
+  {
+    return false;
+  }
+
+  struct ChunkTask
+  {
+    const MapChunk* chunk;
+    bool header;
+  };
+
+  struct ChunkResult
+  {
+    std::vector<ObjectInfo> objectInfos;
+    std::vector<BufferedParserStatus::Message> messages;
+  };
+
+  auto tasks = std::vector<ChunkTask>{};
+  for (const auto& entity : *entityChunks)
+  {
+    tasks.push_back({&entity.header, true});
+    for (const auto& body : entity.bodies)
+    {
+      tasks.push_back({&body, false});
+    }
+  }
+
+  auto results = std::vector<ChunkResult>{};
+  try
+  {
+    results = kdl::vec_parallel_transform(std::move(tasks), [&](const auto& task) {
+      auto chunkStatus = BufferedParserStatus{status.prefix()};
+      auto reader = ChunkReader{*task.chunk, m_sourceMapFormat, m_targetMapFormat};
+      auto objectInfos = task.header ? std::move(reader).readHeader(chunkStatus)
+                                     : std::move(reader).readBody(chunkStatus);
+      return ChunkResult{std::move(objectInfos), std::move(chunkStatus).messages()};
+    });
+  }
+  catch (const ParserException&)
+  {
+    return false;
+  }
+
+  // merge the results in file order and connect the brushes and patches to their
+  // entities
+  auto resultIt = results.begin();
+  for (const auto& entity : *entityChunks)
+  {
+    const auto entityIndex = m_objectInfos.size();
+    const auto endLocation = FileLocation{entity.endLine, entity.endColumn};
+
+    for (size_t i = 0; i < entity.bodies.size() + 1; ++i, ++resultIt)
+    {
+      logMessages(resultIt->messages, status);
+      for (auto& objectInfo : resultIt->objectInfos)
+      {
+        std::visit(
+          kdl::overload(
+            [&](EntityInfo& entityInfo) { entityInfo.endLocation = endLocation; },
+            [&](BrushInfo& brushInfo) { brushInfo.parentIndex = entityIndex; },
+            [&](PatchInfo& patchInfo) { patchInfo.parentIndex = entityIndex; }),
+          objectInfo);
+        m_objectInfos.push_back(std::move(objectInfo));
+      }
+    }
+  }
+
+  return true;
+}
+
+bool MapReader::readCachedEntities(ParserStatus& status)
+{
+  if (!m_cache)
+  {
+    return false;
+  }
+
+  if (
+    auto contents =
+      readMapCache(*m_cache, m_cacheKey, m_sourceMapFormat, m_targetMapFormat))
+  {
+    logMessages(contents->messages, status);
+    m_objectInfos = std::move(contents->objectInfos);
+    return true;
+  }
+
+  return false;
+}
+
+void MapReader::updateCache(const std::vector<MapCacheMessage>& messages)
+{
+  if (m_cache)
+  {
+    auto stream = std::ostringstream{};
+    writeMapCache(
+      stream, m_cacheKey, m_sourceMapFormat, m_targetMapFormat, m_objectInfos, messages);
+    m_updatedCache = stream.str();
+  }
+}
+
 /**
  * Creates nodes from the recorded object infos and resolves parent / child relationships.
  *
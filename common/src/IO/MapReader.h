@@ -30,11 +30,19 @@
 #include "vm/bbox.h" // IWYU pragma: keep
 #include "vm/forward.h"
 
+#include <cstdint>
 #include <optional>
+#include <string>
 #include <string_view>
+#include <tuple>
 #include <variant>
 #include <vector>
 
+namespace TrenchBroom
+{
+enum class LogLevel;
+}
+
 namespace TrenchBroom::Model
 {
 class BrushNode;
@@ -63,7 +71,8 @@ class ParserStatus;
  * The flow of control is:
  *
  * 1. MapParser callbacks get called with the raw data, which we just store
- * (m_objectInfos).
+ * (m_objectInfos). Large inputs are split into chunks of entities and brushes which are
+ * parsed in parallel, and the results are merged in file order.
  * 2. Convert the raw data to nodes in parallel (createNodes) and record any additional
  * information necessary to restore the parent / child relationships.
  * 3. Validate the created nodes.
@@ -101,9 +110,28 @@ public: // only public so that helper methods can see these declarations
 
   using ObjectInfo = std::variant<EntityInfo, BrushInfo, PatchInfo>;
 
+  /**
+   * Inputs of at least this many bytes are split into chunks which are parsed in
+   * parallel when reading entities.
+   */
+  static constexpr size_t DefaultParallelParsingThreshold = 1024 * 1024;
+
+  /**
+   * The approximate size in bytes of the chunks of brushes and patches that are parsed in
+   * parallel.
+   */
+  static constexpr size_t ParallelParsingChunkSize = 64 * 1024;
+
 private:
+  class ChunkReader;
+
+  std::string_view m_str;
   Model::EntityPropertyConfig m_entityPropertyConfig;
   vm::bbox3 m_worldBounds;
+  size_t m_parallelParsingThreshold = DefaultParallelParsingThreshold;
+  std::optional<std::string_view> m_cache;
+  uint64_t m_cacheKey = 0;
+  std::optional<std::string> m_updatedCache;
 
 private: // data populated in response to MapParser callbacks
   std::vector<ObjectInfo> m_objectInfos;
@@ -119,12 +147,46 @@ protected:
    * @param targetMapFormat the format to convert the created objects to
    * @param entityPropertyConfig the entity property config to use
    * if orphaned
+   * @param line the line at which the given string starts in its file
+   * @param column the column at which the given string starts in its file
    */
   MapReader(
     std::string_view str,
     Model::MapFormat sourceMapFormat,
     Model::MapFormat targetMapFormat,
-    Model::EntityPropertyConfig entityPropertyConfig);
+    Model::EntityPropertyConfig entityPropertyConfig,
+    size_t line = 1,
+    size_t column = 1);
+
+public:
+  /**
+   * Sets the minimum size of the input for which entities are split into chunks that are
+   * parsed in parallel. Pass 0 to always parse in parallel. Inputs that cannot be split
+   * into chunks are always parsed serially.
+   */
+  void setParallelParsingThreshold(size_t parallelParsingThreshold);
+
+  /**
+   * Sets the contents of a map cache (see MapCache.h) to read the entities from instead of
+   * parsing the input. Pass an empty string if no cache exists yet.
+   *
+   * If the cache does not match the input, the input is parsed and the contents of an
+   * updated cache are made available via updatedCache(). Messages logged while parsing
+   * the input are stored in the cache and logged again when the cache is read.
+   *
+   * The cache only saves tokenizing and parsing the input. Brush geometry is not cached,
+   * so every brush is still created from its faces when the entities are read from the
+   * cache.
+   */
+  void setCache(std::string_view cache);
+
+  /**
+   * Returns the contents of an updated cache if a cache was set and it did not match the
+   * input.
+   */
+  const std::optional<std::string>& updatedCache() const;
+
+protected:
 
   /**
    * Attempts to parse as one or more entities.
@@ -182,6 +244,20 @@ protected: // implement MapParser interface
     ParserStatus& status) override;
 
 private: // helper methods
+  /**
+   * Splits the input into chunks of entities and brushes and parses them in parallel.
+   * Returns false if the input is too small, if it cannot be split into chunks, or if
+   * parsing a chunk fails. In that case, nothing is recorded and the input must be
+   * parsed serially.
+   */
+  bool parseEntityChunks(ParserStatus& status);
+  /**
+   * Records the object infos from the cache if it matches the input and logs the
+   * messages that were stored with them. Returns false if no cache was set or if it does
+   * not match.
+   */
+  bool readCachedEntities(ParserStatus& status);
+  void updateCache(const std::vector<std::tuple<LogLevel, std::string>>& messages);
   void createNodes(ParserStatus& status);
 
 private: // subclassing interface - these will be called in the order that nodes should be
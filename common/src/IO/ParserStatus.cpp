@@ -95,6 +95,16 @@ void ParserStatus::errorAndThrow(const std::string& str)
   throw ParserException(buildMessage(str));
 }
 
+const std::string& ParserStatus::prefix() const
+{
+  return m_prefix;
+}
+
+void ParserStatus::logMessage(const LogLevel level, const std::string& message)
+{
+  doLog(level, message);
+}
+
 void ParserStatus::log(
   const LogLevel level, const FileLocation& location, const std::string& str)
 {
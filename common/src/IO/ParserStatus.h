@@ -57,6 +57,13 @@ public:
   void error(const std::string& str);
   [[noreturn]] void errorAndThrow(const std::string& str);
 
+  const std::string& prefix() const;
+
+  /**
+   * Logs a message that was already built by another parser status with the same prefix.
+   */
+  void logMessage(LogLevel level, const std::string& message);
+
 private:
   void log(LogLevel level, const FileLocation& location, const std::string& str);
   std::string buildMessage(const FileLocation& location, const std::string& str) const;
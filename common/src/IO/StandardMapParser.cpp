@@ -40,8 +40,9 @@ const std::string& QuakeMapTokenizer::NumberDelim()
   return numberDelim;
 }
 
-QuakeMapTokenizer::QuakeMapTokenizer(const std::string_view str)
-  : Tokenizer{str, "\"", '\\'}
+QuakeMapTokenizer::QuakeMapTokenizer(
+  const std::string_view str, const size_t line, const size_t column)
+  : Tokenizer{str, "\"", '\\', line, column}
 {
 }
 
@@ -153,8 +154,10 @@ const std::string StandardMapParser::PatchId = "patchDef2";
 StandardMapParser::StandardMapParser(
   const std::string_view str,
   const Model::MapFormat sourceMapFormat,
-  const Model::MapFormat targetMapFormat)
-  : m_tokenizer{str}
+  const Model::MapFormat targetMapFormat,
+  const size_t line,
+  const size_t column)
+  : m_tokenizer{str, line, column}
   , m_sourceMapFormat{sourceMapFormat}
   , m_targetMapFormat{targetMapFormat}
 {
@@ -198,6 +201,57 @@ void StandardMapParser::parseBrushFaces(ParserStatus& status)
   }
 }
 
+void StandardMapParser::parseEntityHeader(ParserStatus& status)
+{
+  auto token = expect(QuakeMapToken::OBrace, m_tokenizer.nextToken());
+
+  auto properties = std::vector<Model::EntityProperty>();
+  auto propertyKeys = EntityPropertyKeys();
+
+  const auto startLocation = token.location();
+
+  token = m_tokenizer.peekToken();
+  while (token.type() != QuakeMapToken::Eof)
+  {
+    switch (token.type())
+    {
+    case QuakeMapToken::Comment:
+      m_tokenizer.nextToken();
+      break;
+    case QuakeMapToken::String:
+      parseEntityProperty(properties, propertyKeys, status);
+      break;
+    default:
+      expect(QuakeMapToken::Comment | QuakeMapToken::String, token);
+    }
+
+    token = m_tokenizer.peekToken();
+  }
+
+  onBeginEntity(startLocation, std::move(properties), status);
+}
+
+void StandardMapParser::parseEntityBody(ParserStatus& status)
+{
+  auto token = m_tokenizer.peekToken();
+  while (token.type() != QuakeMapToken::Eof)
+  {
+    switch (token.type())
+    {
+    case QuakeMapToken::Comment:
+      m_tokenizer.nextToken();
+      break;
+    case QuakeMapToken::OBrace:
+      parseBrushOrBrushPrimitiveOrPatch(status);
+      break;
+    default:
+      expect(QuakeMapToken::Comment | QuakeMapToken::OBrace, token);
+    }
+
+    token = m_tokenizer.peekToken();
+  }
+}
+
 void StandardMapParser::reset()
 {
   m_tokenizer.reset();
@@ -67,7 +67,7 @@ private:
   bool m_skipEol = true;
 
 public:
-  explicit QuakeMapTokenizer(std::string_view str);
+  explicit QuakeMapTokenizer(std::string_view str, size_t line = 1, size_t column = 1);
 
   void setSkipEol(bool skipEol);
 
@@ -98,11 +98,15 @@ public:
    * @param str the string to parse
    * @param sourceMapFormat the expected format of the given string
    * @param targetMapFormat the format to convert the created objects to
+   * @param line the line at which the given string starts in its file
+   * @param column the column at which the given string starts in its file
    */
   StandardMapParser(
     std::string_view str,
     Model::MapFormat sourceMapFormat,
-    Model::MapFormat targetMapFormat);
+    Model::MapFormat targetMapFormat,
+    size_t line = 1,
+    size_t column = 1);
 
   ~StandardMapParser() override;
 
@@ -111,6 +115,16 @@ protected:
   void parseBrushesOrPatches(ParserStatus& status);
   void parseBrushFaces(ParserStatus& status);
 
+  /**
+   * Parses the opening brace and the properties of a single entity. The input must end
+   * after the properties.
+   */
+  void parseEntityHeader(ParserStatus& status);
+  /**
+   * Parses the brushes and patches of a single entity, but not its braces.
+   */
+  void parseEntityBody(ParserStatus& status);
+
   void reset();
 
 private:
@@ -25,6 +25,7 @@
 
 #include <cassert>
 #include <string>
+#include <string_view>
 
 namespace TrenchBroom::IO
 {
@@ -70,6 +71,8 @@ public:
 
   const std::string data() const { return std::string(m_begin, length()); }
 
+  std::string_view view() const { return std::string_view(m_begin, length()); }
+
   size_t position() const { return m_position; }
 
   size_t length() const { return static_cast<size_t>(m_end - m_begin); }
@@ -83,13 +86,13 @@ public:
   template <typename T>
   T toFloat() const
   {
-    return static_cast<T>(kdl::str_to_double(std::string(m_begin, m_end)).value_or(0.0));
+    return static_cast<T>(kdl::str_to_double(view()).value_or(0.0));
   }
 
   template <typename T>
   T toInteger() const
   {
-    return static_cast<T>(kdl::str_to_long(std::string(m_begin, m_end)).value_or(0l));
+    return static_cast<T>(kdl::str_to_long(view()).value_or(0l));
   }
 };
 
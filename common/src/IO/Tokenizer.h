@@ -25,7 +25,11 @@
 
 #include "kdl/string_format.h"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -33,6 +37,53 @@
 namespace TrenchBroom::IO
 {
 
+namespace detail
+{
+/**
+ * Returns a pointer to the first character in the given range that is one of the given
+ * delimiters, or `end` if there is no such character.
+ *
+ * On little endian platforms, eight characters are tested at once by comparing each
+ * byte of a machine word with every delimiter.
+ */
+inline const char* findFirstOf(
+  const char* begin, const char* end, const std::string_view delims)
+{
+  if constexpr (std::endian::native == std::endian::little)
+  {
+    constexpr auto ones = uint64_t(0x0101010101010101);
+    constexpr auto highBits = uint64_t(0x8080808080808080);
+
+    while (end - begin >= 8)
+    {
+      auto word = uint64_t(0);
+      std::memcpy(&word, begin, sizeof(word));
+
+      // sets the high bit of every byte that is equal to a delimiter; bytes above a
+      // matching byte can be false positives, but the lowest set bit is always exact
+      auto matches = uint64_t(0);
+      for (const auto delim : delims)
+      {
+        const auto x = word ^ (ones * uint8_t(delim));
+        matches |= (x - ones) & ~x & highBits;
+      }
+
+      if (matches != 0)
+      {
+        return begin + std::countr_zero(matches) / 8;
+      }
+      begin += 8;
+    }
+  }
+
+  while (begin != end && delims.find(*begin) == std::string_view::npos)
+  {
+    ++begin;
+  }
+  return begin;
+}
+} // namespace detail
+
 struct TokenizerState
 {
   const char* cur;
@@ -127,9 +178,49 @@ protected:
 
   void advance(size_t offset)
   {
-    for (size_t i = 0; i < offset; ++i)
+    const auto remaining = size_t(m_end - m_state.cur);
+    advanceTo(m_state.cur + std::min(offset, remaining));
+    if (offset > remaining)
     {
-      advance();
+      errorIfEof();
+    }
+  }
+
+  /**
+   * Advances to the given position, which must not be before the current position or
+   * after the end of the input. This is equivalent to calling advance() for each
+   * character in between, but runs of characters without line breaks are skipped at
+   * once.
+   */
+  void advanceTo(const char* ptr)
+  {
+    assert(ptr >= m_state.cur);
+    assert(ptr <= m_end);
+
+    while (m_state.cur != ptr)
+    {
+      const auto* lineBreak = detail::findFirstOf(m_state.cur, ptr, "\n\r");
+      if (lineBreak != m_state.cur)
+      {
+        // only a trailing run of escape characters affects whether the next character
+        // is escaped, and each of them toggles the escape state
+        const auto* escapeRun = lineBreak;
+        while (escapeRun != m_state.cur && *(escapeRun - 1) == m_escapeChar)
+        {
+          --escapeRun;
+        }
+        const auto escapeRunLength = size_t(lineBreak - escapeRun);
+        const auto escapedBefore = escapeRun == m_state.cur && m_state.escaped;
+
+        m_state.escaped = escapedBefore != (escapeRunLength % 2 == 1);
+        m_state.column += size_t(lineBreak - m_state.cur);
+        m_state.cur = lineBreak;
+      }
+
+      if (m_state.cur != ptr)
+      {
+        advance();
+      }
     }
   }
 
@@ -356,23 +447,20 @@ protected:
 
   const char* readInteger(std::string_view delims)
   {
-    if (curChar() == '+' || curChar() == '-' || isDigit(curChar()))
+    const auto* ptr = curPos();
+    if (!eof() && (*ptr == '+' || *ptr == '-' || isDigit(*ptr)))
     {
-      const auto previousState = m_state;
-      if (curChar() == '+' || curChar() == '-')
+      if (*ptr == '+' || *ptr == '-')
       {
-        advance();
-      }
-      while (!eof() && isDigit(curChar()))
-      {
-        advance();
+        ++ptr;
       }
-      if (eof() || isAnyOf(curChar(), delims))
+      ptr = skipDigits(ptr);
+
+      if (eof(ptr) || isAnyOf(*ptr, delims))
       {
-        return curPos();
+        advanceTo(ptr);
+        return ptr;
       }
-
-      m_state = previousState;
     }
 
     return nullptr;
@@ -380,49 +468,46 @@ protected:
 
   const char* readDecimal(std::string_view delims)
   {
-    if (curChar() == '+' || curChar() == '-' || curChar() == '.' || isDigit(curChar()))
+    const auto* ptr = curPos();
+    if (!eof() && (*ptr == '+' || *ptr == '-' || *ptr == '.' || isDigit(*ptr)))
     {
-      const auto previousState = m_state;
-      if (curChar() != '.')
+      if (*ptr != '.')
       {
-        advance();
-        readDigits();
+        ptr = skipDigits(ptr + 1);
       }
 
-      if (curChar() == '.')
+      if (!eof(ptr) && *ptr == '.')
       {
-        advance();
-        readDigits();
+        ptr = skipDigits(ptr + 1);
       }
 
-      if (curChar() == 'e' || curChar() == 'E')
+      if (!eof(ptr) && (*ptr == 'e' || *ptr == 'E'))
       {
-        advance();
-        if (curChar() == '+' || curChar() == '-' || isDigit(curChar()))
+        ++ptr;
+        if (!eof(ptr) && (*ptr == '+' || *ptr == '-' || isDigit(*ptr)))
         {
-          advance();
-          readDigits();
+          ptr = skipDigits(ptr + 1);
         }
       }
 
-      if (eof() || isAnyOf(curChar(), delims))
+      if (eof(ptr) || isAnyOf(*ptr, delims))
       {
-        return curPos();
+        advanceTo(ptr);
+        return ptr;
       }
-
-      m_state = previousState;
     }
 
     return nullptr;
   }
 
 private:
-  void readDigits()
+  const char* skipDigits(const char* ptr) const
   {
-    while (!eof() && isDigit(curChar()))
+    while (!eof(ptr) && isDigit(*ptr))
     {
-      advance();
+      ++ptr;
     }
+    return ptr;
   }
 
 protected:
@@ -430,26 +515,26 @@ protected:
   {
     if (!eof())
     {
-      do
-      {
-        advance();
-      } while (!eof() && !isAnyOf(curChar(), delims));
+      advanceTo(detail::findFirstOf(curPos() + 1, m_end, delims));
     }
     return curPos();
   }
 
   const char* readWhile(std::string_view allow)
   {
-    while (!eof() && isAnyOf(curChar(), allow))
-    {
-      advance();
-    }
+    discardWhile(allow);
     return curPos();
   }
 
   const char* readQuotedString(
     const char delim = '"', std::string_view hackDelims = std::string_view{})
   {
+    // only the delimiter, the escape character and the double quotation marks checked
+    // by the hack below need to be looked at individually
+    const char stopChars[] = {delim, m_escapeChar, '"'};
+    const auto stopCharsView = std::string_view{stopChars, 3};
+
+    advanceTo(detail::findFirstOf(curPos(), m_end, stopCharsView));
     while (!eof() && (curChar() != delim || isEscaped()))
     {
       // This is a hack to handle paths with trailing backslashes that get misinterpreted
@@ -462,6 +547,7 @@ protected:
         break;
       }
       advance();
+      advanceTo(detail::findFirstOf(curPos(), m_end, stopCharsView));
     }
     errorIfEof();
     const char* end = curPos();
@@ -471,18 +557,17 @@ protected:
 
   void discardWhile(std::string_view allow)
   {
-    while (!eof() && isAnyOf(curChar(), allow))
+    const auto* ptr = curPos();
+    while (!eof(ptr) && isAnyOf(*ptr, allow))
     {
-      advance();
+      ++ptr;
     }
+    advanceTo(ptr);
   }
 
   void discardUntil(std::string_view delims)
   {
-    while (!eof() && !isAnyOf(curChar(), delims))
-    {
-      advance();
-    }
+    advanceTo(detail::findFirstOf(curPos(), m_end, delims));
   }
 
   bool matchesPattern(std::string_view pattern) const
@@ -505,9 +590,11 @@ protected:
   {
     if (!pattern.empty())
     {
+      advanceTo(detail::findFirstOf(curPos(), m_end, pattern.substr(0, 1)));
       while (!eof() && !matchesPattern(pattern))
       {
         advance();
+        advanceTo(detail::findFirstOf(curPos(), m_end, pattern.substr(0, 1)));
       }
 
       if (eof())
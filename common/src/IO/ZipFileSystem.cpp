@@ -66,7 +66,15 @@ Result<void> ZipFileSystem::doReadDirectory()
 {
   mz_zip_zero_struct(&m_archive);
 
-  if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE)
+  if (const auto* mapping = m_file->mapping())
+  {
+    if (mz_zip_reader_init_mem(&m_archive, mapping, m_file->size(), 0) != MZ_TRUE)
+    {
+      return Error{"Error calling mz_zip_reader_init_mem"};
+    }
+  }
+  else if (
+    mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE)
   {
     return Error{"Error calling mz_zip_reader_init_cfile"};
   }
@@ -29,6 +29,7 @@
 #include "Polyhedron.h"
 #include "Polyhedron_Matcher.h"
 
+#include "kdl/parallel.h"
 #include "kdl/reflection_impl.h"
 #include "kdl/result.h"
 #include "kdl/result_fold.h"
@@ -166,12 +167,93 @@ Result<void> Brush::updateGeometryFromFaces(const vm::bbox3& worldBounds)
   return kdl::void_success;
 }
 
+bool Brush::transformGeometry(
+  const vm::bbox3& worldBounds, const vm::mat4x4& transformation)
+{
+  if (!m_geometry || !m_geometry->transform(transformation))
+  {
+    return false;
+  }
+
+  // Apply the same correction as when rebuilding the geometry
+  m_geometry->correctVertexPositions();
+  if (!worldBounds.contains(m_geometry->bounds()))
+  {
+    return false;
+  }
+
+  // Edges which are too short would be healed when rebuilding, which may remove faces
+  const auto minEdgeLength2 = BrushGeometry::MinEdgeLength * BrushGeometry::MinEdgeLength;
+  for (const auto* edge : m_geometry->edges())
+  {
+    if (vm::squared_length(edge->vector()) < minEdgeLength2)
+    {
+      return false;
+    }
+  }
+
+  // Every vertex must still lie on the boundaries of its faces
+  const auto epsilon = vm::constants<FloatType>::point_status_epsilon();
+  for (const auto* faceGeometry : m_geometry->faces())
+  {
+    const auto faceIndex = faceGeometry->payload();
+    if (!faceIndex)
+    {
+      return false;
+    }
+
+    const auto& boundary = m_faces[*faceIndex].boundary();
+    for (const auto* halfEdge : faceGeometry->boundary())
+    {
+      if (
+        vm::abs(boundary.point_distance(halfEdge->origin()->position())) > epsilon)
+      {
+        return false;
+      }
+    }
+  }
+
+  // Keep the faces in the order in which they would be after rebuilding the geometry
+  BrushFace::sortFaces(m_faces);
+  for (size_t i = 0u; i < m_faces.size(); ++i)
+  {
+    m_faces[i].geometry()->setPayload(i);
+  }
+
+  assert(checkFaceLinks());
+
+  return true;
+}
+
 const vm::bbox3& Brush::bounds() const
 {
   ensure(m_geometry != nullptr, "geometry is null");
   return m_geometry->bounds();
 }
 
+bool Brush::hasGeometry() const
+{
+  return m_geometry != nullptr;
+}
+
+void Brush::discardGeometry()
+{
+  for (auto& face : m_faces)
+  {
+    face.setGeometry(nullptr);
+  }
+  m_geometry.reset();
+}
+
+Result<void> Brush::restoreGeometry(const vm::bbox3& worldBounds)
+{
+  if (m_geometry)
+  {
+    return kdl::void_success;
+  }
+  return updateGeometryFromFaces(worldBounds);
+}
+
 std::optional<size_t> Brush::findFace(const std::string& materialName) const
 {
   return kdl::vec_index_of(m_faces, [&](const BrushFace& face) {
@@ -1136,18 +1218,16 @@ std::vector<Result<Brush>> Brush::subtract(
 
   for (const auto* subtrahend : subtrahends)
   {
-    auto nextResults = std::vector<BrushGeometry>{};
-
-    for (const BrushGeometry& fragment : result)
-    {
-      auto subFragments = fragment.subtract(*subtrahend->m_geometry);
-      nextResults = kdl::vec_concat(std::move(nextResults), std::move(subFragments));
-    }
-
-    result = std::move(nextResults);
+    // the fragments are independent, and the sub fragments are kept in the order of the
+    // fragments they were cut from, so the result does not depend on the scheduling
+    auto subFragments =
+      kdl::vec_parallel_transform(std::move(result), [&](const auto& fragment) {
+        return fragment.subtract(*subtrahend->m_geometry);
+      });
+    result = kdl::vec_flatten(std::move(subFragments));
   }
 
-  return kdl::vec_transform(result, [&](const auto& geometry) {
+  return kdl::vec_parallel_transform(std::move(result), [&](const auto& geometry) {
     return createBrush(
       mapFormat, worldBounds, defaultMaterialName, geometry, subtrahends);
   });
@@ -1182,6 +1262,11 @@ Result<void> Brush::transform(
     }
   }
 
+  if (transformGeometry(worldBounds, transformation))
+  {
+    return kdl::void_success;
+  }
+
   return updateGeometryFromFaces(worldBounds);
 }
 
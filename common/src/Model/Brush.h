@@ -78,9 +78,44 @@ private:
 
   Result<void> updateGeometryFromFaces(const vm::bbox3& worldBounds);
 
+  /**
+   * Applies the given transformation to the existing geometry instead of rebuilding it
+   * from the faces, which must already have been transformed. This is much cheaper than
+   * rebuilding the geometry, but it is only possible for invertible, orientation
+   * preserving affine transformations.
+   *
+   * Returns false if the transformation cannot be applied or if the transformed geometry
+   * does not match the faces precisely enough. In that case, the geometry is left in an
+   * unspecified state and must be rebuilt.
+   */
+  bool transformGeometry(const vm::bbox3& worldBounds, const vm::mat4x4& transformation);
+
 public:
   const vm::bbox3& bounds() const;
 
+public: // geometry management:
+  /**
+   * Indicates whether this brush has geometry. A brush only lacks geometry after it was
+   * discarded by calling discardGeometry.
+   */
+  bool hasGeometry() const;
+
+  /**
+   * Discards the geometry of this brush to save memory, e.g. while it is stored in the
+   * undo history. Only the faces are retained. No function that requires the geometry may
+   * be called until it has been rebuilt by calling restoreGeometry.
+   */
+  void discardGeometry();
+
+  /**
+   * Rebuilds the geometry of this brush from its faces if it was discarded. Does nothing
+   * if this brush has geometry.
+   *
+   * @param worldBounds the world bounds
+   * @return a void result or an error if the geometry cannot be rebuilt
+   */
+  Result<void> restoreGeometry(const vm::bbox3& worldBounds);
+
 public: // face management:
   std::optional<size_t> findFace(const std::string& materialName) const;
   std::optional<size_t> findFace(const vm::vec3& normal) const;
@@ -286,6 +321,9 @@ public:
    * Subtracts the given subtrahends from `this`, returning the result but without
    * modifying `this`.
    *
+   * The fragments are computed in parallel, but their order does not depend on the
+   * scheduling.
+   *
    * @param subtrahends brushes to subtract from `this`. The passed-in brushes are not
    * modified.
    * @return the subtraction result framents as Brushes, or Errors for any fragments
@@ -21,6 +21,7 @@
 
 #include "Color.h"
 
+#include "kdl/interned_string.h"
 #include "kdl/reflection_decl.h"
 
 #include "vm/forward.h"
@@ -43,7 +44,8 @@ public:
   static const std::string NoMaterialName;
 
 private:
-  std::string m_materialName;
+  // material names are shared by many faces, so they are interned
+  kdl::interned_string m_materialName;
 
   vm::vec2f m_offset = vm::vec2f::zero();
   vm::vec2f m_scale = vm::vec2f::one();
@@ -71,6 +73,12 @@ public:
     m_color);
 
   const std::string& materialName() const;
+  /**
+   * Returns the interned material name. Two faces have the same material name if and
+   * only if their interned material names are equal, which is cheaper to check than
+   * comparing the strings.
+   */
+  const kdl::interned_string& internedMaterialName() const;
 
   const vm::vec2f& offset() const;
   float xOffset() const;
@@ -94,6 +102,7 @@ public:
   bool valid() const;
 
   bool setMaterialName(const std::string& materialName);
+  bool setMaterialName(const kdl::interned_string& materialName);
   bool setOffset(const vm::vec2f& offset);
   bool setXOffset(float xOffset);
   bool setYOffset(float yOffset);
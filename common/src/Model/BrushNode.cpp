@@ -116,6 +116,7 @@ Brush BrushNode::setBrush(Brush brush)
 
   using std::swap;
   swap(m_brush, brush);
+  m_facePlanes.clear();
 
   updateSelectedFaceCount();
   invalidateIssues();
@@ -386,14 +387,32 @@ std::optional<std::tuple<FloatType, size_t>> BrushNode::findFaceHit(
 {
   if (vm::intersect_ray_bbox(ray, logicalBounds()))
   {
-    for (size_t i = 0u; i < m_brush.faceCount(); ++i)
+    const auto count = m_brush.faceCount();
+    if (m_facePlanes.empty())
     {
-      const auto& face = m_brush.face(i);
-      if (const auto distance = face.intersectWithRay(ray))
+      m_facePlanes.resize(4u * count);
+      for (size_t i = 0u; i < count; ++i)
       {
-        return std::tuple{*distance, i};
+        const auto& boundary = m_brush.face(i).boundary();
+        m_facePlanes[i] = boundary.normal.x();
+        m_facePlanes[count + i] = boundary.normal.y();
+        m_facePlanes[2u * count + i] = boundary.normal.z();
+        m_facePlanes[3u * count + i] = boundary.distance;
       }
     }
+
+    if (
+      const auto hit = vm::intersect_ray_convex_polyhedron(
+        ray,
+        m_facePlanes.data(),
+        m_facePlanes.data() + count,
+        m_facePlanes.data() + 2u * count,
+        m_facePlanes.data() + 3u * count,
+        count))
+    {
+      const auto [distance, faceIndex] = *hit;
+      return std::tuple{distance, faceIndex};
+    }
   }
   return std::nullopt;
 }
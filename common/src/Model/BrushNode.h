@@ -72,6 +72,10 @@ private:
   Brush m_brush;               // must be destroyed before the brush renderer cache
   size_t m_selectedFaceCount = 0u;
 
+  // the face planes' normal components and distances in structure of arrays layout, built
+  // lazily when the brush is picked
+  mutable std::vector<FloatType> m_facePlanes;
+
 public:
   explicit BrushNode(Brush brush);
   ~BrushNode() override;
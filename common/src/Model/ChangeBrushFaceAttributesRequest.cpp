@@ -211,7 +211,7 @@ void ChangeBrushFaceAttributesRequest::resetAllToParaxial(
 
 void ChangeBrushFaceAttributesRequest::setMaterialName(const std::string& materialName)
 {
-  m_materialName = materialName;
+  m_materialName = kdl::interned_string{materialName};
   m_materialOp = MaterialOp::Set;
 }
 
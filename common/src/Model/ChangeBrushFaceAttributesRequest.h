@@ -21,6 +21,8 @@
 
 #include "Color.h"
 
+#include "kdl/interned_string.h"
+
 #include "vm/forward.h"
 
 #include <optional>
@@ -68,7 +70,7 @@ public:
   };
 
 private:
-  std::string m_materialName;
+  kdl::interned_string m_materialName;
   float m_xOffset = 0.0f;
   float m_yOffset = 0.0f;
   float m_rotation = 0.0f;
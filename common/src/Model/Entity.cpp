@@ -98,6 +98,7 @@ void Entity::setProperties(std::vector<EntityProperty> properties)
   m_cachedOrigin = std::nullopt;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  invalidateCachedSpecifications();
 }
 
 const std::vector<std::string>& Entity::protectedProperties() const
@@ -156,6 +157,7 @@ void Entity::setDefinition(Assets::EntityDefinition* definition)
 
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  invalidateCachedSpecifications();
 }
 
 const Assets::EntityModel* Entity::model() const
@@ -185,17 +187,22 @@ const Assets::EntityModelFrame* Entity::modelFrame() const
 
 Assets::ModelSpecification Entity::modelSpecification() const
 {
-  if (
-    const auto* pointDefinition =
-      dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
-  {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointDefinition->modelDefinition().modelSpecification(variableStore);
-  }
-  else
+  if (!m_cachedModelSpecification)
   {
-    return Assets::ModelSpecification{};
+    if (
+      const auto* pointDefinition =
+        dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
+    {
+      const auto variableStore = EntityPropertiesVariableStore{*this};
+      m_cachedModelSpecification =
+        pointDefinition->modelDefinition().modelSpecification(variableStore);
+    }
+    else
+    {
+      m_cachedModelSpecification = Assets::ModelSpecification{};
+    }
   }
+  return *m_cachedModelSpecification;
 }
 
 const vm::mat4x4& Entity::modelTransformation(
@@ -223,17 +230,22 @@ const vm::mat4x4& Entity::modelTransformation(
 
 Assets::DecalSpecification Entity::decalSpecification() const
 {
-  if (
-    const auto* pointDefinition =
-      dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
+  if (!m_cachedDecalSpecification)
   {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointDefinition->decalDefinition().decalSpecification(variableStore);
-  }
-  else
-  {
-    return Assets::DecalSpecification{};
+    if (
+      const auto* pointDefinition =
+        dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
+    {
+      const auto variableStore = EntityPropertiesVariableStore{*this};
+      m_cachedDecalSpecification =
+        pointDefinition->decalDefinition().decalSpecification(variableStore);
+    }
+    else
+    {
+      m_cachedDecalSpecification = Assets::DecalSpecification{};
+    }
   }
+  return *m_cachedDecalSpecification;
 }
 
 void Entity::unsetEntityDefinitionAndModel()
@@ -247,6 +259,7 @@ void Entity::unsetEntityDefinitionAndModel()
   m_model = nullptr;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  invalidateCachedSpecifications();
 }
 
 void Entity::addOrUpdateProperty(
@@ -263,7 +276,7 @@ void Entity::addOrUpdateProperty(
 
     if (defaultToProtected && !kdl::vec_contains(m_protectedProperties, key))
     {
-      m_protectedProperties.push_back(std::move(key));
+      m_protectedProperties.push_back(key);
     }
   }
 
@@ -271,6 +284,7 @@ void Entity::addOrUpdateProperty(
   m_cachedOrigin = std::nullopt;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  invalidateCachedSpecifications(key);
 }
 
 void Entity::renameProperty(const std::string& oldKey, std::string newKey)
@@ -297,6 +311,8 @@ void Entity::renameProperty(const std::string& oldKey, std::string newKey)
       m_properties.erase(newIt);
     }
 
+    invalidateCachedSpecifications(oldKey);
+    invalidateCachedSpecifications(newKey);
     oldIt->setKey(std::move(newKey));
 
     m_cachedClassname = std::nullopt;
@@ -317,6 +333,7 @@ void Entity::removeProperty(const std::string& key)
     m_cachedOrigin = std::nullopt;
     m_cachedRotation = std::nullopt;
     m_cachedModelTransformation = std::nullopt;
+    invalidateCachedSpecifications(key);
   }
 }
 
@@ -332,6 +349,7 @@ void Entity::removeNumberedProperty(const std::string& prefix)
     m_cachedOrigin = std::nullopt;
     m_cachedRotation = std::nullopt;
     m_cachedModelTransformation = std::nullopt;
+    invalidateCachedSpecifications();
   }
 }
 
@@ -483,4 +501,29 @@ void Entity::transform(const vm::mat4x4& transformation, const bool updateAngleP
   }
 }
 
+void Entity::invalidateCachedSpecifications()
+{
+  m_cachedModelSpecification = std::nullopt;
+  m_cachedDecalSpecification = std::nullopt;
+}
+
+void Entity::invalidateCachedSpecifications(const std::string& key)
+{
+  if (
+    const auto* pointDefinition =
+      dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
+  {
+    if (std::ranges::binary_search(
+          pointDefinition->modelDefinition().variableNames(), key))
+    {
+      m_cachedModelSpecification = std::nullopt;
+    }
+    if (std::ranges::binary_search(
+          pointDefinition->decalDefinition().variableNames(), key))
+    {
+      m_cachedDecalSpecification = std::nullopt;
+    }
+  }
+}
+
 } // namespace TrenchBroom::Model
@@ -20,6 +20,8 @@
 #pragma once
 
 #include "Assets/AssetReference.h"
+#include "Assets/DecalDefinition.h"
+#include "Assets/ModelSpecification.h"
 #include "EL/EL_Forward.h" // IWYU pragma: keep
 #include "FloatType.h"
 #include "Model/EntityProperties.h"
@@ -35,11 +37,9 @@
 
 namespace TrenchBroom::Assets
 {
-struct DecalSpecification;
 class EntityDefinition;
 class EntityModel;
 class EntityModelFrame;
-struct ModelSpecification;
 } // namespace TrenchBroom::Assets
 
 namespace TrenchBroom::Model
@@ -114,6 +114,13 @@ private:
   mutable std::optional<vm::mat4x4> m_cachedRotation;
   mutable std::optional<vm::mat4x4> m_cachedModelTransformation;
 
+  /**
+   * The model and decal specifications are only invalidated if a property that is read
+   * by the corresponding expression of the entity definition changes.
+   */
+  mutable std::optional<Assets::ModelSpecification> m_cachedModelSpecification;
+  mutable std::optional<Assets::DecalSpecification> m_cachedDecalSpecification;
+
 public:
   Entity();
   explicit Entity(std::vector<EntityProperty> properties);
@@ -188,6 +195,10 @@ public: // property management
   std::vector<EntityProperty> numberedProperties(const std::string& property) const;
 
   void transform(const vm::mat4x4& transformation, bool updateAngleProperty);
+
+private:
+  void invalidateCachedSpecifications();
+  void invalidateCachedSpecifications(const std::string& key);
 };
 
 } // namespace TrenchBroom::Model
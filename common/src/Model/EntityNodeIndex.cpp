@@ -24,11 +24,11 @@
 #include "Model/EntityNodeBase.h"
 #include "Model/EntityProperties.h"
 
-#include "kdl/compact_trie.h"
+#include "kdl/string_compare.h"
 #include "kdl/vector_utils.h"
 
-#include <iterator>
-#include <list>
+#include <functional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -56,26 +56,20 @@ EntityNodeIndexQuery EntityNodeIndexQuery::any()
   return EntityNodeIndexQuery(Type_Any);
 }
 
-std::set<EntityNodeBase*> EntityNodeIndexQuery::execute(
-  const EntityNodeStringIndex& index) const
+bool EntityNodeIndexQuery::matches(const std::string_view key) const
 {
-  std::set<EntityNodeBase*> result;
   switch (m_type)
   {
   case Type_Exact:
-    index.find_matches(m_pattern, std::inserter(result, std::end(result)));
-    break;
+    return kdl::cs::str_is_equal(key, m_pattern);
   case Type_Prefix:
-    index.find_matches(m_pattern + "*", std::inserter(result, std::end(result)));
-    break;
+    return kdl::cs::str_is_prefix(key, m_pattern);
   case Type_Numbered:
-    index.find_matches(m_pattern + "%*", std::inserter(result, std::end(result)));
-    break;
+    return isNumberedProperty(m_pattern, key);
   case Type_Any:
-    break;
+    return true;
     switchDefault();
   }
-  return result;
 }
 
 bool EntityNodeIndexQuery::execute(
@@ -90,7 +84,7 @@ bool EntityNodeIndexQuery::execute(
   case Type_Numbered:
     return node->entity().hasNumberedProperty(m_pattern, value);
   case Type_Any:
-    return true;
+    return node->entity().hasPropertyWithPrefix("", value);
     switchDefault();
   }
 }
@@ -119,11 +113,43 @@ EntityNodeIndexQuery::EntityNodeIndexQuery(const Type type, const std::string& p
 {
 }
 
-EntityNodeIndex::EntityNodeIndex()
-  : m_keyIndex(std::make_unique<EntityNodeStringIndex>())
-  , m_valueIndex(std::make_unique<EntityNodeStringIndex>())
+namespace
+{
+template <typename K>
+void addNode(
+  std::unordered_map<K, EntityNodeCounts>& index, K indexKey, EntityNodeBase* node)
+{
+  ++index[std::move(indexKey)][node];
+}
+
+template <typename K>
+void removeNode(
+  std::unordered_map<K, EntityNodeCounts>& index, const K& indexKey, EntityNodeBase* node)
+{
+  if (const auto nodesIt = index.find(indexKey); nodesIt != index.end())
+  {
+    auto& nodes = nodesIt->second;
+    if (const auto countIt = nodes.find(node); countIt != nodes.end())
+    {
+      if (--countIt->second == 0)
+      {
+        nodes.erase(countIt);
+        if (nodes.empty())
+        {
+          index.erase(nodesIt);
+        }
+      }
+    }
+  }
+}
+
+size_t hashValue(const std::string& value)
 {
+  return std::hash<std::string>{}(value);
 }
+} // namespace
+
+EntityNodeIndex::EntityNodeIndex() = default;
 
 EntityNodeIndex::~EntityNodeIndex() = default;
 
@@ -142,31 +168,31 @@ void EntityNodeIndex::removeEntityNode(EntityNodeBase* node)
 void EntityNodeIndex::addProperty(
   EntityNodeBase* node, const std::string& key, const std::string& value)
 {
-  m_keyIndex->insert(key, node);
-  m_valueIndex->insert(value, node);
+  addNode(m_keyIndex, kdl::interned_string{key}, node);
+  addNode(m_valueIndex, hashValue(value), node);
 }
 
 void EntityNodeIndex::removeProperty(
   EntityNodeBase* node, const std::string& key, const std::string& value)
 {
-  m_keyIndex->remove(key, node);
-  m_valueIndex->remove(value, node);
+  removeNode(m_keyIndex, kdl::interned_string{key}, node);
+  removeNode(m_valueIndex, hashValue(value), node);
 }
 
 std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(
   const EntityNodeIndexQuery& keyQuery, const std::string& value) const
 {
-  // first, find Nodes which have `value` as the value for any key
-  std::vector<EntityNodeBase*> result;
-  m_valueIndex->find_matches(value, std::back_inserter(result));
-  if (result.empty())
+  // first, find Nodes which have a value with the same hash as `value` for any key
+  const auto nodesIt = m_valueIndex.find(hashValue(value));
+  if (nodesIt == m_valueIndex.end())
   {
     return {};
   }
 
-  result = kdl::vec_sort_and_remove_duplicates(std::move(result));
+  auto result = kdl::vec_sort(kdl::vec_transform(
+    nodesIt->second, [](const auto& nodeAndCount) { return nodeAndCount.first; }));
 
-  // next, remove results from the result set that don't match `keyQuery`
+  // next, remove results from the result set that don't match `keyQuery` and `value`
   auto it = std::begin(result);
   while (it != std::end(result))
   {
@@ -182,9 +208,8 @@ std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(
 
 std::vector<std::string> EntityNodeIndex::allKeys() const
 {
-  std::vector<std::string> result;
-  m_keyIndex->get_keys(std::back_inserter(result));
-  return result;
+  return kdl::vec_transform(
+    m_keyIndex, [](const auto& keyAndNodes) { return keyAndNodes.first.str(); });
 }
 
 std::vector<std::string> EntityNodeIndex::allValuesForKeys(
@@ -192,7 +217,18 @@ std::vector<std::string> EntityNodeIndex::allValuesForKeys(
 {
   std::vector<std::string> result;
 
-  const std::set<EntityNodeBase*> nameResult = keyQuery.execute(*m_keyIndex);
+  std::set<EntityNodeBase*> nameResult;
+  for (const auto& [key, nodes] : m_keyIndex)
+  {
+    if (keyQuery.matches(key.str()))
+    {
+      for (const auto& [node, count] : nodes)
+      {
+        nameResult.insert(node);
+      }
+    }
+  }
+
   for (const auto node : nameResult)
   {
     const auto matchingProperties = keyQuery.execute(node);
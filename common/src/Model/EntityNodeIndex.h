@@ -19,11 +19,11 @@
 
 #pragma once
 
-#include "kdl/compact_trie_forward.h"
+#include "kdl/interned_string.h"
 
-#include <memory>
-#include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
@@ -33,7 +33,10 @@ namespace Model
 class EntityNodeBase;
 class EntityProperty;
 
-using EntityNodeStringIndex = kdl::compact_trie<EntityNodeBase*>;
+/**
+ * Maps each node to the number of times it was added for an index key.
+ */
+using EntityNodeCounts = std::unordered_map<EntityNodeBase*, size_t>;
 
 class EntityNodeIndexQuery
 {
@@ -56,7 +59,7 @@ public:
   static EntityNodeIndexQuery numbered(const std::string& pattern);
   static EntityNodeIndexQuery any();
 
-  std::set<EntityNodeBase*> execute(const EntityNodeStringIndex& index) const;
+  bool matches(std::string_view key) const;
   bool execute(const EntityNodeBase* node, const std::string& value) const;
   std::vector<Model::EntityProperty> execute(const EntityNodeBase* node) const;
 
@@ -64,11 +67,18 @@ private:
   explicit EntityNodeIndexQuery(Type type, const std::string& pattern = "");
 };
 
+/**
+ * Indexes entity nodes by their property keys and values.
+ *
+ * The key index shares the interned property keys with the entities. The value index
+ * does not store the values at all, but only their hashes. The nodes found for a value
+ * are checked against their entities, so hash collisions do not produce wrong results.
+ */
 class EntityNodeIndex
 {
 private:
-  std::unique_ptr<EntityNodeStringIndex> m_keyIndex;
-  std::unique_ptr<EntityNodeStringIndex> m_valueIndex;
+  std::unordered_map<kdl::interned_string, EntityNodeCounts> m_keyIndex;
+  std::unordered_map<size_t, EntityNodeCounts> m_valueIndex;
 
 public:
   EntityNodeIndex();
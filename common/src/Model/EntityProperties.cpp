@@ -88,7 +88,13 @@ bool isNumberedProperty(std::string_view prefix, std::string_view key)
 
 EntityProperty::EntityProperty() = default;
 
-EntityProperty::EntityProperty(std::string key, std::string value)
+EntityProperty::EntityProperty(const std::string_view key, std::string value)
+  : m_key{key}
+  , m_value{std::move(value)}
+{
+}
+
+EntityProperty::EntityProperty(kdl::interned_string key, std::string value)
   : m_key{std::move(key)}
   , m_value{std::move(value)}
 {
@@ -101,6 +107,11 @@ const std::string& EntityProperty::key() const
   return m_key;
 }
 
+const kdl::interned_string& EntityProperty::internedKey() const
+{
+  return m_key;
+}
+
 const std::string& EntityProperty::value() const
 {
   return m_value;
@@ -108,7 +119,7 @@ const std::string& EntityProperty::value() const
 
 bool EntityProperty::hasKey(std::string_view key) const
 {
-  return kdl::cs::str_is_equal(m_key, key);
+  return kdl::cs::str_is_equal(m_key.str(), key);
 }
 
 bool EntityProperty::hasValue(const std::string_view value) const
@@ -123,7 +134,7 @@ bool EntityProperty::hasKeyAndValue(std::string_view key, std::string_view value
 
 bool EntityProperty::hasPrefix(const std::string_view prefix) const
 {
-  return kdl::cs::str_is_prefix(m_key, prefix);
+  return kdl::cs::str_is_prefix(m_key.str(), prefix);
 }
 
 bool EntityProperty::hasPrefixAndValue(
@@ -134,7 +145,7 @@ bool EntityProperty::hasPrefixAndValue(
 
 bool EntityProperty::hasNumberedPrefix(const std::string_view prefix) const
 {
-  return isNumberedProperty(prefix, m_key);
+  return isNumberedProperty(prefix, m_key.str());
 }
 
 bool EntityProperty::hasNumberedPrefixAndValue(
@@ -143,9 +154,9 @@ bool EntityProperty::hasNumberedPrefixAndValue(
   return hasNumberedPrefix(prefix) && hasValue(value);
 }
 
-void EntityProperty::setKey(std::string key)
+void EntityProperty::setKey(const std::string_view key)
 {
-  m_key = std::move(key);
+  m_key = kdl::interned_string{key};
 }
 
 void EntityProperty::setValue(std::string value)
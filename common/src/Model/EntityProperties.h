@@ -21,10 +21,12 @@
 
 #include "EL/Expression.h"
 
+#include "kdl/interned_string.h"
 #include "kdl/reflection_decl.h"
 
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace TrenchBroom::Model
@@ -97,16 +99,24 @@ bool isNumberedProperty(std::string_view prefix, std::string_view key);
 class EntityProperty
 {
 private:
-  std::string m_key;
+  // the same few keys are used by most entities of a map, so they are interned; values
+  // are mostly short enough to be stored inline by std::string
+  kdl::interned_string m_key;
   std::string m_value;
 
 public:
   EntityProperty();
-  EntityProperty(std::string key, std::string value);
+  EntityProperty(std::string_view key, std::string value);
+  EntityProperty(kdl::interned_string key, std::string value);
 
   kdl_reflect_decl(EntityProperty, m_key, m_value);
 
   const std::string& key() const;
+  /**
+   * Returns the interned key. The returned string is shared with every other property
+   * that has the same key.
+   */
+  const kdl::interned_string& internedKey() const;
   const std::string& value() const;
 
   bool hasKey(std::string_view key) const;
@@ -117,7 +127,7 @@ public:
   bool hasNumberedPrefix(std::string_view prefix) const;
   bool hasNumberedPrefixAndValue(std::string_view prefix, std::string_view value) const;
 
-  void setKey(std::string key);
+  void setKey(std::string_view key);
   void setValue(std::string value);
 };
 
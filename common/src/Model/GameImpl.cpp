@@ -37,6 +37,7 @@
 #include "IO/File.h"
 #include "IO/GameConfigParser.h"
 #include "IO/LoadEntityModel.h"
+#include "IO/MapCache.h"
 #include "IO/NodeReader.h"
 #include "IO/NodeWriter.h"
 #include "IO/ObjSerializer.h"
@@ -54,6 +55,8 @@
 #include "Model/GameConfig.h"
 #include "Model/LayerNode.h"
 #include "Model/WorldNode.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
 
 #include "kdl/overload.h"
 #include "kdl/path_utils.h"
@@ -66,6 +69,7 @@
 #include "vm/vec_io.h"
 
 #include <fstream>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -228,7 +232,10 @@ Result<std::unique_ptr<WorldNode>> GameImpl::loadMap(
   Logger& logger) const
 {
   auto parserStatus = IO::SimpleParserStatus{logger};
-  return IO::Disk::openFile(path) | kdl::transform([&](auto file) {
+  // the map and cache files are closed before this function returns, so it is safe to
+  // map them into memory
+  const auto fileMode = IO::CFileMode::MemoryMap;
+  return IO::Disk::openFile(path, fileMode) | kdl::transform([&](auto file) {
            auto fileReader = file->reader().buffer();
            if (format == MapFormat::Unknown)
            {
@@ -247,7 +254,39 @@ Result<std::unique_ptr<WorldNode>> GameImpl::loadMap(
 
            auto worldReader =
              IO::WorldReader{fileReader.stringView(), format, entityPropertyConfig()};
-           return worldReader.read(worldBounds, parserStatus);
+           if (
+             fileReader.size() < IO::MapCacheThreshold
+             || !pref(Preferences::MapCacheEnabled))
+           {
+             return worldReader.read(worldBounds, parserStatus);
+           }
+
+           const auto cachePath = IO::mapCachePath(path);
+           auto cacheFile = IO::Disk::openFile(cachePath, fileMode)
+                            | kdl::value_or(std::shared_ptr<IO::CFile>{});
+           auto cacheReader = cacheFile ? std::optional{cacheFile->reader().buffer()}
+                                        : std::nullopt;
+
+           worldReader.setCache(
+             cacheReader ? cacheReader->stringView() : std::string_view{});
+           auto worldNode = worldReader.read(worldBounds, parserStatus);
+
+           // release the cache file before overwriting it
+           cacheReader = std::nullopt;
+           cacheFile.reset();
+
+           if (const auto& updatedCache = worldReader.updatedCache())
+           {
+             IO::Disk::withOutputStream(
+               cachePath,
+               std::ios::out | std::ios::binary,
+               [&](auto& stream) { stream << *updatedCache; })
+               | kdl::transform_error([&](auto e) {
+                   logger.warn() << "Could not write map cache: " << e.msg;
+                 });
+           }
+
+           return worldNode;
          });
 }
 
@@ -0,0 +1,97 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IssueValidation.h"
+
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/Node.h"
+#include "Model/PatchNode.h"
+#include "Model/WorldNode.h"
+
+#include "kdl/overload.h"
+#include "kdl/parallel.h"
+
+#include <mutex>
+
+namespace TrenchBroom::Model
+{
+
+namespace
+{
+bool canValidateInParallel(const Node& node)
+{
+  return node.accept(kdl::overload(
+    [](const WorldNode*) { return false; },
+    [](const LayerNode*) { return false; },
+    [](const GroupNode*) { return false; },
+    [](const EntityNode*) { return true; },
+    [](const BrushNode*) { return true; },
+    [](const PatchNode*) { return true; }));
+}
+} // namespace
+
+std::vector<ValidatorStats> validateIssues(
+  const std::vector<Node*>& nodes, const std::vector<const Validator*>& validators)
+{
+  auto serialNodes = std::vector<Node*>{};
+  auto parallelNodes = std::vector<Node*>{};
+  for (auto* node : nodes)
+  {
+    if (!node->issuesValid())
+    {
+      (canValidateInParallel(*node) ? parallelNodes : serialNodes).push_back(node);
+    }
+  }
+
+  auto durations = std::vector<std::chrono::nanoseconds>(validators.size());
+  auto durationsMutex = std::mutex{};
+
+  kdl::parallel_for_chunked(
+    parallelNodes.size(), 0, [&](const size_t begin, const size_t end) {
+      auto chunkDurations = std::vector<std::chrono::nanoseconds>(validators.size());
+      for (size_t i = begin; i < end; ++i)
+      {
+        parallelNodes[i]->validateIssues(validators, &chunkDurations);
+      }
+
+      const auto lock = std::lock_guard{durationsMutex};
+      for (size_t i = 0; i < validators.size(); ++i)
+      {
+        durations[i] += chunkDurations[i];
+      }
+    });
+
+  for (auto* node : serialNodes)
+  {
+    node->validateIssues(validators, &durations);
+  }
+
+  auto result = std::vector<ValidatorStats>{};
+  result.reserve(validators.size());
+  for (size_t i = 0; i < validators.size(); ++i)
+  {
+    result.push_back({validators[i], durations[i]});
+  }
+  return result;
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,49 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+class Node;
+class Validator;
+
+struct ValidatorStats
+{
+  const Validator* validator;
+  std::chrono::nanoseconds duration;
+};
+
+/**
+ * Validates the issues of those of the given nodes whose issues are not valid.
+ *
+ * Entity, brush and patch nodes are validated in parallel. All other nodes are validated
+ * serially afterwards because validating them may compute cached values of their
+ * descendants.
+ *
+ * Returns the time spent in each of the given validators, in the order of the
+ * validators.
+ */
+std::vector<ValidatorStats> validateIssues(
+  const std::vector<Node*>& nodes, const std::vector<const Validator*>& validators);
+
+} // namespace TrenchBroom::Model
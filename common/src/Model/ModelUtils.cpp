@@ -25,10 +25,12 @@
 #include "Model/BrushFaceHandle.h"
 #include "Model/EditorContext.h"
 #include "Model/NodeQueries.h"
+#include "Model/NodeTree.h"
 #include "Polyhedron.h"
 
 #include "kdl/vector_utils.h"
 
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom::Model
@@ -171,11 +173,14 @@ std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>&
  * pair of node and brush.
  *
  * The given predicate must be a function that maps a node and a brush to true or false.
+ * Entities, brushes and patches for which the given candidate filter returns false are
+ * skipped without evaluating the predicate.
  */
-template <typename P>
+template <typename C, typename P>
 static std::vector<Node*> collectMatchingNodes(
   const std::vector<Node*>& nodes,
   const std::vector<BrushNode*>& brushes,
+  const C& isCandidate,
   const P& predicate)
 {
   auto result = std::vector<Node*>{};
@@ -211,41 +216,95 @@ static std::vector<Node*> collectMatchingNodes(
         {
           entity->visitChildren(thisLambda);
         }
-        else
+        else if (isCandidate(entity))
         {
           collectIfMatching(entity);
         }
       },
       [&](BrushNode* brush) {
         // if `brush` is one of the search query nodes, don't count it as touching
-        if (!kdl::vec_contains(brushes, brush))
+        if (isCandidate(brush) && !kdl::vec_contains(brushes, brush))
         {
           collectIfMatching(brush);
         }
       },
       [&](PatchNode* patch) {
         // if `patch` is one of the search query nodes, don't count it as touching
-        collectIfMatching(patch);
+        if (isCandidate(patch))
+        {
+          collectIfMatching(patch);
+        }
       }));
   }
 
   return result;
 }
 
+/**
+ * Returns the entities, brushes and patches in the node tree of the given world whose
+ * bounds might intersect with the bounds of any of the given brushes. The node tree is
+ * traversed only once for all brushes.
+ */
+static std::unordered_set<const Node*> findCandidateNodes(
+  const WorldNode& worldNode, const std::vector<BrushNode*>& brushes)
+{
+  const auto bounds = kdl::vec_transform(
+    brushes, [](const auto* brush) { return brush->physicalBounds(); });
+
+  auto result = std::unordered_set<const Node*>{};
+  for (const auto& [brushIndex, node] : worldNode.nodeTree().find_intersectors(bounds))
+  {
+    result.insert(node);
+  }
+  return result;
+}
+
+static auto isAnyNode()
+{
+  return [](const Node*) { return true; };
+}
+
+static auto isCandidateNode(const std::unordered_set<const Node*>& candidates)
+{
+  return [&](const Node* node) { return candidates.contains(node); };
+}
+
+static auto isTouching()
+{
+  return [](const auto* node, const auto* brush) { return brush->intersects(node); };
+}
+
+static auto isContained()
+{
+  return [](const auto* node, const auto* brush) { return brush->contains(node); };
+}
+
 std::vector<Node*> collectTouchingNodes(
   const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes)
 {
-  return collectMatchingNodes(nodes, brushes, [](const auto* node, const auto* brush) {
-    return brush->intersects(node);
-  });
+  return collectMatchingNodes(nodes, brushes, isAnyNode(), isTouching());
+}
+
+std::vector<Node*> collectTouchingNodes(
+  WorldNode& worldNode, const std::vector<BrushNode*>& brushes)
+{
+  const auto candidates = findCandidateNodes(worldNode, brushes);
+  return collectMatchingNodes(
+    {&worldNode}, brushes, isCandidateNode(candidates), isTouching());
 }
 
 std::vector<Node*> collectContainedNodes(
   const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes)
 {
-  return collectMatchingNodes(nodes, brushes, [](const auto* node, const auto* brush) {
-    return brush->contains(node);
-  });
+  return collectMatchingNodes(nodes, brushes, isAnyNode(), isContained());
+}
+
+std::vector<Node*> collectContainedNodes(
+  WorldNode& worldNode, const std::vector<BrushNode*>& brushes)
+{
+  const auto candidates = findCandidateNodes(worldNode, brushes);
+  return collectMatchingNodes(
+    {&worldNode}, brushes, isCandidateNode(candidates), isContained());
 }
 
 std::vector<Node*> collectSelectedNodes(const std::vector<Node*>& nodes)
@@ -37,6 +37,7 @@ class GroupNode;
 class BrushNode;
 class EntityNode;
 class LayerNode;
+class WorldNode;
 class EditorContext;
 
 HitType::Type nodeHitType();
@@ -65,6 +66,15 @@ std::vector<Node*> collectTouchingNodes(
 std::vector<Node*> collectContainedNodes(
   const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes);
 
+/**
+ * Like the functions above, but only evaluates the entities, brushes and patches found in
+ * the node tree of the given world that might intersect with the given brushes.
+ */
+std::vector<Node*> collectTouchingNodes(
+  WorldNode& worldNode, const std::vector<BrushNode*>& brushes);
+std::vector<Node*> collectContainedNodes(
+  WorldNode& worldNode, const std::vector<BrushNode*>& brushes);
+
 std::vector<Node*> collectSelectedNodes(const std::vector<Node*>& nodes);
 
 std::vector<Node*> collectSelectableNodes(
@@ -830,13 +830,31 @@ void Node::setIssueHidden(const IssueType type, const bool hidden)
   }
 }
 
-void Node::validateIssues(const std::vector<const Validator*>& validators)
+bool Node::issuesValid() const
+{
+  return m_issuesValid;
+}
+
+void Node::validateIssues(
+  const std::vector<const Validator*>& validators,
+  std::vector<std::chrono::nanoseconds>* durations)
 {
   if (!m_issuesValid)
   {
-    for (const auto* validator : validators)
+    assert(durations == nullptr || durations->size() == validators.size());
+
+    for (size_t i = 0; i < validators.size(); ++i)
     {
-      validator->validate(*this, m_issues);
+      if (durations)
+      {
+        const auto start = std::chrono::steady_clock::now();
+        validators[i]->validate(*this, m_issues);
+        (*durations)[i] += std::chrono::steady_clock::now() - start;
+      }
+      else
+      {
+        validators[i]->validate(*this, m_issues);
+      }
     }
     m_issuesValid = true;
   }
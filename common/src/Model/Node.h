@@ -32,6 +32,7 @@
 #include "vm/util.h"
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -354,12 +355,21 @@ public: // issue management
   bool issueHidden(IssueType type) const;
   void setIssueHidden(IssueType type, bool hidden);
 
+  bool issuesValid() const;
+
+  /**
+   * Runs the given validators on this node unless its issues are still valid.
+   *
+   * If durations is not null, then the time spent in each validator is added to the
+   * element of durations with the same index as the validator.
+   */
+  void validateIssues(
+    const std::vector<const Validator*>& validators,
+    std::vector<std::chrono::nanoseconds>* durations = nullptr);
+
 public: // should only be called from this and from the world
   void invalidateIssues() const;
 
-private:
-  void validateIssues(const std::vector<const Validator*>& validators);
-
 public: // visitors
   /**
    * Visit this node with the given lambda and return the lambda's return value or nothing
@@ -20,9 +20,15 @@
 #include "NodeContents.h"
 
 #include "Model/BrushFace.h"
+#include "Model/BrushGeometry.h"
+#include "Model/ParallelUVCoordSystem.h"
+#include "Model/ParaxialUVCoordSystem.h"
+#include "Model/Polyhedron.h"
 
 #include "kdl/overload.h"
 
+#include <algorithm>
+
 namespace TrenchBroom
 {
 namespace Model
@@ -55,5 +61,44 @@ std::variant<Layer, Group, Entity, Brush, BezierPatch>& NodeContents::get()
 {
   return m_contents;
 }
+
+size_t NodeContents::memoryUsage() const
+{
+  const auto contentsMemoryUsage = std::visit(
+    kdl::overload(
+      [](const Layer& layer) { return layer.name().capacity(); },
+      [](const Group& group) { return group.name().capacity(); },
+      [](const Entity& entity) {
+        auto result = entity.properties().capacity() * sizeof(EntityProperty);
+        for (const auto& property : entity.properties())
+        {
+          result += property.key().capacity() + property.value().capacity();
+        }
+        return result;
+      },
+      [](const Brush& brush) {
+        // material names are interned and therefore not counted
+        constexpr auto uvCoordSystemSize =
+          std::max(sizeof(ParallelUVCoordSystem), sizeof(ParaxialUVCoordSystem));
+
+        auto result = brush.faces().capacity() * sizeof(BrushFace)
+                      + brush.faceCount() * uvCoordSystemSize;
+        if (brush.hasGeometry())
+        {
+          const auto edgeSize = sizeof(BrushEdge) + 2 * sizeof(BrushHalfEdge);
+          result += sizeof(BrushGeometry) + brush.vertexCount() * sizeof(BrushVertex)
+                    + brush.edgeCount() * edgeSize
+                    + brush.faceCount() * sizeof(BrushFaceGeometry);
+        }
+        return result;
+      },
+      [](const BezierPatch& patch) {
+        return patch.controlPoints().capacity() * sizeof(BezierPatch::Point)
+               + patch.materialName().capacity();
+      }),
+    m_contents);
+
+  return sizeof(NodeContents) + contentsMemoryUsage;
+}
 } // namespace Model
 } // namespace TrenchBroom
@@ -45,6 +45,11 @@ public:
 
   const std::variant<Layer, Group, Entity, Brush, BezierPatch>& get() const;
   std::variant<Layer, Group, Entity, Brush, BezierPatch>& get();
+
+  /**
+   * Returns an estimate of the number of bytes of memory held by these contents.
+   */
+  size_t memoryUsage() const;
 };
 } // namespace Model
 } // namespace TrenchBroom
@@ -0,0 +1,141 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NodeTree.h"
+
+#include "Macros.h"
+#include "Model/Node.h"
+
+#include "kdl/overload.h"
+#include "kdl/vector_utils.h"
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+auto makeTree(const NodeTreeType type)
+{
+  using Tree = std::variant<octree<FloatType, Node*>, bvh<FloatType, Node*>>;
+  switch (type)
+  {
+  case NodeTreeType::Octree:
+    return Tree{std::in_place_index<0>, 256.0};
+  case NodeTreeType::Bvh:
+    return Tree{std::in_place_index<1>};
+    switchDefault();
+  }
+}
+} // namespace
+
+NodeTree::NodeTree(const NodeTreeType type)
+  : m_tree{makeTree(type)}
+{
+}
+
+NodeTreeType NodeTree::type() const
+{
+  return std::visit(
+    kdl::overload(
+      [](const octree<FloatType, Node*>&) { return NodeTreeType::Octree; },
+      [](const bvh<FloatType, Node*>&) { return NodeTreeType::Bvh; }),
+    m_tree);
+}
+
+bool NodeTree::contains(Node* node) const
+{
+  return std::visit([&](const auto& tree) { return tree.contains(node); }, m_tree);
+}
+
+void NodeTree::insert(const vm::bbox3& bounds, Node* node)
+{
+  std::visit([&](auto& tree) { tree.insert(bounds, node); }, m_tree);
+}
+
+bool NodeTree::remove(Node* node)
+{
+  return std::visit([&](auto& tree) { return tree.remove(node); }, m_tree);
+}
+
+void NodeTree::update(const vm::bbox3& newBounds, Node* node)
+{
+  std::visit([&](auto& tree) { tree.update(newBounds, node); }, m_tree);
+}
+
+void NodeTree::build(const std::vector<Node*>& nodes)
+{
+  std::visit(
+    kdl::overload(
+      [&](octree<FloatType, Node*>& tree) {
+        tree.clear();
+        for (auto* node : nodes)
+        {
+          tree.insert(node->physicalBounds(), node);
+        }
+      },
+      [&](bvh<FloatType, Node*>& tree) {
+        tree.build(kdl::vec_transform(nodes, [](auto* node) {
+          return std::pair{node->physicalBounds(), node};
+        }));
+      }),
+    m_tree);
+}
+
+void NodeTree::clear()
+{
+  std::visit([](auto& tree) { tree.clear(); }, m_tree);
+}
+
+bool NodeTree::empty() const
+{
+  return std::visit([](const auto& tree) { return tree.empty(); }, m_tree);
+}
+
+std::vector<Node*> NodeTree::find_intersectors(const vm::ray3& ray) const
+{
+  return std::visit(
+    [&](const auto& tree) { return tree.find_intersectors(ray); }, m_tree);
+}
+
+std::vector<std::pair<size_t, Node*>> NodeTree::find_intersectors(
+  const std::vector<vm::ray3>& rays) const
+{
+  return std::visit(
+    [&](const auto& tree) { return tree.find_intersectors(rays); }, m_tree);
+}
+
+std::vector<Node*> NodeTree::find_intersectors(const vm::bbox3& bbox) const
+{
+  return std::visit(
+    [&](const auto& tree) { return tree.find_intersectors(bbox); }, m_tree);
+}
+
+std::vector<std::pair<size_t, Node*>> NodeTree::find_intersectors(
+  const std::vector<vm::bbox3>& bboxes) const
+{
+  return std::visit(
+    [&](const auto& tree) { return tree.find_intersectors(bboxes); }, m_tree);
+}
+
+std::vector<Node*> NodeTree::find_containers(const vm::vec3& point) const
+{
+  return std::visit(
+    [&](const auto& tree) { return tree.find_containers(point); }, m_tree);
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,97 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+#include "Model/NodeTreeType.h"
+#include "bvh.h"
+#include "octree.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+class Node;
+
+/**
+ * The spatial index of a world. Depending on its type, the nodes are stored in an octree
+ * or in a bounding volume hierarchy. The queries may return nodes whose bounds do not
+ * match the query, so the callers must test the returned nodes themselves.
+ */
+class NodeTree
+{
+private:
+  std::variant<octree<FloatType, Node*>, bvh<FloatType, Node*>> m_tree;
+
+public:
+  explicit NodeTree(NodeTreeType type);
+
+  NodeTreeType type() const;
+
+  bool contains(Node* node) const;
+
+  /**
+   * @throws NodeTreeException if the given bounds are invalid or if the given node is
+   * already in this tree
+   */
+  void insert(const vm::bbox3& bounds, Node* node);
+  bool remove(Node* node);
+
+  /**
+   * @throws NodeTreeException if the given node is not in this tree
+   */
+  void update(const vm::bbox3& newBounds, Node* node);
+
+  /**
+   * Replaces the contents of this tree with the given nodes. A bounding volume hierarchy
+   * is built top down, which results in a better tree than inserting the nodes one by
+   * one.
+   *
+   * @throws NodeTreeException if the bounds of any of the given nodes are invalid or if
+   * any node occurs more than once
+   */
+  void build(const std::vector<Node*>& nodes);
+
+  void clear();
+  bool empty() const;
+
+  std::vector<Node*> find_intersectors(const vm::ray3& ray) const;
+  std::vector<std::pair<size_t, Node*>> find_intersectors(
+    const std::vector<vm::ray3>& rays) const;
+  std::vector<Node*> find_intersectors(const vm::bbox3& bbox) const;
+  std::vector<std::pair<size_t, Node*>> find_intersectors(
+    const std::vector<vm::bbox3>& bboxes) const;
+  std::vector<Node*> find_containers(const vm::vec3& point) const;
+
+  template <typename P>
+  std::vector<Node*> find_candidates(const P& predicate) const
+  {
+    return std::visit(
+      [&](const auto& tree) { return tree.find_candidates(predicate); }, m_tree);
+  }
+};
+
+} // namespace TrenchBroom::Model
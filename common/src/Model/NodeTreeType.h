@@ -0,0 +1,36 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace TrenchBroom::Model
+{
+enum class NodeTreeType
+{
+  /**
+   * An octree with fixed cells, see octree.
+   */
+  Octree,
+  /**
+   * A bounding volume hierarchy whose nodes adapt to the bounds of the world's nodes, see
+   * bvh.
+   */
+  Bvh,
+};
+} // namespace TrenchBroom::Model
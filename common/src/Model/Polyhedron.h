@@ -30,6 +30,7 @@
 #include "vm/util.h"
 #include "vm/vec.h"
 
+#include <cstddef>
 #include <initializer_list>
 #include <limits>
 #include <optional>
@@ -112,6 +113,13 @@ private:
    */
   explicit Polyhedron_Vertex(const vm::vec<T, 3>& position);
 
+public:
+  /**
+   * The vertices of all polyhedra are allocated from a shared pool of memory blocks.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
 public:
   /**
    * Returns the position of this vertex.
@@ -259,6 +267,13 @@ private:
    */
   Polyhedron_Edge(HalfEdge* first, HalfEdge* second = nullptr);
 
+public:
+  /**
+   * The edges of all polyhedra are allocated from a shared pool of memory blocks.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
 public:
   /**
    * Returns the origin of the first half edge.
@@ -576,6 +591,13 @@ private:
    */
   Polyhedron_HalfEdge(Vertex* origin);
 
+public:
+  /**
+   * The half edges of all polyhedra are allocated from a shared pool of memory blocks.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
 public:
   /**
    * Returns the origin vertex of this half edge.
@@ -802,6 +824,13 @@ private:
    */
   explicit Polyhedron_Face(HalfEdgeList&& boundary, const vm::plane<T, 3>& plane);
 
+public:
+  /**
+   * The faces of all polyhedra are allocated from a shared pool of memory blocks.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
 public:
   /**
    * Returns the circular list of half edges that make up the boundary of this face.
@@ -1109,7 +1138,9 @@ public:
   using FacePayloadType = FP;
   using VertexPayloadType = VP;
 
-private:
+  /**
+   * Edges shorter than this are removed when healing edges.
+   */
   static constexpr const auto MinEdgeLength = T(0.01);
 
 public:
@@ -1231,6 +1262,17 @@ public: // Constructors
    */
   Polyhedron(Polyhedron<T, FP, VP>&& other) noexcept;
 
+  /**
+   * Constructs a polyhedron that corresponds to the convex hull of the given points by
+   * adding the points one by one. This is slower than the constructor, which adds the
+   * points in rounds (see addPointsToEmptyPolyhedron()), and is only used to check and
+   * benchmark the constructor against it.
+   *
+   * @param positions the points from which the convex hull is computed
+   */
+  static Polyhedron<T, FP, VP> incrementalConvexHull(
+    std::vector<vm::vec<T, 3>> positions);
+
 public: // copy and move assignment
   /**
    * Copy assignment operator.
@@ -1669,6 +1711,24 @@ private:
    */
   void mergeIncidentEdges(Vertex* vertex);
 
+public: // Transformation
+  /**
+   * Applies the given affine transformation to the positions of all vertices and to the
+   * planes of all faces, retaining the topology of this polyhedron.
+   *
+   * The transformation must preserve orientation, i.e., the determinant of its linear
+   * part must be positive, because otherwise the boundaries of the faces would have to
+   * be reversed.
+   *
+   * Updates the bounds of this polyhedron afterwards.
+   *
+   * @param transformation the transformation to apply
+   * @return true if the transformation was applied and false if it is not an invertible,
+   * orientation preserving affine transformation, in which case this polyhedron remains
+   * unchanged
+   */
+  bool transform(const vm::mat<T, 4, 4>& transformation);
+
 public:
   /**
    * Exports to .obj format for debugging.
@@ -1687,14 +1747,30 @@ private: // Convex hull; adding and removing points
    * polyhedron is that the resulting polyhedron is the convex hull of the union of the
    * polyhedron's vertices and the given points.
    *
-   * Duplicates in the given vector are discarded. Furthermore, the remaining points are
-   * sorted in descending order of their distance from the center of their bounding box.
-   * Therefore, the result of calling this method is different from the result of
-   * repeatedly calling addPoint() for every point in the given vector.
+   * Duplicates in the given vector are discarded. If this polyhedron is empty, the
+   * points are added in rounds, see addPointsToEmptyPolyhedron(). Therefore, the result
+   * of calling this method is different from the result of repeatedly calling addPoint()
+   * for every point in the given vector.
    *
    * @param points the points to add to this polyhedron
    */
   void addPoints(std::vector<vm::vec<T, 3>> points);
+  /**
+   * Builds the convex hull of the given points in this polyhedron, which must be empty.
+   *
+   * This polyhedron is initialized with a tetrahedron spanned by four extreme points.
+   * Then, in every round, each remaining point is assigned to the face it is farthest
+   * above, and the farthest point of every face is added. Points that are below every
+   * face are discarded. Like quickhull, this adds the points that are likely to be on the
+   * convex hull first, so most of the other points are discarded without ever modifying
+   * this polyhedron. Every point is added using addPoint(), so the same plane epsilon
+   * applies as when adding the points one by one. Nearly coplanar points are added one
+   * by one.
+   *
+   * @param points the points to add, must not contain duplicates
+   * @param planeEpsilon the plane epsilon to use for point status checks
+   */
+  void addPointsToEmptyPolyhedron(std::vector<vm::vec<T, 3>> points, T planeEpsilon);
   /**
    * Adds the given point to this polyhedron. The effect of adding the given point to a
    * polyhedron is that the resulting polyhedron is the convex hull of the union of the
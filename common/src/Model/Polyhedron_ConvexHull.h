@@ -30,7 +30,12 @@
 #include "vm/segment.h"
 #include "vm/util.h"
 
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <iterator>
 #include <list>
+#include <optional>
 #include <unordered_set>
 #include <vector>
 
@@ -51,6 +56,80 @@ static T computePlaneEpsilon(const std::vector<vm::vec<T, 3>>& points)
   return std::max(computedEpsilon, defaultEpsilon);
 }
 
+/**
+ * Returns the indices of four points that span a tetrahedron which is as large as
+ * possible: the two axis aligned extreme points that are farthest apart, the point that
+ * is farthest from the line through these, and the point that is farthest from the plane
+ * through the first three points. Returns nothing if the tetrahedron is not thicker than
+ * the given value, i.e. if the points are (nearly) coplanar.
+ */
+template <typename T>
+static std::optional<std::array<size_t, 4>> selectInitialSimplex(
+  const std::vector<vm::vec<T, 3>>& points, const T minThickness)
+{
+  assert(!points.empty());
+
+  auto extremes = std::vector<size_t>{};
+  for (size_t axis = 0; axis < 3; ++axis)
+  {
+    const auto [min, max] = std::minmax_element(
+      std::begin(points), std::end(points), [&](const auto& lhs, const auto& rhs) {
+        return lhs[axis] < rhs[axis];
+      });
+    extremes.push_back(size_t(std::distance(std::begin(points), min)));
+    extremes.push_back(size_t(std::distance(std::begin(points), max)));
+  }
+
+  auto i0 = extremes[0], i1 = extremes[1];
+  for (const auto i : extremes)
+  {
+    for (const auto j : extremes)
+    {
+      if (
+        vm::squared_distance(points[i], points[j])
+        > vm::squared_distance(points[i0], points[i1]))
+      {
+        i0 = i;
+        i1 = j;
+      }
+    }
+  }
+
+  const auto findFarthest = [&](const auto& distance) {
+    auto result = i0;
+    auto maxDistance = T(0);
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      if (const auto d = distance(points[i]); d > maxDistance)
+      {
+        result = i;
+        maxDistance = d;
+      }
+    }
+    return std::pair{result, maxDistance};
+  };
+
+  const auto direction = points[i1] - points[i0];
+  const auto [i2, lineDistance] = findFarthest([&](const auto& point) {
+    return vm::squared_length(vm::cross(point - points[i0], direction));
+  });
+  if (lineDistance == T(0))
+  {
+    return std::nullopt;
+  }
+
+  const auto normal = vm::normalize(vm::cross(direction, points[i2] - points[i0]));
+  const auto [i3, planeDistance] = findFarthest([&](const auto& point) {
+    return vm::abs(vm::dot(point - points[i0], normal));
+  });
+  if (planeDistance <= minThickness)
+  {
+    return std::nullopt;
+  }
+
+  return std::array<size_t, 4>{i0, i1, i2, i3};
+}
+
 template <typename T, typename FP, typename VP>
 void Polyhedron<T, FP, VP>::addPoints(std::vector<vm::vec<T, 3>> points)
 {
@@ -59,10 +138,141 @@ void Polyhedron<T, FP, VP>::addPoints(std::vector<vm::vec<T, 3>> points)
     points = kdl::vec_sort_and_remove_duplicates(std::move(points));
 
     const auto planeEpsilon = computePlaneEpsilon(points);
+    if (empty())
+    {
+      addPointsToEmptyPolyhedron(std::move(points), planeEpsilon);
+    }
+    else
+    {
+      for (const auto& point : points)
+      {
+        addPoint(point, planeEpsilon);
+      }
+    }
+  }
+}
+
+template <typename T, typename FP, typename VP>
+Polyhedron<T, FP, VP> Polyhedron<T, FP, VP>::incrementalConvexHull(
+  std::vector<vm::vec<T, 3>> positions)
+{
+  auto result = Polyhedron<T, FP, VP>{};
+  if (!positions.empty())
+  {
+    positions = kdl::vec_sort_and_remove_duplicates(std::move(positions));
+
+    const auto planeEpsilon = computePlaneEpsilon(positions);
+    for (const auto& position : positions)
+    {
+      result.addPoint(position, planeEpsilon);
+    }
+  }
+  return result;
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron<T, FP, VP>::addPointsToEmptyPolyhedron(
+  std::vector<vm::vec<T, 3>> points, const T planeEpsilon)
+{
+  assert(empty());
+
+  auto simplex = selectInitialSimplex(points, 2 * planeEpsilon);
+  if (!simplex)
+  {
+    // Nearly coplanar points are added one by one so that coplanar faces are merged as
+    // the points are added.
     for (const auto& point : points)
     {
       addPoint(point, planeEpsilon);
     }
+    return;
+  }
+
+  for (const auto i : *simplex)
+  {
+    addPoint(points[i], planeEpsilon);
+  }
+
+  std::sort(std::begin(*simplex), std::end(*simplex), std::greater<size_t>{});
+  for (const auto i : *simplex)
+  {
+    points.erase(std::next(std::begin(points), std::ptrdiff_t(i)));
+  }
+
+  struct OutsidePoint
+  {
+    vm::vec<T, 3> position;
+    size_t faceIndex;
+    T distance;
+  };
+
+  auto faces = std::vector<const Face*>{};
+  auto outsidePoints = std::vector<OutsidePoint>{};
+  auto farthestPoints = std::vector<OutsidePoint>{};
+  while (!points.empty())
+  {
+    faces.clear();
+    for (const Face* face : m_faces)
+    {
+      faces.push_back(face);
+    }
+
+    // Find the face that each point is farthest above. A point that is below every face
+    // is inside of this polyhedron and is discarded, just like addPoint would.
+    outsidePoints.clear();
+    for (const auto& position : points)
+    {
+      auto outsidePoint = std::optional<OutsidePoint>{};
+      for (size_t i = 0; i < faces.size(); ++i)
+      {
+        const auto distance = faces[i]->plane().point_distance(position);
+        if (
+          distance >= -planeEpsilon
+          && (!outsidePoint || distance > outsidePoint->distance))
+        {
+          outsidePoint = OutsidePoint{position, i, distance};
+        }
+      }
+
+      if (outsidePoint)
+      {
+        outsidePoints.push_back(*outsidePoint);
+      }
+    }
+
+    std::stable_sort(
+      std::begin(outsidePoints),
+      std::end(outsidePoints),
+      [](const auto& lhs, const auto& rhs) {
+        return lhs.faceIndex < rhs.faceIndex
+               || (lhs.faceIndex == rhs.faceIndex && lhs.distance > rhs.distance);
+      });
+
+    // Add the point that is farthest above each face, and keep the others for the next
+    // round. Many of them will be inside of this polyhedron by then.
+    points.clear();
+    farthestPoints.clear();
+    for (size_t i = 0; i < outsidePoints.size(); ++i)
+    {
+      if (i == 0 || outsidePoints[i].faceIndex != outsidePoints[i - 1].faceIndex)
+      {
+        farthestPoints.push_back(outsidePoints[i]);
+      }
+      else
+      {
+        points.push_back(outsidePoints[i].position);
+      }
+    }
+
+    std::stable_sort(
+      std::begin(farthestPoints),
+      std::end(farthestPoints),
+      [](const auto& lhs, const auto& rhs) { return lhs.distance > rhs.distance; });
+
+    for (const auto& farthestPoint : farthestPoints)
+    {
+      addPoint(farthestPoint.position, planeEpsilon);
+    }
   }
 }
 
@@ -75,7 +285,7 @@ typename Polyhedron<T, FP, VP>::Vertex* Polyhedron<T, FP, VP>::addPoint(
   // quick test to discard vertices which would yield short edges
   for (const Vertex* v : m_vertices)
   {
-    if (vm::distance(position, v->position()) < MinEdgeLength)
+    if (vm::squared_distance(position, v->position()) < MinEdgeLength * MinEdgeLength)
     {
       return nullptr;
     }
@@ -22,6 +22,7 @@
 #include "Macros.h"
 #include "Polyhedron.h"
 
+#include "kdl/object_pool.h"
 #include "kdl/optional_utils.h"
 
 #include "vm/constants.h"
@@ -56,6 +57,20 @@ const kdl::intrusive_circular_link<Polyhedron_Face<T, FP, VP>>& Polyhedron_GetFa
   return face->m_link;
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Face<T, FP, VP>::operator new(const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_Face));
+  unused(size);
+  return kdl::object_pool<Polyhedron_Face>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Face<T, FP, VP>::operator delete(void* ptr) noexcept
+{
+  kdl::object_pool<Polyhedron_Face>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 Polyhedron_Face<T, FP, VP>::Polyhedron_Face(
   HalfEdgeList&& boundary, const vm::plane<T, 3>& plane)
@@ -19,8 +19,11 @@
 
 #pragma once
 
+#include "Macros.h"
 #include "Polyhedron.h"
 
+#include "kdl/object_pool.h"
+
 namespace TrenchBroom
 {
 namespace Model
@@ -42,6 +45,20 @@ Polyhedron_GetHalfEdgeLink<T, FP, VP>::operator()(
   return halfEdge->m_link;
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_HalfEdge<T, FP, VP>::operator new(const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_HalfEdge));
+  unused(size);
+  return kdl::object_pool<Polyhedron_HalfEdge>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_HalfEdge<T, FP, VP>::operator delete(void* ptr) noexcept
+{
+  kdl::object_pool<Polyhedron_HalfEdge>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 Polyhedron_HalfEdge<T, FP, VP>::Polyhedron_HalfEdge(Vertex* origin)
   : m_origin(origin)
@@ -24,6 +24,8 @@
 #include "kdl/vector_utils.h"
 
 #include "vm/bbox.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
 #include "vm/plane.h"
 #include "vm/ray.h"
 #include "vm/scalar.h"
@@ -801,6 +803,47 @@ void Polyhedron<T, FP, VP>::updateBounds()
   }
 }
 
+template <typename T, typename FP, typename VP>
+bool Polyhedron<T, FP, VP>::transform(const vm::mat<T, 4, 4>& transformation)
+{
+  if (
+    transformation[0][3] != T(0) || transformation[1][3] != T(0)
+    || transformation[2][3] != T(0) || transformation[3][3] != T(1))
+  {
+    return false;
+  }
+
+  const auto linear = vm::strip_translation(transformation);
+  if (vm::compute_determinant(linear) <= T(0))
+  {
+    return false;
+  }
+
+  const auto inverse = vm::invert(linear);
+  if (!inverse)
+  {
+    return false;
+  }
+
+  // normals must be transformed by the inverse transpose to remain perpendicular to
+  // their faces if the transformation scales non-uniformly or shears
+  const auto normalTransformation = vm::transpose(*inverse);
+
+  for (auto* vertex : m_vertices)
+  {
+    vertex->setPosition(transformation * vertex->position());
+  }
+
+  for (auto* face : m_faces)
+  {
+    const auto normal = vm::normalize(normalTransformation * face->m_plane.normal);
+    face->m_plane = vm::plane<T, 3>{transformation * face->m_plane.anchor(), normal};
+  }
+
+  updateBounds();
+  return true;
+}
+
 template <typename T, typename FP, typename VP>
 void Polyhedron<T, FP, VP>::correctVertexPositions(const size_t decimals, const T epsilon)
 {
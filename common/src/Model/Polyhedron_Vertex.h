@@ -19,9 +19,11 @@
 
 #pragma once
 
+#include "Macros.h"
 #include "Polyhedron.h"
 
 #include "kdl/intrusive_circular_list.h"
+#include "kdl/object_pool.h"
 
 namespace TrenchBroom
 {
@@ -44,6 +46,20 @@ Polyhedron_GetVertexLink<T, FP, VP>::operator()(
   return vertex->m_link;
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Vertex<T, FP, VP>::operator new(const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_Vertex));
+  unused(size);
+  return kdl::object_pool<Polyhedron_Vertex>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Vertex<T, FP, VP>::operator delete(void* ptr) noexcept
+{
+  kdl::object_pool<Polyhedron_Vertex>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 Polyhedron_Vertex<T, FP, VP>::Polyhedron_Vertex(const vm::vec<T, 3>& position)
   : m_position(position)
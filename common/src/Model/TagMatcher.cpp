@@ -171,7 +171,7 @@ std::unique_ptr<TagMatcher> MaterialNameTagMatcher::clone() const
 bool MaterialNameTagMatcher::matches(const Taggable& taggable) const
 {
   auto visitor = BrushFaceMatchVisitor{[&](const auto& face) {
-    return matchesMaterialName(face.attributes().materialName());
+    return matchesMaterialName(face.attributes().internedMaterialName());
   }};
 
   taggable.accept(visitor);
@@ -189,6 +189,19 @@ bool MaterialNameTagMatcher::matchesMaterial(const Assets::Material* material) c
   return material && matchesMaterialName(material->name());
 }
 
+bool MaterialNameTagMatcher::matchesMaterialName(
+  const kdl::interned_string& materialName) const
+{
+  auto lock = std::lock_guard{m_matchesByNameMutex};
+  auto it = m_matchesByName.find(materialName);
+  if (it == m_matchesByName.end())
+  {
+    const auto matches = matchesMaterialName(std::string_view{materialName.str()});
+    it = m_matchesByName.emplace(materialName, matches).first;
+  }
+  return it->second;
+}
+
 bool MaterialNameTagMatcher::matchesMaterialName(std::string_view materialName) const
 {
   // If the match pattern doesn't contain a slash, match against
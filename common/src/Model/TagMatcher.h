@@ -23,14 +23,17 @@
 #include "Model/Tag.h"
 #include "Model/TagVisitor.h"
 
+#include "kdl/interned_string.h"
 #include "kdl/reflection_decl.h"
 #include "kdl/vector_set.h"
 
 #include <functional>
 #include <iosfwd>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom::Model
@@ -56,6 +59,10 @@ class MaterialNameTagMatcher : public MaterialTagMatcher
 {
 private:
   std::string m_pattern;
+  // many faces share the same material name, so the results of matching the pattern are
+  // cached by interned name
+  mutable std::unordered_map<kdl::interned_string, bool> m_matchesByName;
+  mutable std::mutex m_matchesByNameMutex;
 
 public:
   explicit MaterialNameTagMatcher(std::string pattern);
@@ -65,6 +72,7 @@ public:
 
 private:
   bool matchesMaterial(const Assets::Material* material) const override;
+  bool matchesMaterialName(const kdl::interned_string& materialName) const;
   bool matchesMaterialName(std::string_view materialName) const;
 };
 
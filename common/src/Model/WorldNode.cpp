@@ -26,11 +26,12 @@
 #include "Model/EntityNodeIndex.h"
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
+#include "Model/NodeTree.h"
 #include "Model/PatchNode.h"
+#include "Model/PickResult.h"
 #include "Model/TagVisitor.h"
 #include "Model/Validator.h"
 #include "Model/ValidatorRegistry.h"
-#include "octree.h"
 
 #include "kdl/overload.h"
 #include "kdl/result.h"
@@ -38,6 +39,7 @@
 
 #include "vm/bbox_io.h"
 
+#include <cassert>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -53,7 +55,7 @@ WorldNode::WorldNode(
   , m_defaultLayer{nullptr}
   , m_entityNodeIndex{std::make_unique<EntityNodeIndex>()}
   , m_validatorRegistry{std::make_unique<ValidatorRegistry>()}
-  , m_nodeTree{std::make_unique<NodeTree>(256.0)}
+  , m_nodeTree{std::make_unique<NodeTree>(NodeTreeType::Octree)}
   , m_updateNodeTree{true}
 {
   entity.addOrUpdateProperty(
@@ -83,7 +85,7 @@ MapFormat WorldNode::mapFormat() const
   return m_mapFormat;
 }
 
-const WorldNode::NodeTree& WorldNode::nodeTree() const
+const NodeTree& WorldNode::nodeTree() const
 {
   return *m_nodeTree;
 }
@@ -205,6 +207,19 @@ void WorldNode::unregisterAllValidators()
   invalidateAllIssues();
 }
 
+void WorldNode::pick(
+  const EditorContext& editorContext,
+  const std::vector<vm::ray3>& rays,
+  std::vector<PickResult>& pickResults)
+{
+  assert(rays.size() == pickResults.size());
+
+  for (const auto& [rayIndex, node] : m_nodeTree->find_intersectors(rays))
+  {
+    node->pick(editorContext, rays[rayIndex], pickResults[rayIndex]);
+  }
+}
+
 void WorldNode::disableNodeTreeUpdates()
 {
   m_updateNodeTree = false;
@@ -245,10 +260,20 @@ void WorldNode::rebuildNodeTree()
     [&](BrushNode* brush) { addNode(brush); },
     [&](PatchNode* patch) { addNode(patch); }));
 
-  m_nodeTree->clear();
-  for (auto* node : nodes)
+  m_nodeTree->build(nodes);
+}
+
+NodeTreeType WorldNode::nodeTreeType() const
+{
+  return m_nodeTree->type();
+}
+
+void WorldNode::setNodeTreeType(const NodeTreeType nodeTreeType)
+{
+  if (nodeTreeType != m_nodeTree->type())
   {
-    m_nodeTree->insert(node->physicalBounds(), node);
+    *m_nodeTree = NodeTree{nodeTreeType};
+    rebuildNodeTree();
   }
 }
 
@@ -35,14 +35,13 @@
 
 namespace TrenchBroom
 {
-template <typename T, typename U>
-class octree;
-
 namespace Model
 {
 class EntityNodeIndex;
 class IssueQuickFix;
 enum class MapFormat;
+class NodeTree;
+enum class NodeTreeType;
 class PickResult;
 class Validator;
 class ValidatorRegistry;
@@ -56,7 +55,6 @@ private:
   std::unique_ptr<EntityNodeIndex> m_entityNodeIndex;
   std::unique_ptr<ValidatorRegistry> m_validatorRegistry;
 
-  using NodeTree = octree<FloatType, Node*>;
   std::unique_ptr<NodeTree> m_nodeTree;
   bool m_updateNodeTree;
 
@@ -137,11 +135,34 @@ public: // validator registration
   void registerValidator(std::unique_ptr<Validator> validator);
   void unregisterAllValidators();
 
+public: // picking
+  using Node::pick;
+
+  /**
+   * Picks the nodes of this world with each of the given rays. The hits of each ray are
+   * added to the pick result with the same index, so there must be one pick result for
+   * every ray.
+   *
+   * The node tree is traversed only once for all rays.
+   */
+  void pick(
+    const EditorContext& editorContext,
+    const std::vector<vm::ray3>& rays,
+    std::vector<PickResult>& pickResults);
+
 public: // node tree bulk updating
   void disableNodeTreeUpdates();
   void enableNodeTreeUpdates();
   void rebuildNodeTree();
 
+  NodeTreeType nodeTreeType() const;
+
+  /**
+   * Replaces the node tree with an empty tree of the given type and rebuilds it. Does
+   * nothing if the node tree already has the given type.
+   */
+  void setNodeTreeType(NodeTreeType nodeTreeType);
+
 private:
   void invalidateAllIssues();
 
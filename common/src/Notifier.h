@@ -24,9 +24,12 @@
 #include "kdl/set_temp.h"
 #include "kdl/tuple_utils.h"
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <memory>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
@@ -362,4 +365,171 @@ NotifyBeforeAndAfter(bool, Notifier<AA...>&, Notifier<AA...>&, NA&&...)
 template <typename... AA, typename... NA>
 NotifyBeforeAndAfter(Notifier<AA...>&, Notifier<AA...>&, NA&&...)
   -> NotifyBeforeAndAfter<AA...>;
+
+/**
+ * Coalesces the notifications of a pair of notifiers that are passed the objects which
+ * will change and which did change.
+ *
+ * While a batch is open, the before notifier is only notified of objects that it was not
+ * yet notified of during the batch, and the notifications of the after notifier are
+ * deferred. When the outermost batch is closed, the after notifier is notified once of
+ * all objects that changed during the batch, in the order in which they were first
+ * reported.
+ *
+ * If no batch is open, both notifiers are notified immediately.
+ *
+ * The unbatched notifiers are always notified immediately, even while a batch is open.
+ * They are meant for observers that pair the notifications, e.g. to remove some state for
+ * the objects that will change and to add it again once they did change. Such observers
+ * rely on each before notification being followed by the matching after notification.
+ *
+ * @tparam T the type of the objects passed to the notifiers
+ */
+template <typename T>
+class NotificationBatch
+{
+public:
+  using BatchNotifier = Notifier<const std::vector<T>&>;
+
+private:
+  BatchNotifier& m_before;
+  BatchNotifier& m_after;
+  BatchNotifier& m_unbatchedBefore;
+  BatchNotifier& m_unbatchedAfter;
+
+  size_t m_depth = 0;
+  std::vector<T> m_pending;
+  std::unordered_set<T> m_pendingSet;
+
+public:
+  NotificationBatch(
+    BatchNotifier& before,
+    BatchNotifier& after,
+    BatchNotifier& unbatchedBefore,
+    BatchNotifier& unbatchedAfter)
+    : m_before{before}
+    , m_after{after}
+    , m_unbatchedBefore{unbatchedBefore}
+    , m_unbatchedAfter{unbatchedAfter}
+  {
+  }
+
+  bool open() const { return m_depth > 0; }
+
+  /**
+   * Opens a batch. Batches can be nested.
+   */
+  void begin() { ++m_depth; }
+
+  /**
+   * Closes the current batch. If it was the outermost batch, the after notifier is
+   * notified of the pending objects.
+   *
+   * Returns the number of objects that the after notifier was notified of.
+   */
+  size_t end()
+  {
+    assert(m_depth > 0);
+    if (--m_depth > 0)
+    {
+      return 0;
+    }
+
+    // the observers may change the objects again, so clear the pending objects first
+    auto pending = std::exchange(m_pending, {});
+    m_pendingSet.clear();
+
+    if (!pending.empty())
+    {
+      m_after(pending);
+    }
+    return pending.size();
+  }
+
+  void notifyBefore(const std::vector<T>& objects)
+  {
+    m_unbatchedBefore(objects);
+
+    if (!open())
+    {
+      m_before(objects);
+      return;
+    }
+
+    auto newObjects = std::vector<T>{};
+    for (const auto& object : objects)
+    {
+      if (m_pendingSet.insert(object).second)
+      {
+        newObjects.push_back(object);
+        m_pending.push_back(object);
+      }
+    }
+
+    if (!newObjects.empty())
+    {
+      m_before(newObjects);
+    }
+  }
+
+  void notifyAfter(const std::vector<T>& objects)
+  {
+    if (!open())
+    {
+      m_after(objects);
+    }
+
+    m_unbatchedAfter(objects);
+  }
+
+  /**
+   * Removes the pending objects that satisfy the given predicate, e.g. because they were
+   * removed and must not be passed to the after notifier. The before notifier was already
+   * notified of them.
+   */
+  template <typename P>
+  void discardIf(const P& predicate)
+  {
+    const auto it = std::stable_partition(
+      m_pending.begin(), m_pending.end(), [&](const auto& object) {
+        return !predicate(object);
+      });
+    std::for_each(it, m_pending.end(), [&](const auto& object) {
+      m_pendingSet.erase(object);
+    });
+    m_pending.erase(it, m_pending.end());
+  }
+};
+
+/**
+ * RAII style helper like NotifyBeforeAndAfter that sends the notifications through the
+ * given batch.
+ */
+template <typename T>
+class NotifyBeforeAndAfterInBatch
+{
+private:
+  NotificationBatch<T>& m_batch;
+  const std::vector<T>& m_objects;
+
+public:
+  /**
+   * Creates a new instance that notifies the given batch. The given objects must outlive
+   * this object.
+   */
+  NotifyBeforeAndAfterInBatch(NotificationBatch<T>& batch, const std::vector<T>& objects)
+    : m_batch{batch}
+    , m_objects{objects}
+  {
+    m_batch.notifyBefore(m_objects);
+  }
+
+  NotifyBeforeAndAfterInBatch(NotificationBatch<T>& batch, std::vector<T>&& objects) =
+    delete;
+
+  ~NotifyBeforeAndAfterInBatch() { m_batch.notifyAfter(m_objects); }
+
+  NotifyBeforeAndAfterInBatch(const NotifyBeforeAndAfterInBatch&) = delete;
+  NotifyBeforeAndAfterInBatch& operator=(const NotifyBeforeAndAfterInBatch&) = delete;
+};
 } // namespace TrenchBroom
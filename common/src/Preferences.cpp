@@ -21,6 +21,7 @@
 
 #include <QKeySequence>
 
+#include "Model/NodeTreeType.h"
 #include "View/MapViewLayout.h"
 
 #include "vm/util.h"
@@ -191,6 +192,11 @@ Preference<bool> EnableMSAA("Renderer/Enable multisampling", true);
 Preference<bool> AlignmentLock("Editor/Texture lock", true);
 Preference<bool> UVLock("Editor/UV lock", false);
 
+Preference<int> UndoMemoryBudget("Editor/Undo memory budget", 1024);
+Preference<int> NodeTreeType(
+  "Editor/Node tree type", static_cast<int>(Model::NodeTreeType::Octree));
+Preference<bool> MapCacheEnabled("Editor/Cache large maps", true);
+
 Preference<std::filesystem::path>& RendererFontPath()
 {
   static Preference<std::filesystem::path> fontPath(
@@ -384,6 +390,9 @@ const std::vector<PreferenceBase*>& staticPreferences()
     &TextureMagFilter,
     &AlignmentLock,
     &UVLock,
+    &UndoMemoryBudget,
+    &NodeTreeType,
+    &MapCacheEnabled,
     &RendererFontPath(),
     &RendererFontSize,
     &BrowserFontSize,
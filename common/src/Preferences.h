@@ -132,6 +132,25 @@ extern Preference<bool> EnableMSAA;
 extern Preference<bool> AlignmentLock;
 extern Preference<bool> UVLock;
 
+/**
+ * The maximum amount of memory in MiB held by the undo history. Values of zero or less
+ * disable the limit.
+ */
+extern Preference<int> UndoMemoryBudget;
+
+/**
+ * The type of the spatial index of the world, see Model::NodeTreeType. Values that do not
+ * name a node tree type select the octree. Changing this rebuilds the spatial index of
+ * the open document.
+ */
+extern Preference<int> NodeTreeType;
+
+/**
+ * Whether large map files are cached in a .tbcache file next to the map file when they
+ * are loaded, see IO/MapCache.h. If disabled, no cache files are read or written.
+ */
+extern Preference<bool> MapCacheEnabled;
+
 Preference<std::filesystem::path>& RendererFontPath();
 extern Preference<int> RendererFontSize;
 
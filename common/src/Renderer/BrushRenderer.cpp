@@ -30,8 +30,12 @@
 #include "Preferences.h"
 #include "Renderer/BrushRendererArrays.h"
 #include "Renderer/BrushRendererBrushCache.h"
+#include "Renderer/PackedNormal.h"
 #include "Renderer/RenderContext.h"
 
+#include "kdl/parallel.h"
+
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <vector>
@@ -42,6 +46,12 @@ namespace TrenchBroom::Renderer
 namespace
 {
 
+/**
+ * The number of brushes whose vertex caches are built and whose indices are staged by
+ * one parallel task.
+ */
+constexpr size_t ValidationChunkSize = 256;
+
 class FilterWrapper : public BrushRenderer::Filter
 {
 private:
@@ -233,8 +243,10 @@ void BrushRenderer::clear()
   m_brushInfo.clear();
   m_allBrushes.clear();
   m_invalidBrushes.clear();
+  m_faceIndexCount = 0;
+  m_culledNodes.reset();
 
-  m_vertexArray = std::make_shared<BrushVertexArray>();
+  m_vertexArray = std::make_shared<BrushVertexArray>(m_packVertices);
   m_edgeIndices = std::make_shared<BrushIndexArray>();
   m_transparentFaces = std::make_shared<MaterialToBrushIndicesMap>();
   m_opaqueFaces = std::make_shared<MaterialToBrushIndicesMap>();
@@ -312,6 +324,22 @@ void BrushRenderer::setShowHiddenBrushes(const bool showHiddenBrushes)
   }
 }
 
+void BrushRenderer::setPackVertices(const bool packVertices)
+{
+  if (packVertices != m_packVertices)
+  {
+    m_packVertices = packVertices;
+    invalidate();
+
+    // the vertex array is empty now, replace it with one using the new vertex format
+    m_vertexArray = std::make_shared<BrushVertexArray>(m_packVertices);
+    m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
+    m_transparentFaceRenderer =
+      FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
+    m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+  }
+}
+
 void BrushRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
 {
   renderOpaque(renderContext, renderBatch);
@@ -326,6 +354,7 @@ void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& rend
     {
       validate();
     }
+    cull(renderContext);
     if (renderContext.showFaces())
     {
       renderOpaqueFaces(renderBatch);
@@ -346,6 +375,7 @@ void BrushRenderer::renderTransparent(
     {
       validate();
     }
+    cull(renderContext);
     if (renderContext.showFaces())
     {
       renderTransparentFaces(renderBatch);
@@ -353,6 +383,97 @@ void BrushRenderer::renderTransparent(
   }
 }
 
+void BrushRenderer::cull(RenderContext& renderContext)
+{
+  const auto& visibleNodes = renderContext.visibleNodes();
+  if (!visibleNodes)
+  {
+    m_culledNodes.reset();
+    m_visibleIndexRanges = VisibleIndexRanges{};
+  }
+  else if (m_culledNodes.lock() != visibleNodes)
+  {
+    m_culledNodes = visibleNodes;
+    m_visibleIndexRanges =
+      findVisibleIndexRanges(*visibleNodes, renderContext.cullingStats());
+  }
+
+  m_opaqueFaceRenderer.setVisibleIndexRanges(m_visibleIndexRanges.opaqueFaces);
+  m_transparentFaceRenderer.setVisibleIndexRanges(m_visibleIndexRanges.transparentFaces);
+  m_edgeRenderer.setVisibleIndexRanges(m_visibleIndexRanges.edges);
+}
+
+BrushRenderer::VisibleIndexRanges BrushRenderer::findVisibleIndexRanges(
+  const VisibleNodes& visibleNodes, CullingStats& cullingStats) const
+{
+  auto opaqueFaces = MaterialToIndexRangesMap{};
+  auto transparentFaces = MaterialToIndexRangesMap{};
+  auto edges = std::vector<IndexRange>{};
+  size_t visibleFaceIndexCount = 0;
+
+  const auto addFaceIndexRanges =
+    [&](const auto& faceIndicesKeys, MaterialToIndexRangesMap& ranges) {
+      for (const auto& [material, key] : faceIndicesKeys)
+      {
+        ranges[material].push_back(IndexRange{key->pos, key->size});
+        visibleFaceIndexCount += key->size;
+      }
+    };
+
+  const auto addIndexRanges = [&](const BrushInfo& info) {
+    if (info.edgeIndicesKey != nullptr)
+    {
+      edges.push_back(IndexRange{info.edgeIndicesKey->pos, info.edgeIndicesKey->size});
+    }
+    addFaceIndexRanges(info.opaqueFaceIndicesKeys, opaqueFaces);
+    addFaceIndexRanges(info.transparentFaceIndicesKeys, transparentFaces);
+  };
+
+  // iterate over the smaller set, e.g. the selection renderer usually contains only a few
+  // brushes, while the default renderer contains most of the visible brushes
+  if (m_brushInfo.size() <= visibleNodes.brushes().size())
+  {
+    for (const auto& [brushNode, info] : m_brushInfo)
+    {
+      if (visibleNodes.visible(brushNode))
+      {
+        addIndexRanges(info);
+      }
+    }
+  }
+  else
+  {
+    for (const auto* brushNode : visibleNodes.brushes())
+    {
+      if (const auto it = m_brushInfo.find(brushNode); it != m_brushInfo.end())
+      {
+        addIndexRanges(it->second);
+      }
+    }
+  }
+
+  for (auto& [material, ranges] : opaqueFaces)
+  {
+    ranges = mergeIndexRanges(std::move(ranges));
+  }
+  for (auto& [material, ranges] : transparentFaces)
+  {
+    ranges = mergeIndexRanges(std::move(ranges));
+  }
+
+  assert(visibleFaceIndexCount <= m_faceIndexCount);
+  cullingStats.add(
+    visibleFaceIndexCount / 3, (m_faceIndexCount - visibleFaceIndexCount) / 3);
+
+  return {
+    std::make_shared<const MaterialToIndexRangesMap>(
+      std::move(opaqueFaces)),
+    std::make_shared<const MaterialToIndexRangesMap>(
+      std::move(transparentFaces)),
+    std::make_shared<const std::vector<IndexRange>>(mergeIndexRanges(std::move(edges))),
+  };
+}
+
 void BrushRenderer::renderOpaqueFaces(RenderBatch& renderBatch)
 {
   m_opaqueFaceRenderer.setGrayscale(m_grayscale);
@@ -379,23 +500,99 @@ void BrushRenderer::renderEdges(RenderBatch& renderBatch)
   m_edgeRenderer.render(renderBatch, m_edgeColor);
 }
 
+struct BrushRenderer::BrushToValidate
+{
+  const Model::BrushNode* brushNode;
+  Filter::EdgeRenderPolicy edgePolicy;
+};
+
+struct BrushRenderer::StagedBrushes
+{
+  struct FaceIndices
+  {
+    const Assets::Material* material;
+    bool transparent;
+    size_t offset;
+    size_t count;
+  };
+
+  struct Brush
+  {
+    const Model::BrushNode* brushNode;
+    size_t edgeIndicesOffset;
+    size_t edgeIndexCount;
+    size_t faceIndicesOffset;
+    size_t faceIndicesCount;
+    size_t packedVerticesOffset;
+  };
+
+  std::vector<Brush> brushes;
+  std::vector<FaceIndices> faceIndices;
+  // edge and face indices of all brushes, relative to the first vertex of each brush
+  std::vector<GLuint> indices;
+  // only populated if the vertices are packed, otherwise the vertex caches are uploaded
+  std::vector<BrushVertexArray::PackedVertex> packedVertices;
+};
+
 void BrushRenderer::validate()
 {
   assert(!valid());
 
-  for (auto* brushNode : m_invalidBrushes)
+  // evaluate the filter serially because it may access state that is not thread safe,
+  // e.g. preferences
+  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
+
+  auto brushesToValidate = std::vector<BrushToValidate>{};
+  brushesToValidate.reserve(m_invalidBrushes.size());
+  for (const auto* brushNode : m_invalidBrushes)
   {
-    validateBrush(*brushNode);
+    assert(m_allBrushes.find(brushNode) != std::end(m_allBrushes));
+    assert(m_brushInfo.find(brushNode) == std::end(m_brushInfo));
+
+    // evaluate filter. only evaluate the filter once per brush.
+    const auto [facePolicy, edgePolicy] = wrapper.markFaces(*brushNode);
+    if (
+      facePolicy != Filter::FaceRenderPolicy::RenderNone
+      || edgePolicy != Filter::EdgeRenderPolicy::RenderNone)
+    {
+      brushesToValidate.push_back({brushNode, edgePolicy});
+    }
+    // NOTE: brushes that are filtered out are not inserted into m_brushInfo
   }
   m_invalidBrushes.clear();
   assert(valid());
 
+  // build the vertex caches and stage the indices in parallel, then allocate space in the
+  // shared arrays and copy the staged data serially
+  const auto chunkCount =
+    (brushesToValidate.size() + ValidationChunkSize - 1) / ValidationChunkSize;
+  auto stagedChunks = std::vector<StagedBrushes>(chunkCount);
+  kdl::parallel_for(chunkCount, [&](const size_t i) {
+    const auto* begin = brushesToValidate.data() + i * ValidationChunkSize;
+    const auto* end = brushesToValidate.data()
+                      + std::min((i + 1) * ValidationChunkSize, brushesToValidate.size());
+    stageBrushes(begin, end, stagedChunks[i]);
+  });
+
+  for (const auto& stagedBrushes : stagedChunks)
+  {
+    uploadBrushes(stagedBrushes);
+  }
+
+  // the index ranges of the brushes may have changed
+  m_culledNodes.reset();
+
   m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
   m_transparentFaceRenderer =
     FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
   m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
 }
 
+size_t BrushRenderer::vertexBufferSize() const
+{
+  return m_vertexArray->sizeInBytes();
+}
+
 static size_t triIndicesCountForPolygon(const size_t vertexCount)
 {
   assert(vertexCount >= 3);
@@ -437,50 +634,45 @@ static inline bool shouldRenderEdge(
   }
 }
 
-static size_t countMarkedEdgeIndices(
-  const Model::BrushNode& brushNode, const BrushRenderer::Filter::EdgeRenderPolicy policy)
+static void addMarkedEdgeIndices(
+  const Model::BrushNode& brushNode,
+  const BrushRenderer::Filter::EdgeRenderPolicy policy,
+  std::vector<GLuint>& dest)
 {
   using EdgeRenderPolicy = BrushRenderer::Filter::EdgeRenderPolicy;
 
   if (policy == EdgeRenderPolicy::RenderNone)
   {
-    return 0;
+    return;
   }
 
-  size_t indexCount = 0;
   for (const auto& edge : brushNode.brushRendererBrushCache().cachedEdges())
   {
     if (shouldRenderEdge(edge, policy))
     {
-      indexCount += 2;
+      dest.push_back(static_cast<GLuint>(edge.vertexIndex1RelativeToBrush));
+      dest.push_back(static_cast<GLuint>(edge.vertexIndex2RelativeToBrush));
     }
   }
-  return indexCount;
 }
 
-static void getMarkedEdgeIndices(
-  const Model::BrushNode& brushNode,
-  const BrushRenderer::Filter::EdgeRenderPolicy policy,
-  const GLuint brushVerticesStartIndex,
-  GLuint* dest)
+static void addPackedVertices(
+  const std::vector<BrushRendererBrushCache::Vertex>& vertices,
+  std::vector<BrushVertexArray::PackedVertex>& dest)
 {
-  using EdgeRenderPolicy = BrushRenderer::Filter::EdgeRenderPolicy;
-
-  if (policy == EdgeRenderPolicy::RenderNone)
+  dest.reserve(dest.size() + vertices.size());
+  for (const auto& vertex : vertices)
   {
-    return;
+    dest.emplace_back(vertex.attr, packNormal(vertex.rest.attr), vertex.rest.rest.attr);
   }
+}
 
-  size_t i = 0;
-  for (const auto& edge : brushNode.brushRendererBrushCache().cachedEdges())
+static void copyIndices(
+  GLuint* dest, const GLuint* src, const size_t count, const GLuint baseIndex)
+{
+  for (size_t i = 0; i < count; ++i)
   {
-    if (shouldRenderEdge(edge, policy))
-    {
-      dest[i++] =
-        static_cast<GLuint>(brushVerticesStartIndex + edge.vertexIndex1RelativeToBrush);
-      dest[i++] =
-        static_cast<GLuint>(brushVerticesStartIndex + edge.vertexIndex2RelativeToBrush);
-    }
+    dest[i] = baseIndex + src[i];
   }
 }
 
@@ -509,166 +701,164 @@ bool BrushRenderer::shouldDrawFaceInTransparentPass(
   return false;
 }
 
-void BrushRenderer::validateBrush(const Model::BrushNode& brushNode)
+void BrushRenderer::stageBrushes(
+  const BrushToValidate* begin,
+  const BrushToValidate* end,
+  StagedBrushes& stagedBrushes) const
 {
-  assert(m_allBrushes.find(&brushNode) != std::end(m_allBrushes));
-  assert(m_invalidBrushes.find(&brushNode) != std::end(m_invalidBrushes));
-  assert(m_brushInfo.find(&brushNode) == std::end(m_brushInfo));
-
-  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
+  stagedBrushes.brushes.reserve(size_t(end - begin));
 
-  // evaluate filter. only evaluate the filter once per brush.
-  const auto settings = wrapper.markFaces(brushNode);
-  const auto [facePolicy, edgePolicy] = settings;
-
-  if (
-    facePolicy == Filter::FaceRenderPolicy::RenderNone
-    && edgePolicy == Filter::EdgeRenderPolicy::RenderNone)
+  for (const auto* it = begin; it != end; ++it)
   {
-    // NOTE: this skips inserting the brush into m_brushInfo
-    return;
-  }
-
-  BrushInfo& info = m_brushInfo[&brushNode];
-
-  // collect vertices
-  auto& brushCache = brushNode.brushRendererBrushCache();
-  brushCache.validateVertexCache(brushNode);
-  const auto& cachedVertices = brushCache.cachedVertices();
-  ensure(!cachedVertices.empty(), "Brush must have cached vertices");
+    const auto& brushNode = *it->brushNode;
 
-  assert(m_vertexArray != nullptr);
-  auto [vertBlock, dest] =
-    m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
-  std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
-  info.vertexHolderKey = vertBlock;
+    auto& brushCache = brushNode.brushRendererBrushCache();
+    brushCache.validateVertexCache(brushNode);
+    ensure(!brushCache.cachedVertices().empty(), "Brush must have cached vertices");
 
-  const auto brushVerticesStartIndex = static_cast<GLuint>(vertBlock->pos);
+    auto& indices = stagedBrushes.indices;
+    auto& faceIndices = stagedBrushes.faceIndices;
+    auto brush = StagedBrushes::Brush{
+      &brushNode, indices.size(), 0, faceIndices.size(), 0, 0};
 
-  // insert edge indices into VBO
-  {
-    const auto edgeIndexCount = countMarkedEdgeIndices(brushNode, edgePolicy);
-    if (edgeIndexCount > 0)
+    // stage packed vertices
+    if (m_packVertices)
     {
-      auto [key, insertDest] =
-        m_edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
-      info.edgeIndicesKey = key;
-      getMarkedEdgeIndices(brushNode, edgePolicy, brushVerticesStartIndex, insertDest);
+      brush.packedVerticesOffset = stagedBrushes.packedVertices.size();
+      addPackedVertices(brushCache.cachedVertices(), stagedBrushes.packedVertices);
     }
-    else
-    {
-      // it's possible to have no edges to render
-      // e.g. select all faces of a brush, and the unselected brush renderer
-      // will hit this branch.
-      ensure(info.edgeIndicesKey == nullptr, "BrushInfo not initialized");
-    }
-  }
-
-  // insert face indices
 
-  auto& facesSortedByMaterial = brushCache.cachedFacesSortedByMaterial();
-  const auto facesSortedByMaterialCount = facesSortedByMaterial.size();
-
-  size_t nextI;
-  for (size_t i = 0; i < facesSortedByMaterialCount; i = nextI)
-  {
-    const auto* material = facesSortedByMaterial[i].material;
+    // stage edge indices
+    addMarkedEdgeIndices(brushNode, it->edgePolicy, indices);
+    brush.edgeIndexCount = indices.size() - brush.edgeIndicesOffset;
 
-    size_t opaqueIndexCount = 0;
-    size_t transparentIndexCount = 0;
+    // stage face indices
+    const auto& facesSortedByMaterial = brushCache.cachedFacesSortedByMaterial();
+    const auto facesSortedByMaterialCount = facesSortedByMaterial.size();
 
-    // find the i value for the next material
-    for (nextI = i + 1; nextI < facesSortedByMaterialCount
-                        && facesSortedByMaterial[nextI].material == material;
-         ++nextI)
+    size_t nextI;
+    for (size_t i = 0; i < facesSortedByMaterialCount; i = nextI)
     {
-    }
+      const auto* material = facesSortedByMaterial[i].material;
 
-    // process all faces with this material (they'll be consecutive)
-    for (size_t j = i; j < nextI; ++j)
-    {
-      const auto& cache = facesSortedByMaterial[j];
-      if (cache.face->isMarked())
+      // find the i value for the next material
+      for (nextI = i + 1; nextI < facesSortedByMaterialCount
+                          && facesSortedByMaterial[nextI].material == material;
+           ++nextI)
+      {
+      }
+
+      // process all faces with this material (they'll be consecutive), first the
+      // transparent ones, then the opaque ones
+      for (const auto transparent : {true, false})
       {
-        assert(cache.material == material);
-        if (shouldDrawFaceInTransparentPass(brushNode, *cache.face))
+        const auto offset = indices.size();
+        for (size_t j = i; j < nextI; ++j)
         {
-          transparentIndexCount += triIndicesCountForPolygon(cache.vertexCount);
+          const auto& cache = facesSortedByMaterial[j];
+          if (
+            cache.face->isMarked()
+            && shouldDrawFaceInTransparentPass(brushNode, *cache.face) == transparent)
+          {
+            assert(cache.material == material);
+            const auto indexCount = triIndicesCountForPolygon(cache.vertexCount);
+            indices.resize(indices.size() + indexCount);
+            addTriIndicesForPolygon(
+              indices.data() + indices.size() - indexCount,
+              static_cast<GLuint>(cache.indexOfFirstVertexRelativeToBrush),
+              cache.vertexCount);
+          }
         }
-        else
+
+        if (indices.size() > offset)
         {
-          opaqueIndexCount += triIndicesCountForPolygon(cache.vertexCount);
+          faceIndices.push_back({material, transparent, offset, indices.size() - offset});
         }
       }
     }
+    brush.faceIndicesCount = faceIndices.size() - brush.faceIndicesOffset;
 
-    if (transparentIndexCount > 0)
-    {
-      auto& faceVboMap = *m_transparentFaces;
-      auto& holderPtr = faceVboMap[material];
-      if (holderPtr == nullptr)
-      {
-        // inserts into map!
-        holderPtr = std::make_shared<BrushIndexArray>();
-      }
+    stagedBrushes.brushes.push_back(brush);
+  }
+}
 
-      auto [key, insertDest] =
-        holderPtr->getPointerToInsertElementsAt(transparentIndexCount);
-      info.transparentFaceIndicesKeys.emplace_back(material, key);
+void BrushRenderer::uploadBrushes(const StagedBrushes& stagedBrushes)
+{
+  assert(m_vertexArray != nullptr);
 
-      // process all faces with this material (they'll be consecutive)
-      auto* currentDest = insertDest;
-      for (size_t j = i; j < nextI; ++j)
-      {
-        const auto& cache = facesSortedByMaterial[j];
-        if (
-          cache.face->isMarked()
-          && shouldDrawFaceInTransparentPass(brushNode, *cache.face))
-        {
-          addTriIndicesForPolygon(
-            currentDest,
-            static_cast<GLuint>(
-              brushVerticesStartIndex + cache.indexOfFirstVertexRelativeToBrush),
-            cache.vertexCount);
+  for (const auto& brush : stagedBrushes.brushes)
+  {
+    BrushInfo& info = m_brushInfo[brush.brushNode];
 
-          currentDest += triIndicesCountForPolygon(cache.vertexCount);
-        }
-      }
-      assert(currentDest == (insertDest + transparentIndexCount));
+    // insert vertices into VBO
+    const auto& cachedVertices =
+      brush.brushNode->brushRendererBrushCache().cachedVertices();
+    AllocationTracker::Block* vertBlock = nullptr;
+    if (m_packVertices)
+    {
+      auto [block, dest] =
+        m_vertexArray->getPointerToInsertPackedVerticesAt(cachedVertices.size());
+      std::memcpy(
+        dest,
+        stagedBrushes.packedVertices.data() + brush.packedVerticesOffset,
+        cachedVertices.size() * sizeof(*dest));
+      vertBlock = block;
+    }
+    else
+    {
+      auto [block, dest] =
+        m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
+      std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
+      vertBlock = block;
     }
+    info.vertexHolderKey = vertBlock;
+
+    const auto brushVerticesStartIndex = static_cast<GLuint>(vertBlock->pos);
 
-    if (opaqueIndexCount > 0)
+    // insert edge indices into VBO
+    if (brush.edgeIndexCount > 0)
     {
-      auto& faceVboMap = *m_opaqueFaces;
-      auto& holderPtr = faceVboMap[material];
+      auto [key, insertDest] =
+        m_edgeIndices->getPointerToInsertElementsAt(brush.edgeIndexCount);
+      info.edgeIndicesKey = key;
+      copyIndices(
+        insertDest,
+        stagedBrushes.indices.data() + brush.edgeIndicesOffset,
+        brush.edgeIndexCount,
+        brushVerticesStartIndex);
+    }
+    else
+    {
+      // it's possible to have no edges to render
+      // e.g. select all faces of a brush, and the unselected brush renderer
+      // will hit this branch.
+      ensure(info.edgeIndicesKey == nullptr, "BrushInfo not initialized");
+    }
+
+    // insert face indices into VBO
+    for (size_t i = 0; i < brush.faceIndicesCount; ++i)
+    {
+      const auto& faceIndices = stagedBrushes.faceIndices[brush.faceIndicesOffset + i];
+
+      auto& faceVboMap = faceIndices.transparent ? *m_transparentFaces : *m_opaqueFaces;
+      auto& holderPtr = faceVboMap[faceIndices.material];
       if (holderPtr == nullptr)
       {
         // inserts into map!
         holderPtr = std::make_shared<BrushIndexArray>();
       }
 
-      auto [key, insertDest] = holderPtr->getPointerToInsertElementsAt(opaqueIndexCount);
-      info.opaqueFaceIndicesKeys.emplace_back(material, key);
-
-      // process all faces with this material (they'll be consecutive)
-      auto* currentDest = insertDest;
-      for (size_t j = i; j < nextI; ++j)
-      {
-        const auto& cache = facesSortedByMaterial[j];
-        if (
-          cache.face->isMarked()
-          && !shouldDrawFaceInTransparentPass(brushNode, *cache.face))
-        {
-          addTriIndicesForPolygon(
-            currentDest,
-            static_cast<GLuint>(
-              brushVerticesStartIndex + cache.indexOfFirstVertexRelativeToBrush),
-            cache.vertexCount);
-
-          currentDest += triIndicesCountForPolygon(cache.vertexCount);
-        }
-      }
-      assert(currentDest == (insertDest + opaqueIndexCount));
+      auto [key, insertDest] = holderPtr->getPointerToInsertElementsAt(faceIndices.count);
+      auto& keys = faceIndices.transparent ? info.transparentFaceIndicesKeys
+                                           : info.opaqueFaceIndicesKeys;
+      keys.emplace_back(faceIndices.material, key);
+      m_faceIndexCount += faceIndices.count;
+
+      copyIndices(
+        insertDest,
+        stagedBrushes.indices.data() + faceIndices.offset,
+        faceIndices.count,
+        brushVerticesStartIndex);
     }
   }
 }
@@ -721,6 +911,8 @@ void BrushRenderer::removeBrushFromVbo(const Model::BrushNode& brushNode)
 
   for (const auto& [material, opaqueKey] : info.opaqueFaceIndicesKeys)
   {
+    m_faceIndexCount -= opaqueKey->size;
+
     auto faceIndexHolder = m_opaqueFaces->at(material);
     faceIndexHolder->zeroElementsWithKey(opaqueKey);
 
@@ -733,6 +925,8 @@ void BrushRenderer::removeBrushFromVbo(const Model::BrushNode& brushNode)
   }
   for (const auto& [material, transparentKey] : info.transparentFaceIndicesKeys)
   {
+    m_faceIndexCount -= transparentKey->size;
+
     auto faceIndexHolder = m_transparentFaces->at(material);
     faceIndexHolder->zeroElementsWithKey(transparentKey);
 
@@ -745,6 +939,7 @@ void BrushRenderer::removeBrushFromVbo(const Model::BrushNode& brushNode)
   }
 
   m_brushInfo.erase(it);
+  m_culledNodes.reset();
 }
 
 } // namespace TrenchBroom::Renderer
@@ -41,6 +41,8 @@ class EditorContext;
 
 namespace TrenchBroom::Renderer
 {
+struct CullingStats;
+class VisibleNodes;
 
 class BrushRenderer
 {
@@ -155,6 +157,26 @@ private:
   FaceRenderer m_transparentFaceRenderer;
   IndexedEdgeRenderer m_edgeRenderer;
 
+  /**
+   * The number of face indices currently stored in the VBO.
+   */
+  size_t m_faceIndexCount = 0;
+
+  struct VisibleIndexRanges
+  {
+    std::shared_ptr<const MaterialToIndexRangesMap> opaqueFaces;
+    std::shared_ptr<const MaterialToIndexRangesMap> transparentFaces;
+    std::shared_ptr<const std::vector<IndexRange>> edges;
+  };
+
+  /**
+   * The visible nodes for which m_visibleIndexRanges was computed. Since the opaque and
+   * the transparent pass are rendered separately, this avoids computing the index ranges
+   * twice per frame.
+   */
+  std::weak_ptr<const VisibleNodes> m_culledNodes;
+  VisibleIndexRanges m_visibleIndexRanges;
+
   Color m_faceColor;
   bool m_showEdges = false;
   Color m_edgeColor;
@@ -167,6 +189,7 @@ private:
   float m_transparencyAlpha = 1.0f;
 
   bool m_showHiddenBrushes = false;
+  bool m_packVertices = false;
 
 public:
   template <typename FilterT>
@@ -270,12 +293,30 @@ public:
    */
   void setShowHiddenBrushes(bool showHiddenBrushes);
 
+  /**
+   * Specifies whether or not to store the vertices with packed normals, which reduces the
+   * size of the vertex buffer by a quarter. Changing this removes all brushes from the
+   * vertex buffer, so it should be called before any brushes are rendered.
+   *
+   * @see BrushVertexArray::PackedVertex
+   */
+  void setPackVertices(bool packVertices);
+
 public: // rendering
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
 
 private:
+  /**
+   * Restricts the face and edge renderers to the brushes that are visible according to
+   * the given render context. If the render context does not provide any visible nodes,
+   * all brushes are rendered.
+   */
+  void cull(RenderContext& renderContext);
+  VisibleIndexRanges findVisibleIndexRanges(
+    const VisibleNodes& visibleNodes, CullingStats& cullingStats) const;
+
   void renderOpaqueFaces(RenderBatch& renderBatch);
   void renderTransparentFaces(RenderBatch& renderBatch);
   void renderEdges(RenderBatch& renderBatch);
@@ -286,10 +327,34 @@ public:
    */
   void validate();
 
+  /**
+   * Returns the size of the vertex buffer in bytes. Only exposed for benchmarking.
+   */
+  size_t vertexBufferSize() const;
+
 private:
+  struct BrushToValidate;
+  struct StagedBrushes;
+
   bool shouldDrawFaceInTransparentPass(
     const Model::BrushNode& brushNode, const Model::BrushFace& face) const;
-  void validateBrush(const Model::BrushNode& brushNode);
+
+  /**
+   * Builds the vertex caches of the given brushes and collects their edge and face
+   * indices, relative to the first vertex of each brush, into the given staging
+   * buffers. If vertices are packed, the packed vertices are staged, too. Does not
+   * modify this renderer, so it can be called in parallel.
+   */
+  void stageBrushes(
+    const BrushToValidate* begin,
+    const BrushToValidate* end,
+    StagedBrushes& stagedBrushes) const;
+
+  /**
+   * Allocates space for the given staged brushes in the vertex and index arrays and
+   * copies their vertices and indices.
+   */
+  void uploadBrushes(const StagedBrushes& stagedBrushes);
 
 public:
   /**
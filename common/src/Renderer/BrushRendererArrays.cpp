@@ -23,6 +23,7 @@
 #include <cassert>
 #include <cstring>
 #include <stdexcept>
+#include <variant>
 
 namespace TrenchBroom
 {
@@ -111,6 +112,29 @@ void IndexHolder::render(const PrimType primType, const size_t offset, size_t co
   glAssert(glDrawElements(toGL(primType), renderCount, glType<Index>(), renderOffset));
 }
 
+void IndexHolder::render(
+  const PrimType primType, const std::vector<IndexRange>& ranges) const
+{
+  auto renderCounts = std::vector<GLsizei>{};
+  auto renderOffsets = std::vector<const GLvoid*>{};
+  renderCounts.reserve(ranges.size());
+  renderOffsets.reserve(ranges.size());
+
+  for (const auto& range : ranges)
+  {
+    renderCounts.push_back(static_cast<GLsizei>(range.count));
+    renderOffsets.push_back(
+      reinterpret_cast<const GLvoid*>(m_vbo->offset() + sizeof(Index) * range.offset));
+  }
+
+  glAssert(glMultiDrawElements(
+    toGL(primType),
+    renderCounts.data(),
+    glType<Index>(),
+    renderOffsets.data(),
+    static_cast<GLsizei>(ranges.size())));
+}
+
 std::shared_ptr<IndexHolder> IndexHolder::swap(std::vector<IndexHolder::Index>& elements)
 {
   return std::make_shared<IndexHolder>(elements);
@@ -170,6 +194,13 @@ void BrushIndexArray::render(const PrimType primType) const
   m_indexHolder.render(primType, 0, m_indexHolder.size());
 }
 
+void BrushIndexArray::render(
+  const PrimType primType, const std::vector<IndexRange>& ranges) const
+{
+  assert(m_indexHolder.prepared());
+  m_indexHolder.render(primType, ranges);
+}
+
 bool BrushIndexArray::prepared() const
 {
   return m_indexHolder.prepared();
@@ -193,19 +224,53 @@ void BrushIndexArray::cleanupIndices()
 
 // BrushVertexArray
 
-BrushVertexArray::BrushVertexArray()
+namespace
+{
+template <typename V>
+size_t vertexSizeInBytes(const VertexHolder<V>& vertexHolder)
+{
+  return vertexHolder.size() * sizeof(V);
+}
+} // namespace
+
+BrushVertexArray::BrushVertexArray(const bool packed)
   : m_vertexHolder()
   , m_allocationTracker(0)
 {
+  if (packed)
+  {
+    m_vertexHolder.emplace<VertexHolder<PackedVertex>>();
+  }
+}
+
+bool BrushVertexArray::packed() const
+{
+  return std::holds_alternative<VertexHolder<PackedVertex>>(m_vertexHolder);
 }
 
 std::pair<AllocationTracker::Block*, BrushVertexArray::Vertex*> BrushVertexArray::
   getPointerToInsertVerticesAt(const size_t vertexCount)
 {
+  return insertVertices<Vertex>(vertexCount);
+}
+
+std::pair<AllocationTracker::Block*, BrushVertexArray::PackedVertex*> BrushVertexArray::
+  getPointerToInsertPackedVerticesAt(const size_t vertexCount)
+{
+  return insertVertices<PackedVertex>(vertexCount);
+}
+
+template <typename V>
+std::pair<AllocationTracker::Block*, V*> BrushVertexArray::insertVertices(
+  const size_t vertexCount)
+{
+  auto* vertexHolder = std::get_if<VertexHolder<V>>(&m_vertexHolder);
+  ensure(vertexHolder != nullptr, "vertex type matches vertex array");
+
   auto block = m_allocationTracker.allocate(vertexCount);
   if (block != nullptr)
   {
-    Vertex* dest = m_vertexHolder.getPointerToWriteElementsTo(block->pos, vertexCount);
+    V* dest = vertexHolder->getPointerToWriteElementsTo(block->pos, vertexCount);
     return {block, dest};
   }
 
@@ -213,13 +278,13 @@ std::pair<AllocationTracker::Block*, BrushVertexArray::Vertex*> BrushVertexArray
   const size_t newSize = std::max(
     2 * m_allocationTracker.capacity(), m_allocationTracker.capacity() + vertexCount);
   m_allocationTracker.expand(newSize);
-  m_vertexHolder.resize(newSize);
+  vertexHolder->resize(newSize);
 
   // insert again
   block = m_allocationTracker.allocate(vertexCount);
   assert(block != nullptr);
 
-  Vertex* dest = m_vertexHolder.getPointerToWriteElementsTo(block->pos, vertexCount);
+  V* dest = vertexHolder->getPointerToWriteElementsTo(block->pos, vertexCount);
   return {block, dest};
 }
 
@@ -233,25 +298,38 @@ void BrushVertexArray::deleteVerticesWithKey(AllocationTracker::Block* key)
   // us to re-use the space later
 }
 
+size_t BrushVertexArray::sizeInBytes() const
+{
+  return std::visit(
+    [](const auto& vertexHolder) { return vertexSizeInBytes(vertexHolder); },
+    m_vertexHolder);
+}
+
 bool BrushVertexArray::setupVertices()
 {
-  return m_vertexHolder.setupVertices();
+  return std::visit(
+    [](auto& vertexHolder) { return vertexHolder.setupVertices(); }, m_vertexHolder);
 }
 
 void BrushVertexArray::cleanupVertices()
 {
-  m_vertexHolder.cleanupVertices();
+  std::visit([](auto& vertexHolder) { vertexHolder.cleanupVertices(); }, m_vertexHolder);
 }
 
 bool BrushVertexArray::prepared() const
 {
-  return m_vertexHolder.prepared();
+  return std::visit(
+    [](const auto& vertexHolder) { return vertexHolder.prepared(); }, m_vertexHolder);
 }
 
 void BrushVertexArray::prepare(VboManager& vboManager)
 {
-  m_vertexHolder.prepare(vboManager);
-  assert(m_vertexHolder.prepared());
+  std::visit(
+    [&](auto& vertexHolder) {
+      vertexHolder.prepare(vboManager);
+      assert(vertexHolder.prepared());
+    },
+    m_vertexHolder);
 }
 } // namespace Renderer
 } // namespace TrenchBroom
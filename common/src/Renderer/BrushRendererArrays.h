@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Renderer/AllocationTracker.h"
+#include "Renderer/FrustumCulling.h"
 #include "Renderer/GL.h"
 #include "Renderer/GLVertexType.h"
 #include "Renderer/PrimType.h"
@@ -33,6 +34,7 @@
 #include <cassert>
 #include <memory>
 #include <unordered_map>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom
@@ -243,6 +245,11 @@ public:
   void zeroRange(size_t offsetWithinBlock, size_t count);
   void render(PrimType primType, size_t offset, size_t count) const;
 
+  /**
+   * Renders the given ranges of indices with a single draw call.
+   */
+  void render(PrimType primType, const std::vector<IndexRange>& ranges) const;
+
   static std::shared_ptr<IndexHolder> swap(std::vector<Index>& elements);
 };
 
@@ -284,6 +291,13 @@ public:
   void zeroElementsWithKey(AllocationTracker::Block* key);
 
   void render(const PrimType primType) const;
+
+  /**
+   * Renders only the given ranges of indices. The ranges are expected to refer to blocks
+   * returned by getPointerToInsertElementsAt().
+   */
+  void render(PrimType primType, const std::vector<IndexRange>& ranges) const;
+
   bool prepared() const;
   void prepare(VboManager& vboManager);
 
@@ -348,17 +362,32 @@ public:
  * Same as BrushIndexArray but for vertices instead of indices.
  * The only difference is deleteVerticesWithKey() doesn't need to zero out
  * the deleted memory in the VBO, while BrushIndexArray's does.
+ *
+ * The vertices are stored either in full precision or packed, see PackedVertex.
  */
 class BrushVertexArray
 {
-private:
+public:
   using Vertex = Renderer::GLVertexTypes::P3NT2::Vertex;
+  /**
+   * Stores the normal in octahedral encoding (see PackedNormal.h), which reduces the size
+   * of a vertex from 32 to 24 bytes. Must be rendered with shaders that decode the
+   * normal, e.g. Shaders::PackedFaceShader.
+   */
+  using PackedVertex = Renderer::GLVertexTypes::P3NOctT2::Vertex;
 
-  VertexHolder<Vertex> m_vertexHolder;
+private:
+  std::variant<VertexHolder<Vertex>, VertexHolder<PackedVertex>> m_vertexHolder;
   AllocationTracker m_allocationTracker;
 
 public:
-  BrushVertexArray();
+  /**
+   * Creates a vertex array that stores vertices of type PackedVertex if packed is true,
+   * and of type Vertex otherwise.
+   */
+  explicit BrushVertexArray(bool packed = false);
+
+  bool packed() const;
 
   /**
    * Call this to request writing the given number of vertices.
@@ -368,12 +397,25 @@ public:
    * Returns a AllocationTracker::Block pointer which can be used later in a call to
    * deleteVerticesWithKey(), and also a Vertex pointer where the caller should write
    * `elementCount` Vertex objects.
+   *
+   * The vertex array must not be packed.
    */
   std::pair<AllocationTracker::Block*, Vertex*> getPointerToInsertVerticesAt(
     size_t vertexCount);
 
+  /**
+   * Same as getPointerToInsertVerticesAt, but for packed vertex arrays.
+   */
+  std::pair<AllocationTracker::Block*, PackedVertex*> getPointerToInsertPackedVerticesAt(
+    size_t vertexCount);
+
   void deleteVerticesWithKey(AllocationTracker::Block* key);
 
+  /**
+   * Returns the number of bytes needed to store the vertices, including unused space.
+   */
+  size_t sizeInBytes() const;
+
   // setting up GL attributes
   bool setupVertices();
   void cleanupVertices();
@@ -381,6 +423,10 @@ public:
   // uploading the VBO
   bool prepared() const;
   void prepare(VboManager& vboManager);
+
+private:
+  template <typename V>
+  std::pair<AllocationTracker::Block*, V*> insertVertices(size_t vertexCount);
 };
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -228,10 +228,12 @@ void DirectEdgeRenderer::doRender(
 IndexedEdgeRenderer::Render::Render(
   const EdgeRenderer::Params& params,
   std::shared_ptr<BrushVertexArray> vertexArray,
-  std::shared_ptr<BrushIndexArray> indexArray)
+  std::shared_ptr<BrushIndexArray> indexArray,
+  std::shared_ptr<const std::vector<IndexRange>> visibleIndexRanges)
   : RenderBase{params}
   , m_vertexArray{std::move(vertexArray)}
   , m_indexArray{std::move(indexArray)}
+  , m_visibleIndexRanges{std::move(visibleIndexRanges)}
 {
 }
 
@@ -243,7 +245,9 @@ void IndexedEdgeRenderer::Render::prepareVerticesAndIndices(VboManager& vboManag
 
 void IndexedEdgeRenderer::Render::doRender(RenderContext& renderContext)
 {
-  if (m_indexArray->hasValidIndices())
+  if (
+    m_indexArray->hasValidIndices()
+    && (!m_visibleIndexRanges || !m_visibleIndexRanges->empty()))
   {
     renderEdges(renderContext);
   }
@@ -253,7 +257,14 @@ void IndexedEdgeRenderer::Render::doRenderVertices(RenderContext&)
 {
   m_vertexArray->setupVertices();
   m_indexArray->setupIndices();
-  m_indexArray->render(PrimType::Lines);
+  if (m_visibleIndexRanges)
+  {
+    m_indexArray->render(PrimType::Lines, *m_visibleIndexRanges);
+  }
+  else
+  {
+    m_indexArray->render(PrimType::Lines);
+  }
   m_vertexArray->cleanupVertices();
   m_indexArray->cleanupIndices();
 }
@@ -270,10 +281,17 @@ IndexedEdgeRenderer::IndexedEdgeRenderer(
 {
 }
 
+void IndexedEdgeRenderer::setVisibleIndexRanges(
+  std::shared_ptr<const std::vector<IndexRange>> visibleIndexRanges)
+{
+  m_visibleIndexRanges = std::move(visibleIndexRanges);
+}
+
 void IndexedEdgeRenderer::doRender(
   RenderBatch& renderBatch, const EdgeRenderer::Params& params)
 {
-  renderBatch.addOneShot(new Render{params, m_vertexArray, m_indexArray});
+  renderBatch.addOneShot(
+    new Render{params, m_vertexArray, m_indexArray, m_visibleIndexRanges});
 }
 } // namespace Renderer
 } // namespace TrenchBroom
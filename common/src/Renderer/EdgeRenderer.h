@@ -20,11 +20,13 @@
 #pragma once
 
 #include "Color.h"
+#include "Renderer/FrustumCulling.h"
 #include "Renderer/IndexRangeMap.h"
 #include "Renderer/Renderable.h"
 #include "Renderer/VertexArray.h"
 
 #include <memory>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -149,12 +151,14 @@ private:
   private:
     std::shared_ptr<BrushVertexArray> m_vertexArray;
     std::shared_ptr<BrushIndexArray> m_indexArray;
+    std::shared_ptr<const std::vector<IndexRange>> m_visibleIndexRanges;
 
   public:
     Render(
       const Params& params,
       std::shared_ptr<BrushVertexArray> vertexArray,
-      std::shared_ptr<BrushIndexArray> indexArray);
+      std::shared_ptr<BrushIndexArray> indexArray,
+      std::shared_ptr<const std::vector<IndexRange>> visibleIndexRanges);
 
   private:
     void prepareVerticesAndIndices(VboManager& vboManager) override;
@@ -165,6 +169,7 @@ private:
 private:
   std::shared_ptr<BrushVertexArray> m_vertexArray;
   std::shared_ptr<BrushIndexArray> m_indexArray;
+  std::shared_ptr<const std::vector<IndexRange>> m_visibleIndexRanges;
 
 public:
   IndexedEdgeRenderer();
@@ -172,6 +177,12 @@ public:
     std::shared_ptr<BrushVertexArray> vertexArray,
     std::shared_ptr<BrushIndexArray> indexArray);
 
+  /**
+   * Restricts rendering to the given index ranges. Pass null to render all indices.
+   */
+  void setVisibleIndexRanges(
+    std::shared_ptr<const std::vector<IndexRange>> visibleIndexRanges);
+
 private:
   void doRender(RenderBatch& renderBatch, const EdgeRenderer::Params& params) override;
 };
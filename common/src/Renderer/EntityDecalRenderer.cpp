@@ -29,11 +29,11 @@
 #include "Model/EditorContext.h"
 #include "Model/EntityNode.h"
 #include "Model/ModelUtils.h"
+#include "Model/NodeTree.h"
 #include "Model/Polyhedron_Face.h"
 #include "Model/UVCoordSystem.h"
 #include "Model/WorldNode.h"
 #include "View/MapDocument.h"
-#include "octree.h"
 
 #include "kdl/memory_utils.h"
 #include "kdl/overload.h"
@@ -32,20 +32,33 @@
 #include "Preferences.h"
 #include "Renderer/ActiveShader.h"
 #include "Renderer/Camera.h"
+#include "Renderer/FrustumCulling.h"
 #include "Renderer/MaterialIndexRangeRenderer.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/RenderUtils.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/Shaders.h"
-#include "Renderer/Transformation.h"
 
 #include "vm/mat.h"
 
+#include <cassert>
 #include <vector>
 
 namespace TrenchBroom::Renderer
 {
+namespace
+{
+
+vm::mat4x4f modelTransformation(const Model::EntityNode& entityNode)
+{
+  const auto& defaultModelScaleExpression =
+    entityNode.entityPropertyConfig().defaultModelScaleExpression;
+  return vm::mat4x4f{
+    entityNode.entity().modelTransformation(defaultModelScaleExpression)};
+}
+
+} // namespace
 
 EntityModelRenderer::EntityModelRenderer(
   Logger& logger,
@@ -70,15 +83,19 @@ void EntityModelRenderer::addEntity(const Model::EntityNode* entityNode)
     });
 
   auto* renderer = m_entityModelManager.renderer(modelSpec);
-  if (renderer != nullptr)
+  if (renderer != nullptr && !m_entities.contains(entityNode))
   {
-    m_entities.emplace(entityNode, renderer);
+    addToBatch(entityNode, renderer);
   }
 }
 
 void EntityModelRenderer::removeEntity(const Model::EntityNode* entityNode)
 {
-  m_entities.erase(entityNode);
+  if (const auto it = m_entities.find(entityNode); it != std::end(m_entities))
+  {
+    removeFromBatch(it->second);
+    m_entities.erase(it);
+  }
 }
 
 void EntityModelRenderer::updateEntity(const Model::EntityNode* entityNode)
@@ -91,31 +108,30 @@ void EntityModelRenderer::updateEntity(const Model::EntityNode* entityNode)
   auto* renderer = m_entityModelManager.renderer(modelSpec);
   auto it = m_entities.find(entityNode);
 
-  if (renderer == nullptr && it == std::end(m_entities))
+  if (it != std::end(m_entities))
   {
-    return;
-  }
+    if (it->second.renderer == renderer)
+    {
+      // the entity may have been moved
+      auto& batch = m_batches.at(renderer);
+      batch.transformations[it->second.index] = modelTransformation(*entityNode);
+      return;
+    }
 
-  if (it == std::end(m_entities))
-  {
-    m_entities.emplace(entityNode, renderer);
+    removeFromBatch(it->second);
+    m_entities.erase(it);
   }
-  else
+
+  if (renderer != nullptr)
   {
-    if (renderer == nullptr)
-    {
-      m_entities.erase(it);
-    }
-    else if (it->second != renderer)
-    {
-      it->second = renderer;
-    }
+    addToBatch(entityNode, renderer);
   }
 }
 
 void EntityModelRenderer::clear()
 {
   m_entities.clear();
+  m_batches.clear();
 }
 
 bool EntityModelRenderer::applyTinting() const
@@ -148,11 +164,50 @@ void EntityModelRenderer::setShowHiddenEntities(const bool showHiddenEntities)
   m_showHiddenEntities = showHiddenEntities;
 }
 
+void EntityModelRenderer::setVisibleNodes(
+  std::shared_ptr<const VisibleNodes> visibleNodes)
+{
+  m_visibleNodes = std::move(visibleNodes);
+}
+
 void EntityModelRenderer::render(RenderBatch& renderBatch)
 {
   renderBatch.add(this);
 }
 
+void EntityModelRenderer::addToBatch(
+  const Model::EntityNode* entityNode, MaterialRenderer* renderer)
+{
+  auto& batch = m_batches[renderer];
+  m_entities.emplace(entityNode, EntityInfo{renderer, batch.entityNodes.size()});
+  batch.entityNodes.push_back(entityNode);
+  batch.transformations.push_back(modelTransformation(*entityNode));
+}
+
+void EntityModelRenderer::removeFromBatch(const EntityInfo entityInfo)
+{
+  const auto it = m_batches.find(entityInfo.renderer);
+  assert(it != std::end(m_batches));
+
+  // move the last entity of the batch into the slot of the removed entity
+  auto& batch = it->second;
+  const auto lastIndex = batch.entityNodes.size() - 1;
+  if (entityInfo.index != lastIndex)
+  {
+    const auto* lastEntityNode = batch.entityNodes[lastIndex];
+    batch.entityNodes[entityInfo.index] = lastEntityNode;
+    batch.transformations[entityInfo.index] = batch.transformations[lastIndex];
+    m_entities.at(lastEntityNode).index = entityInfo.index;
+  }
+
+  batch.entityNodes.pop_back();
+  batch.transformations.pop_back();
+  if (batch.entityNodes.empty())
+  {
+    m_batches.erase(it);
+  }
+}
+
 void EntityModelRenderer::doPrepareVertices(VboManager& vboManager)
 {
   m_entityModelManager.prepare(vboManager);
@@ -190,36 +245,49 @@ void EntityModelRenderer::doRender(RenderContext& renderContext)
     shader.set("CameraUp", renderContext.camera().up());
     shader.set("ViewMatrix", renderContext.camera().viewMatrix());
 
-    const auto& propertyConfig = m_entities.begin()->first->entityPropertyConfig();
-    const auto& defaultModelScaleExpression = propertyConfig.defaultModelScaleExpression;
+    auto renderFunc = DefaultMaterialRenderFunc{
+      renderContext.minFilterMode(), renderContext.magFilterMode()};
+    auto transformations = std::vector<vm::mat4x4f>{};
+    auto drawCalls = size_t(0);
 
-    for (const auto& [entityNode, renderer] : m_entities)
+    for (const auto& [renderer, batch] : m_batches)
     {
-      if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
+      // all entities in a batch share the same model, so they share its orientation
+      const auto* modelData = static_cast<const Assets::EntityModelData*>(nullptr);
+
+      transformations.clear();
+      for (size_t i = 0; i < batch.entityNodes.size(); ++i)
       {
-        continue;
+        const auto* entityNode = batch.entityNodes[i];
+        if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
+        {
+          continue;
+        }
+
+        if (m_visibleNodes && !m_visibleNodes->visible(entityNode))
+        {
+          continue;
+        }
+
+        const auto* model = entityNode->entity().model();
+        if (const auto* data = model ? model->data() : nullptr)
+        {
+          modelData = data;
+          transformations.push_back(batch.transformations[i]);
+        }
       }
 
-      const auto* model = entityNode->entity().model();
-      const auto* modelData = model ? model->data() : nullptr;
-      if (!modelData)
+      if (modelData)
       {
-        continue;
+        shader.set("Orientation", static_cast<int>(modelData->orientation()));
+        drawCalls += renderer->renderInstances(
+          renderFunc, transformations.size(), [&](const size_t index) {
+            shader.set("ModelMatrix", transformations[index]);
+          });
       }
-
-      shader.set("Orientation", static_cast<int>(modelData->orientation()));
-
-      const auto transformation = vm::mat4x4f{
-        entityNode->entity().modelTransformation(defaultModelScaleExpression)};
-      const auto multMatrix =
-        MultiplyModelMatrix{renderContext.transformation(), transformation};
-
-      shader.set("ModelMatrix", transformation);
-
-      auto renderFunc = DefaultMaterialRenderFunc{
-        renderContext.minFilterMode(), renderContext.magFilterMode()};
-      renderer->render(renderFunc);
     }
+
+    renderContext.addEntityModelDrawCalls(drawCalls);
   }
 }
 
@@ -22,7 +22,12 @@
 #include "Color.h"
 #include "Renderer/Renderable.h"
 
+#include "vm/forward.h"
+#include "vm/mat.h"
+
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -45,6 +50,7 @@ namespace TrenchBroom::Renderer
 class RenderBatch;
 class ShaderConfig;
 class MaterialRenderer;
+class VisibleNodes;
 
 class EntityModelRenderer : public DirectRenderable
 {
@@ -54,13 +60,33 @@ private:
   Assets::EntityModelManager& m_entityModelManager;
   const Model::EditorContext& m_editorContext;
 
-  std::unordered_map<const Model::EntityNode*, MaterialRenderer*> m_entities;
+  /**
+   * The entities that share a model renderer, along with their model transformations.
+   * They are rendered together so that the renderer's vertex array and materials are
+   * set up only once for all of them.
+   */
+  struct Batch
+  {
+    std::vector<const Model::EntityNode*> entityNodes;
+    std::vector<vm::mat4x4f> transformations;
+  };
+
+  struct EntityInfo
+  {
+    MaterialRenderer* renderer;
+    size_t index; // the index of the entity in its batch
+  };
+
+  std::unordered_map<const Model::EntityNode*, EntityInfo> m_entities;
+  std::unordered_map<MaterialRenderer*, Batch> m_batches;
 
   bool m_applyTinting = false;
   Color m_tintColor;
 
   bool m_showHiddenEntities = false;
 
+  std::shared_ptr<const VisibleNodes> m_visibleNodes;
+
 public:
   EntityModelRenderer(
     Logger& logger,
@@ -108,9 +134,17 @@ public:
   bool showHiddenEntities() const;
   void setShowHiddenEntities(bool showHiddenEntities);
 
+  /**
+   * Restricts rendering to the given visible nodes. Pass null to render all entities.
+   */
+  void setVisibleNodes(std::shared_ptr<const VisibleNodes> visibleNodes);
+
   void render(RenderBatch& renderBatch);
 
 private:
+  void addToBatch(const Model::EntityNode* entityNode, MaterialRenderer* renderer);
+  void removeFromBatch(EntityInfo entityInfo);
+
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
 };
@@ -277,6 +277,7 @@ void EntityRenderer::renderModels(RenderContext& renderContext, RenderBatch& ren
     m_modelRenderer.setApplyTinting(m_tint);
     m_modelRenderer.setTintColor(m_tintColor);
     m_modelRenderer.setShowHiddenEntities(m_showHiddenEntities);
+    m_modelRenderer.setVisibleNodes(renderContext.visibleNodes());
     m_modelRenderer.render(renderBatch);
   }
 }
@@ -290,8 +291,14 @@ void EntityRenderer::renderClassnames(
     renderService.setForegroundColor(m_overlayTextColor);
     renderService.setBackgroundColor(m_overlayBackgroundColor);
 
+    const auto& visibleNodes = renderContext.visibleNodes();
     for (const auto* entity : m_entities)
     {
+      if (visibleNodes && !visibleNodes->visible(entity))
+      {
+        continue;
+      }
+
       if (m_showHiddenEntities || m_editorContext.visible(entity))
       {
         if (
@@ -326,6 +333,7 @@ void EntityRenderer::renderAngles(RenderContext& renderContext, RenderBatch& ren
     renderService.setShowOccludedObjectsTransparent();
     renderService.setForegroundColor(m_angleColor);
 
+    const auto& visibleNodes = renderContext.visibleNodes();
     for (const auto* entityNode : m_entities)
     {
       if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
@@ -333,6 +341,11 @@ void EntityRenderer::renderAngles(RenderContext& renderContext, RenderBatch& ren
         continue;
       }
 
+      if (visibleNodes && !visibleNodes->visible(entityNode))
+      {
+        continue;
+      }
+
       const auto rotation = vm::mat4x4f{entityNode->entity().rotation()};
       const auto direction = rotation * vm::vec3f{0, 0, 1};
       const auto center = vm::vec3f{entityNode->logicalBounds().center()};
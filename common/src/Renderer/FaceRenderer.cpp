@@ -121,6 +121,12 @@ void FaceRenderer::setAlpha(const float alpha)
   m_alpha = alpha;
 }
 
+void FaceRenderer::setVisibleIndexRanges(
+  std::shared_ptr<const MaterialToIndexRangesMap> visibleIndexRanges)
+{
+  m_visibleIndexRanges = std::move(visibleIndexRanges);
+}
+
 void FaceRenderer::render(RenderBatch& renderBatch)
 {
   renderBatch.add(this);
@@ -138,10 +144,20 @@ void FaceRenderer::prepareVerticesAndIndices(VboManager& vboManager)
 
 void FaceRenderer::doRender(RenderContext& context)
 {
-  if (!m_indexArrayMap->empty() && m_vertexArray->setupVertices())
+  if (m_indexArrayMap->empty())
+  {
+    return;
+  }
+
+  // the shader must be active before the vertices are set up because the location of the
+  // packed normal attribute is looked up in the current program
+  auto& shaderManager = context.shaderManager();
+  auto shader = ActiveShader{
+    shaderManager,
+    m_vertexArray->packed() ? Shaders::PackedFaceShader : Shaders::FaceShader};
+
+  if (m_vertexArray->setupVertices())
   {
-    auto& shaderManager = context.shaderManager();
-    auto shader = ActiveShader{shaderManager, Shaders::FaceShader};
     auto& prefs = PreferenceManager::instance();
 
     const auto applyMaterial = context.showMaterials();
@@ -187,6 +203,18 @@ void FaceRenderer::doRender(RenderContext& context)
     }
     for (const auto& [material, brushIndexHolderPtr] : *m_indexArrayMap)
     {
+      const std::vector<IndexRange>* visibleRanges = nullptr;
+      if (m_visibleIndexRanges)
+      {
+        const auto iVisibleRanges = m_visibleIndexRanges->find(material);
+        if (iVisibleRanges == m_visibleIndexRanges->end())
+        {
+          // none of the faces with this material are visible
+          continue;
+        }
+        visibleRanges = &iVisibleRanges->second;
+      }
+
       if (brushIndexHolderPtr->hasValidIndices())
       {
         const auto* texture = getTexture(material);
@@ -198,7 +226,14 @@ void FaceRenderer::doRender(RenderContext& context)
 
         func.before(material);
         brushIndexHolderPtr->setupIndices();
-        brushIndexHolderPtr->render(PrimType::Triangles);
+        if (visibleRanges)
+        {
+          brushIndexHolderPtr->render(PrimType::Triangles, *visibleRanges);
+        }
+        else
+        {
+          brushIndexHolderPtr->render(PrimType::Triangles);
+        }
         brushIndexHolderPtr->cleanupIndices();
         func.after(material);
       }
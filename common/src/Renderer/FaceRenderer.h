@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Color.h"
+#include "Renderer/FrustumCulling.h"
 #include "Renderer/Renderable.h"
 
 #include "vm/forward.h"
@@ -47,6 +48,7 @@ private:
 
   std::shared_ptr<BrushVertexArray> m_vertexArray;
   std::shared_ptr<MaterialToBrushIndicesMap> m_indexArrayMap;
+  std::shared_ptr<const MaterialToIndexRangesMap> m_visibleIndexRanges;
   Color m_faceColor;
   bool m_grayscale = false;
   bool m_tint = false;
@@ -65,6 +67,13 @@ public:
   void setTintColor(const Color& color);
   void setAlpha(float alpha);
 
+  /**
+   * Restricts rendering to the given index ranges. Materials that have no entry in the
+   * given map are not rendered at all. Pass null to render all indices.
+   */
+  void setVisibleIndexRanges(
+    std::shared_ptr<const MaterialToIndexRangesMap> visibleIndexRanges);
+
   void render(RenderBatch& renderBatch);
 
 private:
@@ -0,0 +1,167 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrustumCulling.h"
+
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/NodeTree.h"
+#include "Model/PatchNode.h"
+#include "Model/WorldNode.h"
+#include "Renderer/Camera.h"
+
+#include "kdl/overload.h"
+#include "kdl/reflection_impl.h"
+
+#include <algorithm>
+
+namespace TrenchBroom::Renderer
+{
+
+namespace
+{
+
+std::vector<vm::plane3> frustumPlanes(const Camera& camera)
+{
+  auto top = vm::plane3f{};
+  auto right = vm::plane3f{};
+  auto bottom = vm::plane3f{};
+  auto left = vm::plane3f{};
+  camera.frustumPlanes(top, right, bottom, left);
+
+  auto planes = std::vector<vm::plane3>{
+    vm::plane3{top}, vm::plane3{right}, vm::plane3{bottom}, vm::plane3{left}};
+
+  if (camera.perspectiveProjection())
+  {
+    const auto farPoint = camera.position() + camera.farPlane() * camera.direction();
+    planes.emplace_back(vm::vec3{farPoint}, vm::vec3{camera.direction()});
+  }
+
+  return planes;
+}
+
+} // namespace
+
+ViewFrustum::ViewFrustum(const Camera& camera)
+  : m_planes{frustumPlanes(camera)}
+{
+}
+
+ViewFrustum::ViewFrustum(std::vector<vm::plane3> planes)
+  : m_planes{std::move(planes)}
+{
+}
+
+const std::vector<vm::plane3>& ViewFrustum::planes() const
+{
+  return m_planes;
+}
+
+bool ViewFrustum::intersects(const vm::bbox3& bounds) const
+{
+  return std::none_of(m_planes.begin(), m_planes.end(), [&](const auto& plane) {
+    // the corner of the box that is farthest behind the plane
+    const auto corner = vm::vec3{
+      plane.normal.x() >= 0.0 ? bounds.min.x() : bounds.max.x(),
+      plane.normal.y() >= 0.0 ? bounds.min.y() : bounds.max.y(),
+      plane.normal.z() >= 0.0 ? bounds.min.z() : bounds.max.z()};
+    return plane.point_distance(corner) > 0.0;
+  });
+}
+
+VisibleNodes::VisibleNodes() = default;
+
+VisibleNodes::VisibleNodes(const Model::WorldNode& worldNode, const ViewFrustum& frustum)
+{
+  const auto candidates = worldNode.nodeTree().find_candidates(
+    [&](const auto& bounds) { return frustum.intersects(bounds); });
+
+  for (const auto* node : candidates)
+  {
+    if (frustum.intersects(node->physicalBounds()))
+    {
+      node->accept(kdl::overload(
+        [](const Model::WorldNode*) {},
+        [](const Model::LayerNode*) {},
+        [](const Model::GroupNode*) {},
+        [&](const Model::EntityNode* entityNode) { m_entities.insert(entityNode); },
+        [&](const Model::BrushNode* brushNode) { m_brushes.insert(brushNode); },
+        [&](const Model::PatchNode* patchNode) { m_patches.insert(patchNode); }));
+    }
+  }
+}
+
+const std::unordered_set<const Model::BrushNode*>& VisibleNodes::brushes() const
+{
+  return m_brushes;
+}
+
+bool VisibleNodes::visible(const Model::BrushNode* brushNode) const
+{
+  return m_brushes.count(brushNode) > 0;
+}
+
+bool VisibleNodes::visible(const Model::PatchNode* patchNode) const
+{
+  return m_patches.count(patchNode) > 0;
+}
+
+bool VisibleNodes::visible(const Model::EntityNode* entityNode) const
+{
+  return m_entities.count(entityNode) > 0;
+}
+
+kdl_reflect_impl(IndexRange);
+
+std::vector<IndexRange> mergeIndexRanges(std::vector<IndexRange> ranges)
+{
+  std::sort(ranges.begin(), ranges.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.offset < rhs.offset;
+  });
+
+  auto result = std::vector<IndexRange>{};
+  result.reserve(ranges.size());
+
+  for (const auto& range : ranges)
+  {
+    if (!result.empty() && result.back().offset + result.back().count == range.offset)
+    {
+      result.back().count += range.count;
+    }
+    else
+    {
+      result.push_back(range);
+    }
+  }
+
+  return result;
+}
+
+void CullingStats::add(const size_t drawn, const size_t culled)
+{
+  drawnPrimitives += drawn;
+  culledPrimitives += culled;
+}
+
+kdl_reflect_impl(CullingStats);
+
+} // namespace TrenchBroom::Renderer
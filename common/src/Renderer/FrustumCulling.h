@@ -0,0 +1,139 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+
+#include "kdl/reflection_decl.h"
+
+#include "vm/bbox.h"
+#include "vm/plane.h"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace TrenchBroom::Assets
+{
+class Material;
+}
+
+namespace TrenchBroom::Model
+{
+class BrushNode;
+class EntityNode;
+class PatchNode;
+class WorldNode;
+} // namespace TrenchBroom::Model
+
+namespace TrenchBroom::Renderer
+{
+class Camera;
+
+/**
+ * A convex view volume given by a set of planes whose normals point outwards.
+ */
+class ViewFrustum
+{
+private:
+  std::vector<vm::plane3> m_planes;
+
+public:
+  /**
+   * Creates the view frustum of the given camera. For a perspective camera, the frustum
+   * is bounded by the side planes and the far plane. For an orthographic camera, only the
+   * side planes are used.
+   */
+  explicit ViewFrustum(const Camera& camera);
+
+  explicit ViewFrustum(std::vector<vm::plane3> planes);
+
+  const std::vector<vm::plane3>& planes() const;
+
+  /**
+   * Indicates whether the given box intersects with this frustum. The test is
+   * conservative: a box is only rejected if it is entirely in front of one of the planes,
+   * so some boxes near the edges of the frustum are accepted even though they are
+   * outside of it.
+   */
+  bool intersects(const vm::bbox3& bounds) const;
+};
+
+/**
+ * The brushes, patches and entities whose bounds intersect with a view frustum.
+ */
+class VisibleNodes
+{
+private:
+  std::unordered_set<const Model::BrushNode*> m_brushes;
+  std::unordered_set<const Model::PatchNode*> m_patches;
+  std::unordered_set<const Model::EntityNode*> m_entities;
+
+public:
+  VisibleNodes();
+
+  /**
+   * Finds the visible nodes by querying the node tree of the given world with the given
+   * frustum.
+   */
+  VisibleNodes(const Model::WorldNode& worldNode, const ViewFrustum& frustum);
+
+  const std::unordered_set<const Model::BrushNode*>& brushes() const;
+
+  bool visible(const Model::BrushNode* brushNode) const;
+  bool visible(const Model::PatchNode* patchNode) const;
+  bool visible(const Model::EntityNode* entityNode) const;
+};
+
+/**
+ * A contiguous range of indices in an index buffer.
+ */
+struct IndexRange
+{
+  size_t offset;
+  size_t count;
+
+  kdl_reflect_decl(IndexRange, offset, count);
+};
+
+using MaterialToIndexRangesMap =
+  std::unordered_map<const Assets::Material*, std::vector<IndexRange>>;
+
+/**
+ * Sorts the given ranges by their offsets and merges adjacent ranges so that they can be
+ * rendered with as few draw calls as possible.
+ */
+std::vector<IndexRange> mergeIndexRanges(std::vector<IndexRange> ranges);
+
+/**
+ * Counts the primitives that were rendered and the primitives that were skipped because
+ * they are outside of the view frustum.
+ */
+struct CullingStats
+{
+  size_t drawnPrimitives = 0;
+  size_t culledPrimitives = 0;
+
+  void add(size_t drawn, size_t culled);
+
+  kdl_reflect_decl(CullingStats, drawnPrimitives, culledPrimitives);
+};
+
+} // namespace TrenchBroom::Renderer
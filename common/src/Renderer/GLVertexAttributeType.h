@@ -26,6 +26,8 @@
 
 #include "vm/vec.h"
 
+#include <string>
+
 namespace TrenchBroom
 {
 namespace Renderer
@@ -39,8 +41,10 @@ namespace Renderer
  * @tparam D the vertex component type
  * @tparam S the number of components
  * @tparam N whether to normalize signed integer types to [-1..1] and unsigned to [0..1]
+ * @tparam O whether the attribute is optional, optional attributes are not set up if the
+ * current program does not use them
  */
-template <class A, GLenum D, size_t S, bool N>
+template <class A, GLenum D, size_t S, bool N, bool O = false>
 class GLVertexAttributeUser
 {
 public:
@@ -48,6 +52,7 @@ public:
   using ElementType = vm::vec<ComponentType, S>;
   static const size_t Size = sizeof(ElementType);
   static const bool Normalize = N;
+  static const bool Optional = O;
 
   static void setup(
     ShaderProgram* program,
@@ -57,7 +62,12 @@ public:
   {
     ensure(program != nullptr, "must have a program bound to use generic attributes");
 
-    const GLint attributeIndex = program->findAttributeLocation(A::name);
+    const GLint attributeIndex = findAttributeLocation(*program);
+    if (attributeIndex == -1)
+    {
+      return;
+    }
+
     glAssert(glEnableVertexAttribArray(static_cast<GLuint>(attributeIndex)));
     glAssert(glVertexAttribPointer(
       static_cast<GLuint>(attributeIndex),
@@ -72,10 +82,23 @@ public:
   {
     ensure(program != nullptr, "must have a program bound to use generic attributes");
 
-    const GLint attributeIndex = program->findAttributeLocation(A::name);
+    const GLint attributeIndex = findAttributeLocation(*program);
+    if (attributeIndex == -1)
+    {
+      return;
+    }
+
     glAssert(glDisableVertexAttribArray(static_cast<GLuint>(attributeIndex)));
   }
 
+private:
+  static GLint findAttributeLocation(const ShaderProgram& program)
+  {
+    return Optional ? program.findOptionalAttributeLocation(A::name)
+                    : program.findAttributeLocation(A::name);
+  }
+
+public:
   // Non-instantiable
   GLVertexAttributeUser() = delete;
   deleteCopyAndMove(GLVertexAttributeUser);
@@ -235,9 +258,16 @@ public:
 
 namespace GLVertexAttributeTypes
 {
+struct PackedNormalName
+{
+  static inline const auto name = std::string{"PackedNormal"};
+};
+
 using P2 = GLVertexAttributePosition<GL_FLOAT, 2>;
 using P3 = GLVertexAttributePosition<GL_FLOAT, 3>;
 using N = GLVertexAttributeNormal<GL_FLOAT, 3>;
+// octahedral encoded normal, see PackedNormal.h
+using NOct = GLVertexAttributeUser<PackedNormalName, GL_SHORT, 2, true, true>;
 using UV02 = GLVertexAttributeUVCoord0<GL_FLOAT, 2>;
 using C4 = GLVertexAttributeColor<GL_FLOAT, 4>;
 } // namespace GLVertexAttributeTypes
@@ -198,6 +198,10 @@ using P3NT2 = GLVertexType<
   GLVertexAttributeTypes::P3,
   GLVertexAttributeTypes::N,
   GLVertexAttributeTypes::UV02>;
+using P3NOctT2 = GLVertexType<
+  GLVertexAttributeTypes::P3,
+  GLVertexAttributeTypes::NOct,
+  GLVertexAttributeTypes::UV02>;
 } // namespace GLVertexTypes
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -171,8 +171,9 @@ void IndexRangeMap::add(const IndexRangeMap& other)
   }
 }
 
-void IndexRangeMap::render(VertexArray& vertexArray) const
+size_t IndexRangeMap::render(VertexArray& vertexArray) const
 {
+  auto drawCalls = size_t(0);
   for (const auto& primType : PrimTypeValues)
   {
     const auto& indicesAndCounts = m_data->get(primType);
@@ -181,8 +182,10 @@ void IndexRangeMap::render(VertexArray& vertexArray) const
       const auto primCount = static_cast<GLsizei>(indicesAndCounts.size());
       vertexArray.render(
         primType, indicesAndCounts.indices, indicesAndCounts.counts, primCount);
+      ++drawCalls;
     }
   }
+  return drawCalls;
 }
 
 void IndexRangeMap::forEachPrimitive(
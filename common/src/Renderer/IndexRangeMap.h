@@ -155,8 +155,9 @@ public:
    * vertex array.
    *
    * @param vertexArray the vertex array to render with
+   * @return the number of draw calls issued
    */
-  void render(VertexArray& vertexArray) const;
+  size_t render(VertexArray& vertexArray) const;
 
   /**
    * Invokes the given function for each primitive stored in this map.
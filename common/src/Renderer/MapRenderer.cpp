@@ -38,6 +38,7 @@
 #include "Renderer/BrushRenderer.h"
 #include "Renderer/EntityDecalRenderer.h"
 #include "Renderer/EntityLinkRenderer.h"
+#include "Renderer/FrustumCulling.h"
 #include "Renderer/GroupLinkRenderer.h"
 #include "Renderer/ObjectRenderer.h"
 #include "Renderer/RenderBatch.h"
@@ -230,6 +231,11 @@ void MapRenderer::restoreSelectionColors()
 void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
 {
   setupGL(renderBatch);
+
+  // only the object renderers are culled, other renderers might render nodes that are not
+  // in the world's node tree
+  renderContext.setVisibleNodes(findVisibleNodes(renderContext));
+
   renderDefaultOpaque(renderContext, renderBatch);
   renderLockedOpaque(renderContext, renderBatch);
   renderSelectionOpaque(renderContext, renderBatch);
@@ -238,6 +244,8 @@ void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
   renderLockedTransparent(renderContext, renderBatch);
   renderSelectionTransparent(renderContext, renderBatch);
 
+  renderContext.setVisibleNodes(nullptr);
+
   renderEntityDecals(renderContext, renderBatch);
   renderEntityLinks(renderContext, renderBatch);
   renderGroupLinks(renderContext, renderBatch);
@@ -267,6 +275,18 @@ private:
   }
 };
 
+std::shared_ptr<const VisibleNodes> MapRenderer::findVisibleNodes(
+  const RenderContext& renderContext) const
+{
+  auto document = kdl::mem_lock(m_document);
+  if (const auto* worldNode = document->world())
+  {
+    return std::make_shared<const VisibleNodes>(
+      *worldNode, ViewFrustum{renderContext.camera()});
+  }
+  return nullptr;
+}
+
 void MapRenderer::setupGL(RenderBatch& renderBatch)
 {
   renderBatch.addOneShot(new SetupGL{});
@@ -359,6 +379,7 @@ void MapRenderer::setupDefaultRenderer(ObjectRenderer& renderer)
 
   renderer.setBrushFaceColor(pref(Preferences::FaceColor));
   renderer.setBrushEdgeColor(pref(Preferences::EdgeColor));
+  renderer.setPackBrushVertices(true);
 }
 
 void MapRenderer::setupSelectionRenderer(ObjectRenderer& renderer)
@@ -405,6 +426,7 @@ void MapRenderer::setupLockedRenderer(ObjectRenderer& renderer)
 
   renderer.setBrushFaceColor(pref(Preferences::FaceColor));
   renderer.setBrushEdgeColor(pref(Preferences::LockedEdgeColor));
+  renderer.setPackBrushVertices(true);
 }
 
 static bool selected(const Model::Node* node)
@@ -61,6 +61,7 @@ class GroupLinkRenderer;
 class ObjectRenderer;
 class RenderBatch;
 class RenderContext;
+class VisibleNodes;
 
 class MapRenderer
 {
@@ -101,6 +102,8 @@ public: // rendering
 
 private:
   void clear();
+  std::shared_ptr<const VisibleNodes> findVisibleNodes(
+    const RenderContext& renderContext) const;
   void setupGL(RenderBatch& renderBatch);
   void renderDefaultOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderDefaultTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
@@ -81,11 +81,11 @@ void MaterialIndexArrayMapBuilder::addTriangle(
   m_indices[offset + 2] = i3;
 }
 
-void MaterialIndexArrayMapBuilder::addTriangles(
+size_t MaterialIndexArrayMapBuilder::addTriangles(
   const Material* material, const IndexList& indices)
 {
   assert(indices.size() % 3 == 0);
-  add(material, PrimType::Triangles, indices);
+  return add(material, PrimType::Triangles, indices);
 }
 
 void MaterialIndexArrayMapBuilder::addQuad(
@@ -158,13 +158,14 @@ void MaterialIndexArrayMapBuilder::addPolygon(
   add(material, PrimType::Triangles, polyIndices);
 }
 
-void MaterialIndexArrayMapBuilder::add(
+size_t MaterialIndexArrayMapBuilder::add(
   const Material* material, const PrimType primType, const IndexList& indices)
 {
   const size_t offset = m_ranges.add(material, primType, indices.size());
   auto dest = std::begin(m_indices);
   std::advance(dest, static_cast<IndexList::iterator::difference_type>(offset));
   std::copy(std::begin(indices), std::end(indices), dest);
+  return offset;
 }
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -128,8 +128,9 @@ public:
    *
    * @param material the material to use
    * @param indices a list of indices containing the triples of vertex indices to record
+   * @return the offset of the first recorded index in the index array
    */
-  void addTriangles(const Material* material, const IndexList& indices);
+  size_t addTriangles(const Material* material, const IndexList& indices);
 
   /**
    * Adds a quad, represented by the vertices in a vertex array at the given
@@ -192,7 +193,7 @@ public:
   void addPolygon(const Material* material, Index baseIndex, size_t vertexCount);
 
 private:
-  void add(const Material* material, PrimType primType, const IndexList& indices);
+  size_t add(const Material* material, PrimType primType, const IndexList& indices);
 };
 } // namespace Renderer
 } // namespace TrenchBroom
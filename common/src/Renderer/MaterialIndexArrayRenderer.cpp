@@ -19,6 +19,8 @@
 
 #include "MaterialIndexArrayRenderer.h"
 
+#include "Renderer/RenderUtils.h"
+
 namespace TrenchBroom
 {
 namespace Renderer
@@ -56,5 +58,29 @@ void MaterialIndexArrayRenderer::render(MaterialRenderFunc& func)
     m_vertexArray.cleanup();
   }
 }
+
+void MaterialIndexArrayRenderer::render(
+  MaterialRenderFunc& func,
+  const PrimType primType,
+  const MaterialToIndexRangesMap& ranges)
+{
+  if (m_vertexArray.setup())
+  {
+    if (m_indexArray.setup())
+    {
+      for (const auto& [material, materialRanges] : ranges)
+      {
+        func.before(material);
+        for (const auto& range : materialRanges)
+        {
+          m_indexArray.render(primType, range.offset, range.count);
+        }
+        func.after(material);
+      }
+      m_indexArray.cleanup();
+    }
+    m_vertexArray.cleanup();
+  }
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -19,8 +19,10 @@
 
 #pragma once
 
+#include "Renderer/FrustumCulling.h"
 #include "Renderer/IndexArray.h"
 #include "Renderer/MaterialIndexArrayMap.h"
+#include "Renderer/PrimType.h"
 #include "Renderer/VertexArray.h"
 
 namespace TrenchBroom
@@ -51,6 +53,13 @@ public:
 
   void prepare(VboManager& vboManager);
   void render(MaterialRenderFunc& func);
+
+  /**
+   * Renders only the given ranges of indices, all of which must contain primitives of the
+   * given type.
+   */
+  void render(
+    MaterialRenderFunc& func, PrimType primType, const MaterialToIndexRangesMap& ranges);
 };
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -144,6 +144,26 @@ void MaterialIndexRangeMap::render(VertexArray& vertexArray, MaterialRenderFunc&
   }
 }
 
+size_t MaterialIndexRangeMap::renderInstances(
+  VertexArray& vertexArray,
+  MaterialRenderFunc& func,
+  const size_t instanceCount,
+  const std::function<void(size_t)>& prepareInstance)
+{
+  auto drawCalls = size_t(0);
+  for (const auto& [material, indexArray] : *m_data)
+  {
+    func.before(material);
+    for (size_t i = 0; i < instanceCount; ++i)
+    {
+      prepareInstance(i);
+      drawCalls += indexArray.render(vertexArray);
+    }
+    func.after(material);
+  }
+  return drawCalls;
+}
+
 void MaterialIndexRangeMap::forEachPrimitive(
   std::function<void(const Material*, PrimType, size_t, size_t)> func) const
 {
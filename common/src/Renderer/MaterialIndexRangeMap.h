@@ -21,6 +21,7 @@
 
 #include "Renderer/IndexRangeMap.h"
 
+#include <functional>
 #include <map>
 
 namespace TrenchBroom
@@ -177,6 +178,24 @@ public:
    */
   void render(VertexArray& vertexArray, MaterialRenderFunc& func);
 
+  /**
+   * Renders the primitives stored in this index range map the given number of times using
+   * the vertices in the given vertex array. Each material is activated only once for all
+   * instances, and the given function is called before an instance is rendered so that it
+   * can set up the instance's state, e.g. its transformation.
+   *
+   * @param vertexArray the vertex array to render with
+   * @param func the material callbacks
+   * @param instanceCount the number of instances to render
+   * @param prepareInstance the function to call with the index of each instance
+   * @return the number of draw calls issued
+   */
+  size_t renderInstances(
+    VertexArray& vertexArray,
+    MaterialRenderFunc& func,
+    size_t instanceCount,
+    const std::function<void(size_t)>& prepareInstance);
+
   /**
    * Invokes the given function for each primitive stored in this map.
    *
@@ -64,6 +64,21 @@ void MaterialIndexRangeRenderer::render(MaterialRenderFunc& func)
   }
 }
 
+size_t MaterialIndexRangeRenderer::renderInstances(
+  MaterialRenderFunc& func,
+  const size_t instanceCount,
+  const std::function<void(size_t)>& prepareInstance)
+{
+  auto drawCalls = size_t(0);
+  if (instanceCount > 0 && m_vertexArray.setup())
+  {
+    drawCalls =
+      m_indexRange.renderInstances(m_vertexArray, func, instanceCount, prepareInstance);
+    m_vertexArray.cleanup();
+  }
+  return drawCalls;
+}
+
 MultiMaterialIndexRangeRenderer::MultiMaterialIndexRangeRenderer(
   std::vector<std::unique_ptr<MaterialIndexRangeRenderer>> renderers)
   : m_renderers(std::move(renderers))
@@ -99,5 +114,18 @@ void MultiMaterialIndexRangeRenderer::render(MaterialRenderFunc& func)
     renderer->render(func);
   }
 }
+
+size_t MultiMaterialIndexRangeRenderer::renderInstances(
+  MaterialRenderFunc& func,
+  const size_t instanceCount,
+  const std::function<void(size_t)>& prepareInstance)
+{
+  auto drawCalls = size_t(0);
+  for (auto& renderer : m_renderers)
+  {
+    drawCalls += renderer->renderInstances(func, instanceCount, prepareInstance);
+  }
+  return drawCalls;
+}
 } // namespace Renderer
 } // namespace TrenchBroom
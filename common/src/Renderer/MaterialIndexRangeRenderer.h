@@ -22,6 +22,7 @@
 #include "Renderer/MaterialIndexRangeMap.h"
 #include "Renderer/VertexArray.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -46,6 +47,18 @@ public:
 
   virtual void prepare(VboManager& vboManager) = 0;
   virtual void render(MaterialRenderFunc& func) = 0;
+
+  /**
+   * Renders the given number of instances. The vertex array is set up and each material
+   * is activated only once for all instances. The given function is called before each
+   * instance is rendered.
+   *
+   * Returns the number of draw calls issued.
+   */
+  virtual size_t renderInstances(
+    MaterialRenderFunc& func,
+    size_t instanceCount,
+    const std::function<void(size_t)>& prepareInstance) = 0;
 };
 
 class MaterialIndexRangeRenderer : public MaterialRenderer
@@ -68,6 +81,10 @@ public:
 
   void prepare(VboManager& vboManager) override;
   void render(MaterialRenderFunc& func) override;
+  size_t renderInstances(
+    MaterialRenderFunc& func,
+    size_t instanceCount,
+    const std::function<void(size_t)>& prepareInstance) override;
 };
 
 class MultiMaterialIndexRangeRenderer : public MaterialRenderer
@@ -84,6 +101,10 @@ public:
 
   void prepare(VboManager& vboManager) override;
   void render(MaterialRenderFunc& func) override;
+  size_t renderInstances(
+    MaterialRenderFunc& func,
+    size_t instanceCount,
+    const std::function<void(size_t)>& prepareInstance) override;
 };
 } // namespace Renderer
 } // namespace TrenchBroom
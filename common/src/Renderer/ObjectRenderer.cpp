@@ -202,6 +202,11 @@ void ObjectRenderer::setBrushEdgeColor(const Color& brushEdgeColor)
   m_patchRenderer.setEdgeColor(brushEdgeColor);
 }
 
+void ObjectRenderer::setPackBrushVertices(const bool packBrushVertices)
+{
+  m_brushRenderer.setPackVertices(packBrushVertices);
+}
+
 void ObjectRenderer::setShowHiddenObjects(const bool showHiddenObjects)
 {
   m_entityRenderer.setShowHiddenEntities(showHiddenObjects);
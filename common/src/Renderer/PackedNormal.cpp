@@ -0,0 +1,81 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PackedNormal.h"
+
+#include "vm/scalar.h"
+#include "vm/vec.h"
+
+#include <cmath>
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+
+float signNotZero(const float f)
+{
+  return f < 0.0f ? -1.0f : 1.0f;
+}
+
+GLshort toSnorm16(const float f)
+{
+  return static_cast<GLshort>(std::round(vm::clamp(f, -1.0f, 1.0f) * 32767.0f));
+}
+
+float fromSnorm16(const GLshort s)
+{
+  return vm::max(static_cast<float>(s) / 32767.0f, -1.0f);
+}
+
+} // namespace
+
+vm::vec<GLshort, 2> packNormal(const vm::vec3f& normal)
+{
+  const auto l1 = std::abs(normal.x()) + std::abs(normal.y()) + std::abs(normal.z());
+  auto x = normal.x() / l1;
+  auto y = normal.y() / l1;
+
+  if (normal.z() < 0.0f)
+  {
+    // fold the lower hemisphere over the diagonals
+    const auto foldedX = (1.0f - std::abs(y)) * signNotZero(x);
+    const auto foldedY = (1.0f - std::abs(x)) * signNotZero(y);
+    x = foldedX;
+    y = foldedY;
+  }
+
+  return {toSnorm16(x), toSnorm16(y)};
+}
+
+vm::vec3f unpackNormal(const vm::vec<GLshort, 2>& packedNormal)
+{
+  const auto x = fromSnorm16(packedNormal.x());
+  const auto y = fromSnorm16(packedNormal.y());
+  const auto z = 1.0f - std::abs(x) - std::abs(y);
+
+  if (z < 0.0f)
+  {
+    return vm::normalize(vm::vec3f{
+      (1.0f - std::abs(y)) * signNotZero(x), (1.0f - std::abs(x)) * signNotZero(y), z});
+  }
+  return vm::normalize(vm::vec3f{x, y, z});
+}
+
+} // namespace TrenchBroom::Renderer
@@ -0,0 +1,42 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Renderer/GL.h"
+
+#include "vm/forward.h"
+#include "vm/vec.h" // IWYU pragma: keep
+
+namespace TrenchBroom::Renderer
+{
+
+/**
+ * Encodes the given unit vector by projecting it onto an octahedron and unfolding the
+ * octahedron onto a square. The returned components are meant to be uploaded as
+ * normalized signed shorts and decoded by the vertex shader (see PackedNormal.vertsh).
+ */
+vm::vec<GLshort, 2> packNormal(const vm::vec3f& normal);
+
+/**
+ * Decodes a normal that was encoded with packNormal.
+ */
+vm::vec3f unpackNormal(const vm::vec<GLshort, 2>& packedNormal);
+
+} // namespace TrenchBroom::Renderer
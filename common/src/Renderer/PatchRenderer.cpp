@@ -31,6 +31,7 @@
 #include "Renderer/IndexRangeMapBuilder.h"
 #include "Renderer/MaterialIndexArrayMapBuilder.h"
 #include "Renderer/MaterialIndexArrayRenderer.h"
+#include "Renderer/PrimType.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/RenderUtils.h"
@@ -43,6 +44,8 @@
 #include "vm/forward.h"
 #include "vm/vec.h"
 
+#include <tuple>
+
 namespace TrenchBroom::Renderer
 {
 
@@ -138,6 +141,7 @@ void PatchRenderer::render(RenderContext& renderContext, RenderBatch& renderBatc
 
   if (renderContext.showFaces())
   {
+    cull(renderContext);
     renderBatch.add(this);
   }
 
@@ -151,7 +155,9 @@ void PatchRenderer::render(RenderContext& renderContext, RenderBatch& renderBatc
   }
 }
 
-static MaterialIndexArrayRenderer buildMeshRenderer(
+using PatchIndexRanges = std::vector<PatchRenderer::PatchIndexRange>;
+
+static std::tuple<MaterialIndexArrayRenderer, PatchIndexRanges> buildMeshRenderer(
   const std::vector<const Model::PatchNode*>& patchNodes,
   const Model::EditorContext& editorContext)
 {
@@ -178,6 +184,9 @@ static MaterialIndexArrayRenderer buildMeshRenderer(
   auto indexArrayMapBuilder = MaterialIndexArrayMapBuilder{indexArrayMapSize};
   using Index = MaterialIndexArrayMapBuilder::Index;
 
+  auto patchIndexRanges = PatchIndexRanges{};
+  patchIndexRanges.reserve(patchNodes.size());
+
   for (const auto* patchNode : patchNodes)
   {
     if (editorContext.visible(patchNode))
@@ -192,6 +201,10 @@ static MaterialIndexArrayRenderer buildMeshRenderer(
 
       const auto* material = patchNode->patch().material();
 
+      // collect the indices of the patch so that it occupies a contiguous range
+      auto indices = MaterialIndexArrayMapBuilder::IndexList{};
+      indices.reserve(6u * grid.quadRowCount() * grid.quadColumnCount());
+
       const auto pointsPerRow = grid.pointColumnCount;
       for (size_t row = 0u; row < grid.quadRowCount(); ++row)
       {
@@ -202,27 +215,28 @@ static MaterialIndexArrayRenderer buildMeshRenderer(
           const auto i2 = vertexOffset + (row + 1u) * pointsPerRow + col + 1u;
           const auto i3 = vertexOffset + (row + 1u) * pointsPerRow + col;
 
-          indexArrayMapBuilder.addTriangle(
-            material,
-            static_cast<Index>(i0),
-            static_cast<Index>(i1),
-            static_cast<Index>(i2));
-          indexArrayMapBuilder.addTriangle(
-            material,
-            static_cast<Index>(i2),
-            static_cast<Index>(i3),
-            static_cast<Index>(i0));
+          indices.push_back(static_cast<Index>(i0));
+          indices.push_back(static_cast<Index>(i1));
+          indices.push_back(static_cast<Index>(i2));
+          indices.push_back(static_cast<Index>(i2));
+          indices.push_back(static_cast<Index>(i3));
+          indices.push_back(static_cast<Index>(i0));
         }
       }
+
+      const auto offset = indexArrayMapBuilder.addTriangles(material, indices);
+      patchIndexRanges.push_back({patchNode, material, {offset, indices.size()}});
     }
   }
 
   auto vertexArray = VertexArray::move(std::move(vertices));
   auto indexArray = IndexArray::move(std::move(indexArrayMapBuilder.indices()));
-  return MaterialIndexArrayRenderer{
-    std::move(vertexArray),
-    std::move(indexArray),
-    std::move(indexArrayMapBuilder.ranges())};
+  return {
+    MaterialIndexArrayRenderer{
+      std::move(vertexArray),
+      std::move(indexArray),
+      std::move(indexArrayMapBuilder.ranges())},
+    std::move(patchIndexRanges)};
 }
 
 static DirectEdgeRenderer buildEdgeRenderer(
@@ -302,13 +316,49 @@ void PatchRenderer::validate()
 {
   if (!m_valid)
   {
-    m_patchMeshRenderer = buildMeshRenderer(m_patchNodes.get_data(), m_editorContext);
+    std::tie(m_patchMeshRenderer, m_patchIndexRanges) =
+      buildMeshRenderer(m_patchNodes.get_data(), m_editorContext);
     m_edgeRenderer = buildEdgeRenderer(m_patchNodes.get_data(), m_editorContext);
 
     m_valid = true;
   }
 }
 
+void PatchRenderer::cull(RenderContext& renderContext)
+{
+  const auto& visibleNodes = renderContext.visibleNodes();
+  if (!visibleNodes)
+  {
+    m_visibleIndexRanges = std::nullopt;
+    return;
+  }
+
+  auto visibleIndexRanges = MaterialToIndexRangesMap{};
+  size_t visibleIndexCount = 0u;
+  size_t culledIndexCount = 0u;
+
+  for (const auto& [patchNode, material, range] : m_patchIndexRanges)
+  {
+    if (visibleNodes->visible(patchNode))
+    {
+      visibleIndexRanges[material].push_back(range);
+      visibleIndexCount += range.count;
+    }
+    else
+    {
+      culledIndexCount += range.count;
+    }
+  }
+
+  for (auto& [material, ranges] : visibleIndexRanges)
+  {
+    ranges = mergeIndexRanges(std::move(ranges));
+  }
+
+  renderContext.cullingStats().add(visibleIndexCount / 3u, culledIndexCount / 3u);
+  m_visibleIndexRanges = std::move(visibleIndexRanges);
+}
+
 void PatchRenderer::prepareVerticesAndIndices(VboManager& vboManager)
 {
   m_patchMeshRenderer.prepare(vboManager);
@@ -417,7 +467,14 @@ void PatchRenderer::doRender(RenderContext& context)
   }
   */
 
-  m_patchMeshRenderer.render(func);
+  if (m_visibleIndexRanges)
+  {
+    m_patchMeshRenderer.render(func, PrimType::Triangles, *m_visibleIndexRanges);
+  }
+  else
+  {
+    m_patchMeshRenderer.render(func);
+  }
 
   /*
   if (m_alpha < 1.0f) {
@@ -21,11 +21,13 @@
 
 #include "Color.h"
 #include "Renderer/EdgeRenderer.h"
+#include "Renderer/FrustumCulling.h"
 #include "Renderer/MaterialIndexArrayRenderer.h"
 #include "Renderer/Renderable.h"
 
 #include "kdl/vector_set.h"
 
+#include <optional>
 #include <vector>
 
 namespace TrenchBroom::Model
@@ -42,6 +44,14 @@ class VboManager;
 
 class PatchRenderer : public IndexedRenderable
 {
+public:
+  struct PatchIndexRange
+  {
+    const Model::PatchNode* patchNode;
+    const Assets::Material* material;
+    IndexRange range;
+  };
+
 private:
   const Model::EditorContext& m_editorContext;
 
@@ -51,6 +61,17 @@ private:
   MaterialIndexArrayRenderer m_patchMeshRenderer;
   DirectEdgeRenderer m_edgeRenderer;
 
+  /**
+   * The range of triangle indices of every patch in the mesh renderer.
+   */
+  std::vector<PatchIndexRange> m_patchIndexRanges;
+
+  /**
+   * The index ranges of the visible patches, or nullopt if all patches should be
+   * rendered.
+   */
+  std::optional<MaterialToIndexRangesMap> m_visibleIndexRanges;
+
   Color m_defaultColor;
   bool m_grayscale = false;
   bool m_tint = false;
@@ -119,6 +140,7 @@ public:
 
 private:
   void validate();
+  void cull(RenderContext& renderContext);
 
 private: // implement IndexedRenderable interface
   void prepareVerticesAndIndices(VboManager& vboManager) override;
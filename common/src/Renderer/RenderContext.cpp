@@ -279,6 +279,36 @@ void RenderContext::setForceHideSelectionGuide()
   setShowSelectionGuide(ShowSelectionGuide::ForceHide);
 }
 
+const std::shared_ptr<const VisibleNodes>& RenderContext::visibleNodes() const
+{
+  return m_visibleNodes;
+}
+
+void RenderContext::setVisibleNodes(std::shared_ptr<const VisibleNodes> visibleNodes)
+{
+  m_visibleNodes = std::move(visibleNodes);
+}
+
+const CullingStats& RenderContext::cullingStats() const
+{
+  return m_cullingStats;
+}
+
+CullingStats& RenderContext::cullingStats()
+{
+  return m_cullingStats;
+}
+
+size_t RenderContext::entityModelDrawCalls() const
+{
+  return m_entityModelDrawCalls;
+}
+
+void RenderContext::addEntityModelDrawCalls(const size_t drawCalls)
+{
+  m_entityModelDrawCalls += drawCalls;
+}
+
 void RenderContext::setShowSelectionGuide(const ShowSelectionGuide showSelectionGuide)
 {
   switch (showSelectionGuide)
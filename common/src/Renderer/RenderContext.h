@@ -22,10 +22,13 @@
 #include "FloatType.h"
 #include "GL.h"
 #include "Macros.h"
+#include "Renderer/FrustumCulling.h"
 #include "Renderer/Transformation.h"
 
 #include "vm/bbox.h"
 
+#include <memory>
+
 namespace TrenchBroom::Renderer
 {
 class Camera;
@@ -85,6 +88,10 @@ private:
   ShowSelectionGuide m_showSelectionGuide = ShowSelectionGuide::Hide;
   vm::bbox3f m_softMapBounds;
 
+  std::shared_ptr<const VisibleNodes> m_visibleNodes;
+  CullingStats m_cullingStats;
+  size_t m_entityModelDrawCalls = 0;
+
 public:
   RenderContext(
     RenderMode renderMode,
@@ -163,6 +170,22 @@ public:
   void setForceShowSelectionGuide();
   void setForceHideSelectionGuide();
 
+  /**
+   * The nodes that intersect with the view frustum, or null if the renderers should not
+   * perform frustum culling.
+   */
+  const std::shared_ptr<const VisibleNodes>& visibleNodes() const;
+  void setVisibleNodes(std::shared_ptr<const VisibleNodes> visibleNodes);
+
+  const CullingStats& cullingStats() const;
+  CullingStats& cullingStats();
+
+  /**
+   * The number of draw calls issued to render entity models in this frame.
+   */
+  size_t entityModelDrawCalls() const;
+  void addEntityModelDrawCalls(size_t drawCalls);
+
 private:
   void setShowSelectionGuide(ShowSelectionGuide showSelectionGuide);
 };
@@ -196,13 +196,19 @@ void ShaderProgram::set(const std::string& name, const vm::mat4x4f& value)
 }
 
 GLint ShaderProgram::findAttributeLocation(const std::string& name) const
+{
+  const auto index = findOptionalAttributeLocation(name);
+  ensure(index != -1, "Attribute location found in shader program");
+  return index;
+}
+
+GLint ShaderProgram::findOptionalAttributeLocation(const std::string& name) const
 {
   auto it = m_attributeCache.find(name);
   if (it == std::end(m_attributeCache))
   {
     auto index = GLint(0);
     glAssert(index = glGetAttribLocation(m_programId, name.c_str()));
-    ensure(index != -1, "Attribute location found in shader program");
 
     auto inserted = false;
     std::tie(it, inserted) = m_attributeCache.emplace(name, index);
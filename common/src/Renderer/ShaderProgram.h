@@ -77,6 +77,11 @@ public:
 
   GLint findAttributeLocation(const std::string& name) const;
 
+  /**
+   * Returns the location of the given attribute or -1 if this program does not use it.
+   */
+  GLint findOptionalAttributeLocation(const std::string& name) const;
+
 private:
   GLint findUniformLocation(const std::string& name) const;
   bool checkActive() const;
@@ -48,12 +48,17 @@ const ShaderConfig EntityModelShader = ShaderConfig{
 };
 const ShaderConfig FaceShader = ShaderConfig{
   "Face",
-  {"Face.vertsh"},
+  {"Face.vertsh", "Normal.vertsh"},
+  {"Grid.fragsh", "MapBounds.fragsh", "Face.fragsh"},
+};
+const ShaderConfig PackedFaceShader = ShaderConfig{
+  "Packed Face",
+  {"Face.vertsh", "PackedNormal.vertsh"},
   {"Grid.fragsh", "MapBounds.fragsh", "Face.fragsh"},
 };
 const ShaderConfig PatchShader = ShaderConfig{
   "Patch",
-  {"Face.vertsh"},
+  {"Face.vertsh", "Normal.vertsh"},
   {"Grid.fragsh", "MapBounds.fragsh", "Face.fragsh"},
 };
 const ShaderConfig EdgeShader = ShaderConfig{
@@ -29,6 +29,7 @@ extern const ShaderConfig VaryingPUniformCShader;
 extern const ShaderConfig MiniMapEdgeShader;
 extern const ShaderConfig EntityModelShader;
 extern const ShaderConfig FaceShader;
+extern const ShaderConfig PackedFaceShader;
 extern const ShaderConfig PatchShader;
 extern const ShaderConfig EdgeShader;
 extern const ShaderConfig ColoredTextShader;
@@ -62,6 +62,7 @@ VboManager::VboManager(ShaderManager* shaderManager)
   : m_peakVboCount(0u)
   , m_currentVboCount(0u)
   , m_currentVboSize(0u)
+  , m_peakVboSize(0u)
   , m_shaderManager(shaderManager)
 {
 }
@@ -73,6 +74,7 @@ Vbo* VboManager::allocateVbo(VboType type, const size_t capacity, const VboUsage
   m_currentVboSize += capacity;
   m_currentVboCount++;
   m_peakVboCount = std::max(m_peakVboCount, m_currentVboCount);
+  m_peakVboSize = std::max(m_peakVboSize, m_currentVboSize);
 
   return result;
 }
@@ -101,6 +103,11 @@ size_t VboManager::currentVboSize() const
   return m_currentVboSize;
 }
 
+size_t VboManager::peakVboSize() const
+{
+  return m_peakVboSize;
+}
+
 ShaderManager& VboManager::shaderManager()
 {
   return *m_shaderManager;
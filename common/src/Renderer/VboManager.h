@@ -48,6 +48,7 @@ private:
   size_t m_peakVboCount;
   size_t m_currentVboCount;
   size_t m_currentVboSize;
+  size_t m_peakVboSize;
   ShaderManager* m_shaderManager;
 
 public:
@@ -62,6 +63,7 @@ public:
   size_t peakVboCount() const;
   size_t currentVboCount() const;
   size_t currentVboSize() const;
+  size_t peakVboSize() const;
 
   ShaderManager& shaderManager();
 };
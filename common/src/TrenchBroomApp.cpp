@@ -214,6 +214,7 @@ void TrenchBroomApp::parseCommandLineAndShowFrame()
 {
   auto parser = QCommandLineParser{};
   parser.addOption(QCommandLineOption("portable"));
+  parser.addOption(QCommandLineOption("threads", "Number of threads", "count"));
   parser.process(*this);
   openFilesOrWelcomeFrame(parser.positionalArguments());
 }
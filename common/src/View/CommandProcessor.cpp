@@ -32,6 +32,8 @@
 #include "kdl/vector_utils.h"
 
 #include <algorithm>
+#include <iterator>
+#include <limits>
 
 namespace TrenchBroom
 {
@@ -46,6 +48,21 @@ void notifyCommandIfNotType(T& notifier, C& command)
   }
 }
 
+namespace
+{
+/**
+ * Compacts the command that the most recently pushed command has moved out of the most
+ * recent commands on the given stack.
+ */
+void compactCommands(std::vector<std::unique_ptr<UndoableCommand>>& stack)
+{
+  if (stack.size() > UncompactedCommandCount)
+  {
+    stack[stack.size() - UncompactedCommandCount - 1]->compact();
+  }
+}
+} // namespace
+
 struct CommandProcessor::TransactionState
 {
   std::string name;
@@ -157,18 +174,62 @@ private:
 
     return false;
   }
+
+  size_t doGetMemoryUsage() const override
+  {
+    auto result = UndoableCommand::doGetMemoryUsage();
+    for (const auto& command : m_commands)
+    {
+      result += command->memoryUsage();
+    }
+    return result;
+  }
+
+  void doCompact() override
+  {
+    for (auto& command : m_commands)
+    {
+      command->compact();
+    }
+  }
 };
 
 CommandProcessor::CommandProcessor(
   MapDocumentCommandFacade* document, const std::chrono::milliseconds collationInterval)
   : m_document{document}
   , m_collationInterval{collationInterval}
+  , m_memoryBudget{std::numeric_limits<size_t>::max()}
   , m_lastCommandTimestamp{std::chrono::time_point<std::chrono::system_clock>{}}
 {
 }
 
 CommandProcessor::~CommandProcessor() = default;
 
+size_t CommandProcessor::memoryUsage() const
+{
+  auto result = size_t{0};
+  for (const auto& command : m_undoStack)
+  {
+    result += command->memoryUsage();
+  }
+  for (const auto& command : m_redoStack)
+  {
+    result += command->memoryUsage();
+  }
+  return result;
+}
+
+size_t CommandProcessor::memoryBudget() const
+{
+  return m_memoryBudget;
+}
+
+void CommandProcessor::setMemoryBudget(const size_t memoryBudget)
+{
+  m_memoryBudget = memoryBudget;
+  enforceMemoryBudget();
+}
+
 bool CommandProcessor::canUndo() const
 {
   return m_transactionStack.empty() && !m_undoStack.empty();
@@ -445,14 +506,39 @@ bool CommandProcessor::pushToUndoStack(
     auto& lastCommand = m_undoStack.back();
     if (lastCommand->collateWith(*command))
     {
+      enforceMemoryBudget();
       return false;
     }
   }
 
   m_undoStack.push_back(std::move(command));
+  compactCommands(m_undoStack);
+  enforceMemoryBudget();
   return true;
 }
 
+void CommandProcessor::enforceMemoryBudget()
+{
+  if (!m_transactionStack.empty())
+  {
+    return;
+  }
+
+  auto usage = memoryUsage();
+
+  // the oldest commands are at the beginning of the undo stack, the most recently executed
+  // command is always retained
+  auto evictCount = size_t{0};
+  while (usage > m_memoryBudget && evictCount + 1 < m_undoStack.size())
+  {
+    usage -= m_undoStack[evictCount]->memoryUsage();
+    ++evictCount;
+  }
+
+  m_undoStack.erase(
+    m_undoStack.begin(), std::next(m_undoStack.begin(), std::ptrdiff_t(evictCount)));
+}
+
 std::unique_ptr<UndoableCommand> CommandProcessor::popFromUndoStack()
 {
   assert(m_transactionStack.empty());
@@ -472,6 +558,7 @@ void CommandProcessor::pushToRedoStack(std::unique_ptr<UndoableCommand> command)
 {
   assert(m_transactionStack.empty());
   m_redoStack.push_back(std::move(command));
+  compactCommands(m_redoStack);
 }
 
 std::unique_ptr<UndoableCommand> CommandProcessor::popFromRedoStack()
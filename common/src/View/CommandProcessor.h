@@ -36,6 +36,12 @@ class MapDocumentCommandFacade;
 class UndoableCommand;
 enum class TransactionScope;
 
+/**
+ * The number of most recent commands on the undo stack and on the redo stack that are
+ * kept intact. Older commands are compacted, see UndoableCommand::compact.
+ */
+constexpr size_t UncompactedCommandCount = 16;
+
 /**
  * The command processor is responsible for executing and undoing commands and for
  * maintining the command history in the form of a stack of undo commands and a stack of
@@ -67,6 +73,12 @@ private:
    */
   std::chrono::milliseconds m_collationInterval;
 
+  /**
+   * The maximum number of bytes of memory that the undo and redo stacks may hold. If the
+   * budget is exceeded, the oldest commands are removed from the undo stack.
+   */
+  size_t m_memoryBudget;
+
   /**
    * Holds the commands that were executed so far, with the most recently executed command
    * at the end of the vector.
@@ -146,6 +158,25 @@ public:
    */
   Notifier<const std::string&> transactionUndoneNotifier;
 
+  /**
+   * Returns an estimate of the number of bytes of memory held by the commands on the undo
+   * and redo stacks.
+   */
+  size_t memoryUsage() const;
+
+  /**
+   * Returns the maximum number of bytes of memory that the undo and redo stacks may hold.
+   */
+  size_t memoryBudget() const;
+
+  /**
+   * Sets the maximum number of bytes of memory that the undo and redo stacks may hold.
+   * Whenever a command is stored and the budget is exceeded, the oldest commands are
+   * removed from the undo stack until the budget is met. The most recently executed
+   * command is never removed.
+   */
+  void setMemoryBudget(size_t memoryBudget);
+
   /**
    * Indicates whether there is any command on the undo stack.
    */
@@ -365,6 +396,13 @@ private:
    */
   bool pushToUndoStack(std::unique_ptr<UndoableCommand> command, bool collate);
 
+  /**
+   * Removes the oldest commands from the undo stack until the memory held by the undo
+   * and redo stacks does not exceed the memory budget. Does nothing while a transaction
+   * is executing.
+   */
+  void enforceMemoryBudget();
+
   /**
    * Pops the topmost command from the undo stack and returns it.
    *
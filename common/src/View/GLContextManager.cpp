@@ -93,6 +93,7 @@ bool GLContextManager::initialize()
         MiniMapEdgeShader,
         EntityModelShader,
         FaceShader,
+        PackedFaceShader,
         PatchShader,
         EdgeShader,
         ColoredTextShader,
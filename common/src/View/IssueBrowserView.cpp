@@ -109,6 +109,11 @@ void IssueBrowserView::deselectAll()
   m_tableView->clearSelection();
 }
 
+const std::vector<Model::ValidatorStats>& IssueBrowserView::validatorStats() const
+{
+  return m_validatorStats;
+}
+
 /**
  * Updates the MapDocument selection to match the table view
  */
@@ -137,38 +142,43 @@ void IssueBrowserView::updateIssues()
   {
     const auto validators = document->world()->registeredValidators();
 
-    auto issues = std::vector<const Model::Issue*>{};
-    const auto collectIssues = [&](auto* node) {
-      for (auto* issue : node->issues(validators))
-      {
-        if (
-          m_showHiddenIssues
-          || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0))
-        {
-          issues.push_back(issue);
-        }
-      }
-    };
-
+    auto nodes = std::vector<Model::Node*>{};
     document->world()->accept(kdl::overload(
       [&](auto&& thisLambda, Model::WorldNode* world) {
-        collectIssues(world);
+        nodes.push_back(world);
         world->visitChildren(thisLambda);
       },
       [&](auto&& thisLambda, Model::LayerNode* layer) {
-        collectIssues(layer);
+        nodes.push_back(layer);
         layer->visitChildren(thisLambda);
       },
       [&](auto&& thisLambda, Model::GroupNode* group) {
-        collectIssues(group);
+        nodes.push_back(group);
         group->visitChildren(thisLambda);
       },
       [&](auto&& thisLambda, Model::EntityNode* entity) {
-        collectIssues(entity);
+        nodes.push_back(entity);
         entity->visitChildren(thisLambda);
       },
-      [&](Model::BrushNode* brush) { collectIssues(brush); },
-      [&](Model::PatchNode* patch) { collectIssues(patch); }));
+      [&](Model::BrushNode* brush) { nodes.push_back(brush); },
+      [&](Model::PatchNode* patch) { nodes.push_back(patch); }));
+
+    // only nodes whose issues were invalidated since the last update are validated again
+    m_validatorStats = Model::validateIssues(nodes, validators);
+
+    auto issues = std::vector<const Model::Issue*>{};
+    for (auto* node : nodes)
+    {
+      for (auto* issue : node->issues(validators))
+      {
+        if (
+          m_showHiddenIssues
+          || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0))
+        {
+          issues.push_back(issue);
+        }
+      }
+    }
 
     issues = kdl::vec_sort(std::move(issues), [](const auto* lhs, const auto* rhs) {
       return lhs->seqId() > rhs->seqId();
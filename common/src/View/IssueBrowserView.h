@@ -23,6 +23,7 @@
 #include <QWidget>
 
 #include "Model/IssueType.h"
+#include "Model/IssueValidation.h"
 
 #include <memory>
 #include <vector>
@@ -53,6 +54,7 @@ private:
   bool m_showHiddenIssues;
 
   bool m_valid;
+  std::vector<Model::ValidatorStats> m_validatorStats;
 
   QTableView* m_tableView;
   IssueBrowserModel* m_tableModel;
@@ -71,6 +73,11 @@ public:
   void reload();
   void deselectAll();
 
+  /**
+   * Returns the time spent in each validator during the last update of the issues.
+   */
+  const std::vector<Model::ValidatorStats>& validatorStats() const;
+
 private:
   void updateIssues();
 
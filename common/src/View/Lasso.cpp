@@ -20,8 +20,14 @@
 #include "Lasso.h"
 
 #include "FloatType.h"
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/HitFilter.h"
+#include "Model/PatchNode.h"
+#include "Model/PickResult.h"
 #include "Renderer/Camera.h"
 #include "Renderer/RenderService.h"
+#include "View/MapDocument.h"
 
 #include "kdl/optional_utils.h"
 
@@ -49,10 +55,68 @@ void Lasso::update(const vm::vec3& point)
   m_cur = point;
 }
 
+vm::vec3 Lasso::position(const vm::vec3& point)
+{
+  return point;
+}
+
+vm::vec3 Lasso::position(const vm::segment3& edge)
+{
+  return edge.center();
+}
+
+vm::vec3 Lasso::position(const vm::polygon3& polygon)
+{
+  return polygon.center();
+}
+
+std::vector<bool> Lasso::visible(
+  const MapDocument& document, const std::vector<vm::vec3>& points) const
+{
+  if (!m_camera.perspectiveProjection())
+  {
+    // 2D views show everything on top of each other
+    return std::vector<bool>(points.size(), true);
+  }
+
+  // faces that touch a point are hit at roughly the point's distance, don't let them
+  // occlude it
+  constexpr auto OcclusionEpsilon = FloatType(0.1);
+
+  auto rays = std::vector<vm::ray3>{};
+  rays.reserve(points.size());
+  for (const auto& point : points)
+  {
+    rays.emplace_back(m_camera.pickRay(vm::vec3f{point}));
+  }
+
+  auto pickResults =
+    std::vector<Model::PickResult>(points.size(), Model::PickResult::byDistance());
+  document.pick(rays, pickResults);
+
+  using namespace Model::HitFilters;
+  auto result = std::vector<bool>{};
+  result.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const auto pointDistance = vm::dot(points[i] - rays[i].origin, rays[i].direction);
+    const auto& hit = pickResults[i].first(
+      type(
+        Model::BrushNode::BrushHitType | Model::PatchNode::PatchHitType
+        | Model::EntityNode::EntityHitType)
+      && !transitivelySelected());
+    result.push_back(!hit.isMatch() || hit.distance() > pointDistance - OcclusionEpsilon);
+  }
+  return result;
+}
+
 bool Lasso::selects(
-  const vm::vec3& point, const vm::plane3& plane, const vm::bbox2& box) const
+  const vm::vec3& point,
+  const vm::plane3& plane,
+  const vm::mat4x4& transform,
+  const vm::bbox2& box) const
 {
-  if (const auto projected = project(point, plane))
+  if (const auto projected = project(point, plane, transform))
   {
     return box.contains(vm::vec2{*projected});
   }
@@ -60,25 +124,31 @@ bool Lasso::selects(
 }
 
 bool Lasso::selects(
-  const vm::segment3& edge, const vm::plane3& plane, const vm::bbox2& box) const
+  const vm::segment3& edge,
+  const vm::plane3& plane,
+  const vm::mat4x4& transform,
+  const vm::bbox2& box) const
 {
-  return selects(edge.center(), plane, box);
+  return selects(edge.center(), plane, transform, box);
 }
 
 bool Lasso::selects(
-  const vm::polygon3& polygon, const vm::plane3& plane, const vm::bbox2& box) const
+  const vm::polygon3& polygon,
+  const vm::plane3& plane,
+  const vm::mat4x4& transform,
+  const vm::bbox2& box) const
 {
-  return selects(polygon.center(), plane, box);
+  return selects(polygon.center(), plane, transform, box);
 }
 
 std::optional<vm::vec3> Lasso::project(
-  const vm::vec3& point, const vm::plane3& plane) const
+  const vm::vec3& point, const vm::plane3& plane, const vm::mat4x4& transform) const
 {
   const auto ray = vm::ray3{m_camera.pickRay(vm::vec3f{point})};
   return kdl::optional_transform(
     vm::intersect_ray_plane(ray, plane), [&](const auto hitDistance) {
       const auto hitPoint = vm::point_at_distance(ray, hitDistance);
-      return getTransform() * hitPoint;
+      return transform * hitPoint;
     });
 }
 
@@ -23,6 +23,11 @@
 
 #include "vm/bbox.h"
 #include "vm/plane.h"
+#include "vm/polygon.h"
+#include "vm/segment.h"
+
+#include <iterator>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -35,6 +40,8 @@ class RenderContext;
 
 namespace View
 {
+class MapDocument;
+
 class Lasso
 {
 private:
@@ -51,11 +58,13 @@ public:
   template <typename I, typename O>
   void selected(I cur, I end, O out) const
   {
+    // the plane, transform and box are the same for every point, so compute them once
     const auto plane = getPlane();
-    const auto box = getBox(getTransform());
+    const auto transform = getTransform();
+    const auto box = getBox(transform);
     while (cur != end)
     {
-      if (selects(*cur, plane, box))
+      if (selects(*cur, plane, transform, box))
       {
         out = *cur;
       }
@@ -63,14 +72,59 @@ public:
     }
   }
 
+  /**
+   * Like selected, but skips the points that are hidden behind an unselected object in a
+   * perspective view. The occlusion test casts one pick ray per point inside the lasso
+   * and picks all of them with a single traversal of the document's node tree.
+   */
+  template <typename I, typename O>
+  void selectedVisible(const MapDocument& document, I cur, I end, O out) const
+  {
+    auto candidates = std::vector<typename std::iterator_traits<I>::value_type>{};
+    selected(cur, end, std::back_inserter(candidates));
+
+    auto positions = std::vector<vm::vec3>{};
+    positions.reserve(candidates.size());
+    for (const auto& candidate : candidates)
+    {
+      positions.push_back(position(candidate));
+    }
+
+    const auto visible = this->visible(document, positions);
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+      if (visible[i])
+      {
+        out = candidates[i];
+      }
+    }
+  }
+
 private:
+  static vm::vec3 position(const vm::vec3& point);
+  static vm::vec3 position(const vm::segment3& edge);
+  static vm::vec3 position(const vm::polygon3& polygon);
+
+  std::vector<bool> visible(
+    const MapDocument& document, const std::vector<vm::vec3>& points) const;
+
   bool selects(
-    const vm::vec3& point, const vm::plane3& plane, const vm::bbox2& box) const;
+    const vm::vec3& point,
+    const vm::plane3& plane,
+    const vm::mat4x4& transform,
+    const vm::bbox2& box) const;
   bool selects(
-    const vm::segment3& edge, const vm::plane3& plane, const vm::bbox2& box) const;
+    const vm::segment3& edge,
+    const vm::plane3& plane,
+    const vm::mat4x4& transform,
+    const vm::bbox2& box) const;
   bool selects(
-    const vm::polygon3& polygon, const vm::plane3& plane, const vm::bbox2& box) const;
-  std::optional<vm::vec3> project(const vm::vec3& point, const vm::plane3& plane) const;
+    const vm::polygon3& polygon,
+    const vm::plane3& plane,
+    const vm::mat4x4& transform,
+    const vm::bbox2& box) const;
+  std::optional<vm::vec3> project(
+    const vm::vec3& point, const vm::plane3& plane, const vm::mat4x4& transform) const;
 
 public:
   void render(
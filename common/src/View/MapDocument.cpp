@@ -28,6 +28,7 @@
 #include "Assets/Material.h"
 #include "Assets/MaterialManager.h"
 #include "Assets/ResourceManager.h"
+#include "Assets/TaskScheduler.h"
 #include "Assets/Texture.h"
 #include "EL/ELExceptions.h"
 #include "Error.h"
@@ -73,6 +74,7 @@
 #include "Model/Node.h"
 #include "Model/NodeContents.h"
 #include "Model/NodeQueries.h"
+#include "Model/NodeTreeType.h"
 #include "Model/NonIntegerVerticesValidator.h"
 #include "Model/PatchNode.h"
 #include "Model/PointEntityWithBrushesValidator.h"
@@ -129,6 +131,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdlib> // for std::abs
 #include <map>
 #include <mutex>
@@ -136,6 +139,7 @@
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom::View
@@ -381,7 +385,9 @@ const std::string MapDocument::DefaultDocumentName("unnamed.map");
 MapDocument::MapDocument()
   : m_worldBounds(DefaultWorldBounds)
   , m_world(nullptr)
-  , m_resourceManager(std::make_unique<Assets::ResourceManager>())
+  , m_resourceTaskScheduler(std::make_unique<Assets::TaskScheduler>())
+  , m_resourceManager(std::make_unique<Assets::ResourceManager>(
+      2 * m_resourceTaskScheduler->threadCount()))
   , m_entityDefinitionManager(std::make_unique<Assets::EntityDefinitionManager>())
   , m_entityModelManager(std::make_unique<Assets::EntityModelManager>(
       [&](auto resourceLoader) {
@@ -404,6 +410,11 @@ MapDocument::MapDocument()
   , m_selectionBoundsValid(true)
   , m_viewEffectsService(nullptr)
   , m_repeatStack(std::make_unique<RepeatStack>())
+  , m_nodeChangeBatch(
+      nodesWillChangeNotifier,
+      nodesDidChangeNotifier,
+      nodesWillChangeUnbatchedNotifier,
+      nodesDidChangeUnbatchedNotifier)
 {
   connectObservers();
 }
@@ -419,6 +430,9 @@ MapDocument::~MapDocument()
     unloadPortalFile();
   }
   clearWorld();
+
+  // wait for running loader tasks before the resources they refer to are destroyed
+  m_resourceTaskScheduler.reset();
 }
 
 Logger& MapDocument::logger()
@@ -1282,8 +1296,7 @@ void MapDocument::selectSiblings()
 void MapDocument::selectTouching(const bool del)
 {
   const auto nodes = kdl::vec_filter(
-    Model::collectTouchingNodes(
-      std::vector<Model::Node*>{m_world.get()}, m_selectedNodes.brushes()),
+    Model::collectTouchingNodes(*m_world, m_selectedNodes.brushes()),
     [&](Model::Node* node) { return m_editorContext->selectable(node); });
 
   auto transaction = Transaction{*this, "Select Touching"};
@@ -1302,8 +1315,7 @@ void MapDocument::selectTouching(const bool del)
 void MapDocument::selectInside(const bool del)
 {
   const auto nodes = kdl::vec_filter(
-    Model::collectContainedNodes(
-      std::vector<Model::Node*>{m_world.get()}, m_selectedNodes.brushes()),
+    Model::collectContainedNodes(*m_world, m_selectedNodes.brushes()),
     [&](Model::Node* node) { return m_editorContext->selectable(node); });
 
   auto transaction = Transaction{*this, "Select Inside"};
@@ -1505,7 +1517,7 @@ void MapDocument::selectTall(const vm::axis::type cameraAxis)
 
         const auto nodesToSelect = kdl::vec_filter(
           Model::collectContainedNodes(
-            {world()},
+            *world(),
             kdl::vec_transform(tallBrushes, [](const auto& b) { return b.get(); })),
           [&](const auto* node) { return editorContext().selectable(node); });
         selectNodes(nodesToSelect);
@@ -3152,19 +3164,24 @@ bool MapDocument::csgSubtract()
   const auto subtrahends = kdl::vec_transform(
     subtrahendNodes, [](const auto* subtrahendNode) { return &subtrahendNode->brush(); });
 
+  // subtract from the minuends in parallel, the results are in the order of the minuends
+  const auto mapFormat = m_world->mapFormat();
+  const auto& materialName = currentMaterialName();
+  auto subtractionResults =
+    kdl::vec_parallel_transform(minuendNodes, [&](const auto* minuendNode) {
+      return minuendNode->brush().subtract(
+        mapFormat, m_worldBounds, materialName, subtrahends);
+    });
+
   auto toAdd = std::map<Model::Node*, std::vector<Model::Node*>>{};
   auto toRemove =
     std::vector<Model::Node*>{std::begin(subtrahendNodes), std::end(subtrahendNodes)};
 
   return kdl::vec_transform(
            minuendNodes,
-           [&](auto* minuendNode) {
-             const auto& minuend = minuendNode->brush();
-             auto currentSubtractionResults = minuend.subtract(
-               m_world->mapFormat(), m_worldBounds, currentMaterialName(), subtrahends);
-
+           [&](auto* minuendNode, const size_t i) {
              return kdl::vec_filter(
-                      std::move(currentSubtractionResults),
+                      std::move(subtractionResults[i]),
                       [](const auto r) { return r | kdl::is_success(); })
                     | kdl::fold | kdl::transform([&](auto currentBrushes) {
                         if (!currentBrushes.empty())
@@ -3251,25 +3268,35 @@ bool MapDocument::csgHollow()
     return false;
   }
 
+  // hollow the brushes in parallel, the results are in the order of the brushes
+  const auto mapFormat = m_world->mapFormat();
+  const auto& materialName = currentMaterialName();
+  const auto thickness = FloatType(m_grid->actualSize());
+  auto hollowResults =
+    kdl::vec_parallel_transform(brushNodes, [&](const auto* brushNode) {
+      const auto& originalBrush = brushNode->brush();
+
+      auto shrunkenBrush = originalBrush;
+      return shrunkenBrush.expand(m_worldBounds, -thickness, true)
+             | kdl::transform([&]() {
+                 return originalBrush.subtract(
+                   mapFormat, m_worldBounds, materialName, shrunkenBrush);
+               });
+    });
+
   bool didHollowAnything = false;
   auto toAdd = std::map<Model::Node*, std::vector<Model::Node*>>{};
   auto toRemove = std::vector<Model::Node*>{};
 
-  for (auto* brushNode : brushNodes)
+  for (size_t i = 0; i < brushNodes.size(); ++i)
   {
-    const auto& originalBrush = brushNode->brush();
-
-    auto shrunkenBrush = originalBrush;
-    shrunkenBrush.expand(m_worldBounds, -FloatType(m_grid->actualSize()), true)
-      | kdl::and_then([&]() {
+    auto* brushNode = brushNodes[i];
+    std::move(hollowResults[i])
+      | kdl::and_then([&](auto subtractionResults) {
           didHollowAnything = true;
 
-          return originalBrush.subtract(
-                   m_world->mapFormat(),
-                   m_worldBounds,
-                   currentMaterialName(),
-                   shrunkenBrush)
-                 | kdl::fold | kdl::transform([&](auto fragments) {
+          return std::move(subtractionResults) | kdl::fold
+                 | kdl::transform([&](auto fragments) {
                      auto fragmentNodes =
                        kdl::vec_transform(std::move(fragments), [](auto&& b) {
                          return new Model::BrushNode{std::forward<decltype(b)>(b)};
@@ -4188,8 +4215,10 @@ const std::string& MapDocument::redoCommandName() const
 
 void MapDocument::undoCommand()
 {
+  m_nodeChangeBatch.begin();
   doUndoCommand();
   updateLinkedGroups();
+  endNodeChangeBatch();
 
   // Undo/redo in the repeat system is not supported for now, so just clear the repeat
   // stack
@@ -4198,8 +4227,10 @@ void MapDocument::undoCommand()
 
 void MapDocument::redoCommand()
 {
+  m_nodeChangeBatch.begin();
   doRedoCommand();
   updateLinkedGroups();
+  endNodeChangeBatch();
 
   // Undo/redo in the repeat system is not supported for now, so just clear the repeat
   // stack
@@ -4226,6 +4257,12 @@ void MapDocument::startTransaction(std::string name, const TransactionScope scop
   debug("Starting transaction '" + name + "'");
   doStartTransaction(std::move(name), scope);
   m_repeatStack->startTransaction();
+
+  m_transactionScopes.push_back(scope);
+  if (scope == TransactionScope::Oneshot)
+  {
+    m_nodeChangeBatch.begin();
+  }
 }
 
 void MapDocument::rollbackTransaction()
@@ -4247,6 +4284,7 @@ bool MapDocument::commitTransaction()
 
   doCommitTransaction();
   m_repeatStack->commitTransaction();
+  finishTransaction();
   return true;
 }
 
@@ -4257,6 +4295,31 @@ void MapDocument::cancelTransaction()
   m_repeatStack->rollbackTransaction();
   doCommitTransaction();
   m_repeatStack->commitTransaction();
+  finishTransaction();
+}
+
+void MapDocument::finishTransaction()
+{
+  assert(!m_transactionScopes.empty());
+  const auto scope = m_transactionScopes.back();
+  m_transactionScopes.pop_back();
+
+  if (scope == TransactionScope::Oneshot)
+  {
+    endNodeChangeBatch();
+  }
+}
+
+void MapDocument::endNodeChangeBatch()
+{
+  const auto startTime = std::chrono::steady_clock::now();
+  if (const auto nodeCount = m_nodeChangeBatch.end(); nodeCount > 0)
+  {
+    const auto duration = std::chrono::duration<double, std::milli>{
+      std::chrono::steady_clock::now() - startTime};
+    debug() << "Notified listeners of " << nodeCount << " changed nodes in "
+            << duration.count() << "ms";
+  }
 }
 
 std::unique_ptr<CommandResult> MapDocument::execute(std::unique_ptr<Command>&& command)
@@ -4297,7 +4360,7 @@ void MapDocument::processResourcesSync(const Assets::ProcessContext& processCont
 void MapDocument::processResourcesAsync(const Assets::ProcessContext& processContext)
 {
   const auto processedResourceIds = m_resourceManager->process(
-    [](auto task) { return std::async(std::move(task)); },
+    [&](auto task) { return m_resourceTaskScheduler->run(std::move(task)); },
     processContext,
     std::chrono::milliseconds{20});
 
@@ -4312,6 +4375,11 @@ bool MapDocument::needsResourceProcessing()
   return m_resourceManager->needsProcessing();
 }
 
+Assets::TaskSchedulerStats MapDocument::resourceTaskStats() const
+{
+  return m_resourceTaskScheduler->stats();
+}
+
 void MapDocument::pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const
 {
   if (m_world)
@@ -4320,6 +4388,16 @@ void MapDocument::pick(const vm::ray3& pickRay, Model::PickResult& pickResult) c
   }
 }
 
+void MapDocument::pick(
+  const std::vector<vm::ray3>& pickRays,
+  std::vector<Model::PickResult>& pickResults) const
+{
+  if (m_world)
+  {
+    m_world->pick(*m_editorContext, pickRays, pickResults);
+  }
+}
+
 std::vector<Model::Node*> MapDocument::findNodesContaining(const vm::vec3& point) const
 {
   auto result = std::vector<Model::Node*>{};
@@ -4330,6 +4408,17 @@ std::vector<Model::Node*> MapDocument::findNodesContaining(const vm::vec3& point
   return result;
 }
 
+/**
+ * Returns the configured node tree type, or the octree if the preference does not name a
+ * valid node tree type.
+ */
+static Model::NodeTreeType nodeTreeTypePreference()
+{
+  return pref(Preferences::NodeTreeType) == static_cast<int>(Model::NodeTreeType::Bvh)
+           ? Model::NodeTreeType::Bvh
+           : Model::NodeTreeType::Octree;
+}
+
 Result<void> MapDocument::createWorld(
   const Model::MapFormat mapFormat,
   const vm::bbox3& worldBounds,
@@ -4340,6 +4429,7 @@ Result<void> MapDocument::createWorld(
              m_worldBounds = worldBounds;
              m_game = game;
              m_world = std::move(world);
+             m_world->setNodeTreeType(nodeTreeTypePreference());
              m_entityModelManager->setGame(game.get());
              performSetCurrentLayer(m_world->defaultLayer());
 
@@ -4359,6 +4449,7 @@ Result<void> MapDocument::loadWorld(
              m_worldBounds = worldBounds;
              m_game = game;
              m_world = std::move(world);
+             m_world->setNodeTreeType(nodeTreeTypePreference());
              m_entityModelManager->setGame(game.get());
              performSetCurrentLayer(m_world->defaultLayer());
 
@@ -4411,8 +4502,7 @@ void MapDocument::setEntityDefinitions(
 void MapDocument::reloadMaterialCollections()
 {
   const auto nodes = std::vector<Model::Node*>{m_world.get()};
-  NotifyBeforeAndAfter notifyNodes(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+  NotifyBeforeAndAfterInBatch notifyNodes(m_nodeChangeBatch, nodes);
   NotifyBeforeAndAfter notifyMaterialCollections(
     materialCollectionsWillChangeNotifier, materialCollectionsDidChangeNotifier);
 
@@ -4424,8 +4514,7 @@ void MapDocument::reloadMaterialCollections()
 void MapDocument::reloadEntityDefinitions()
 {
   const auto nodes = std::vector<Model::Node*>{m_world.get()};
-  NotifyBeforeAndAfter notifyNodes(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+  NotifyBeforeAndAfterInBatch notifyNodes(m_nodeChangeBatch, nodes);
   NotifyBeforeAndAfter notifyEntityDefinitions(
     entityDefinitionsWillChangeNotifier, entityDefinitionsDidChangeNotifier);
 
@@ -4609,7 +4698,8 @@ static auto makeSetMaterialsVisitor(Assets::MaterialManager& manager)
       for (size_t i = 0u; i < brush.faceCount(); ++i)
       {
         const Model::BrushFace& face = brush.face(i);
-        Assets::Material* material = manager.material(face.attributes().materialName());
+        Assets::Material* material =
+          manager.material(face.attributes().internedMaterialName());
         brushNode->setFaceMaterial(i, material);
       }
     },
@@ -4656,7 +4746,8 @@ void MapDocument::setMaterials(const std::vector<Model::BrushFaceHandle>& faceHa
   {
     Model::BrushNode* node = faceHandle.node();
     const Model::BrushFace& face = faceHandle.face();
-    auto* material = m_materialManager->material(face.attributes().materialName());
+    auto* material =
+      m_materialManager->material(face.attributes().internedMaterialName());
     node->setFaceMaterial(faceHandle.faceIndex(), material);
   }
   materialUsageCountsDidChangeNotifier();
@@ -5139,6 +5230,9 @@ void MapDocument::connectObservers()
     nodesWillBeRemovedNotifier.connect(this, &MapDocument::clearNodeTags);
   m_notifierConnection +=
     nodesDidChangeNotifier.connect(this, &MapDocument::updateNodeTags);
+
+  m_notifierConnection +=
+    nodesWereRemovedNotifier.connect(this, &MapDocument::discardChangesOfRemovedNodes);
   m_notifierConnection +=
     brushFacesDidChangeNotifier.connect(this, &MapDocument::updateFaceTags);
   m_notifierConnection +=
@@ -5198,6 +5292,10 @@ void MapDocument::preferenceDidChange(const std::filesystem::path& path)
     reloadMaterials();
     setMaterials();
   }
+  else if (path == Preferences::NodeTreeType.path() && m_world)
+  {
+    m_world->setNodeTreeType(nodeTreeTypePreference());
+  }
 }
 
 void MapDocument::commandDone(Command& command)
@@ -5220,6 +5318,29 @@ void MapDocument::transactionUndone(const std::string& name)
   debug() << "Transaction '" << name << "' undone";
 }
 
+void MapDocument::discardChangesOfRemovedNodes(const std::vector<Model::Node*>& nodes)
+{
+  if (!m_nodeChangeBatch.open())
+  {
+    return;
+  }
+
+  // removed nodes can be deleted before the batch ends, so they must not be passed to the
+  // listeners
+  const auto removedNodes =
+    std::unordered_set<const Model::Node*>{nodes.begin(), nodes.end()};
+  m_nodeChangeBatch.discardIf([&](const Model::Node* node) {
+    for (; node != nullptr; node = node->parent())
+    {
+      if (removedNodes.count(node) > 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  });
+}
+
 Transaction::Transaction(std::weak_ptr<MapDocument> document, std::string name)
   : Transaction{kdl::mem_lock(document), std::move(name)}
 {
@@ -59,6 +59,8 @@ class MaterialManager;
 struct ProcessContext;
 class ResourceId;
 class ResourceManager;
+class TaskScheduler;
+struct TaskSchedulerStats;
 } // namespace TrenchBroom::Assets
 
 namespace TrenchBroom::Model
@@ -123,6 +125,7 @@ protected:
   std::optional<PointFile> m_pointFile;
   std::optional<PortalFile> m_portalFile;
 
+  std::unique_ptr<Assets::TaskScheduler> m_resourceTaskScheduler;
   std::unique_ptr<Assets::ResourceManager> m_resourceManager;
   std::unique_ptr<Assets::EntityDefinitionManager> m_entityDefinitionManager;
   std::unique_ptr<Assets::EntityModelManager> m_entityModelManager;
@@ -190,6 +193,14 @@ public: // notification
   Notifier<const std::vector<Model::Node*>&> nodesWillChangeNotifier;
   Notifier<const std::vector<Model::Node*>&> nodesDidChangeNotifier;
 
+  /**
+   * Like nodesWillChangeNotifier and nodesDidChangeNotifier, but never coalesced. Each
+   * notification of the former is followed by the matching notification of the latter
+   * before the command that changes the nodes is done or undone.
+   */
+  Notifier<const std::vector<Model::Node*>&> nodesWillChangeUnbatchedNotifier;
+  Notifier<const std::vector<Model::Node*>&> nodesDidChangeUnbatchedNotifier;
+
   Notifier<const std::vector<Model::Node*>&> nodeVisibilityDidChangeNotifier;
   Notifier<const std::vector<Model::Node*>&> nodeLockingDidChangeNotifier;
 
@@ -217,7 +228,16 @@ public: // notification
   Notifier<> portalFileWasLoadedNotifier;
   Notifier<> portalFileWasUnloadedNotifier;
 
+protected:
+  /**
+   * Coalesces the node change notifications while a oneshot transaction, an undo or a
+   * redo is executing because their intermediate states cannot be observed. Listeners
+   * are notified once of all changed nodes when the outermost of these ends.
+   */
+  NotificationBatch<Model::Node*> m_nodeChangeBatch;
+
 private:
+  std::vector<TransactionScope> m_transactionScopes;
   NotifierConnection m_notifierConnection;
 
 protected:
@@ -663,6 +683,9 @@ public: // transactions
   virtual bool isCurrentDocumentStateObservable() const = 0;
 
 private:
+  void finishTransaction();
+  void endNodeChangeBatch();
+
   std::unique_ptr<CommandResult> execute(std::unique_ptr<Command>&& command);
   std::unique_ptr<CommandResult> executeAndStore(
     std::unique_ptr<UndoableCommand>&& command);
@@ -688,9 +711,17 @@ public: // asset state management
   void processResourcesSync(const Assets::ProcessContext& processContext);
   void processResourcesAsync(const Assets::ProcessContext& processContext);
   bool needsResourceProcessing();
+  Assets::TaskSchedulerStats resourceTaskStats() const;
 
 public: // picking
   void pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const;
+  /**
+   * Picks with all of the given rays at once, see Model::WorldNode::pick. There must be
+   * one pick result for every ray.
+   */
+  void pick(
+    const std::vector<vm::ray3>& pickRays,
+    std::vector<Model::PickResult>& pickResults) const;
   std::vector<Model::Node*> findNodesContaining(const vm::vec3& point) const;
 
 private: // world management
@@ -825,6 +856,7 @@ private: // observers
   void commandUndone(UndoableCommand& command);
   void transactionDone(const std::string& name);
   void transactionUndone(const std::string& name);
+  void discardChangesOfRemovedNodes(const std::vector<Model::Node*>& nodes);
 };
 
 class Transaction
@@ -56,6 +56,8 @@
 #include "vm/polygon.h"
 #include "vm/segment.h"
 
+#include <filesystem>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -74,6 +76,7 @@ std::shared_ptr<MapDocument> MapDocumentCommandFacade::newMapDocument()
 MapDocumentCommandFacade::MapDocumentCommandFacade()
   : m_commandProcessor(std::make_unique<CommandProcessor>(this))
 {
+  updateUndoMemoryBudget();
   connectObservers();
 }
 
@@ -268,8 +271,7 @@ void MapDocumentCommandFacade::performAddNodes(
   const std::map<Model::Node*, std::vector<Model::Node*>>& nodes)
 {
   const auto parents = collectNodesAndAncestors(kdl::map_keys(nodes));
-  NotifyBeforeAndAfter notifyParents(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
+  NotifyBeforeAndAfterInBatch notifyParents(m_nodeChangeBatch, parents);
 
   std::vector<Model::Node*> addedNodes;
   for (const auto& [parent, children] : nodes)
@@ -291,8 +293,7 @@ void MapDocumentCommandFacade::performRemoveNodes(
   const std::map<Model::Node*, std::vector<Model::Node*>>& nodes)
 {
   const auto parents = collectNodesAndAncestors(kdl::map_keys(nodes));
-  NotifyBeforeAndAfter notifyParents(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
+  NotifyBeforeAndAfterInBatch notifyParents(m_nodeChangeBatch, parents);
 
   const auto allChildren = kdl::vec_flatten(kdl::map_values(nodes));
   NotifyBeforeAndAfter notifyChildren(
@@ -331,8 +332,7 @@ MapDocumentCommandFacade::performReplaceChildren(
   }
 
   const auto parents = collectNodesAndAncestors(kdl::map_keys(nodes));
-  NotifyBeforeAndAfter notifyParents(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
+  NotifyBeforeAndAfterInBatch notifyParents(m_nodeChangeBatch, parents);
 
   const std::vector<Model::Node*> allOldChildren = collectOldChildren(nodes);
   NotifyBeforeAndAfter notifyChildren(
@@ -411,12 +411,9 @@ void MapDocumentCommandFacade::performSwapNodeContents(
   const auto parents = collectAncestors(nodes);
   const auto descendants = collectDescendants(nodes);
 
-  NotifyBeforeAndAfter notifyNodes(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
-  NotifyBeforeAndAfter notifyParents(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-  NotifyBeforeAndAfter notifyDescendants(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, descendants);
+  NotifyBeforeAndAfterInBatch notifyNodes(m_nodeChangeBatch, nodes);
+  NotifyBeforeAndAfterInBatch notifyParents(m_nodeChangeBatch, parents);
+  NotifyBeforeAndAfterInBatch notifyDescendants(m_nodeChangeBatch, descendants);
 
   const auto [notifyWadsChange, notifyEntityDefinitionsChange, notifyModsChange] =
     notifySpecialWorldProperties(*game(), nodesToSwap);
@@ -631,6 +628,27 @@ void MapDocumentCommandFacade::connectObservers()
     m_commandProcessor->transactionDoneNotifier.connect(transactionDoneNotifier);
   m_notifierConnection +=
     m_commandProcessor->transactionUndoneNotifier.connect(transactionUndoneNotifier);
+
+  auto& prefs = PreferenceManager::instance();
+  m_notifierConnection += prefs.preferenceDidChangeNotifier.connect(
+    this, &MapDocumentCommandFacade::undoPreferenceDidChange);
+}
+
+void MapDocumentCommandFacade::undoPreferenceDidChange(const std::filesystem::path& path)
+{
+  if (path == Preferences::UndoMemoryBudget.path())
+  {
+    updateUndoMemoryBudget();
+  }
+}
+
+void MapDocumentCommandFacade::updateUndoMemoryBudget()
+{
+  // a budget of zero or less means that the undo history is not limited
+  const auto undoMemoryBudget = pref(Preferences::UndoMemoryBudget);
+  m_commandProcessor->setMemoryBudget(
+    undoMemoryBudget > 0 ? size_t(undoMemoryBudget) * 1024u * 1024u
+                         : std::numeric_limits<size_t>::max());
 }
 
 bool MapDocumentCommandFacade::isCurrentDocumentStateObservable() const
@@ -26,6 +26,7 @@
 
 #include "vm/forward.h"
 
+#include <filesystem>
 #include <map>
 #include <memory>
 #include <string>
@@ -117,6 +118,8 @@ public: // modification count
 
 private: // notification
   void connectObservers();
+  void undoPreferenceDidChange(const std::filesystem::path& path);
+  void updateUndoMemoryBudget();
   void documentWasNewed(MapDocument* document);
   void documentWasLoaded(MapDocument* document);
 
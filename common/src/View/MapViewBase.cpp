@@ -1044,6 +1044,7 @@ void MapViewBase::doRender()
   renderFPS(renderContext, renderBatch);
 
   renderBatch.render(renderContext);
+  m_entityModelDrawCalls = renderContext.entityModelDrawCalls();
 
   if (document->needsResourceProcessing())
   {
@@ -1161,8 +1162,13 @@ void MapViewBase::renderFPS(
 {
   if (pref(Preferences::ShowFPS))
   {
+    const auto& cullingStats = renderContext.cullingStats();
     auto renderService = Renderer::RenderService{renderContext, renderBatch};
-    renderService.renderHeadsUp(m_currentFPS);
+    renderService.renderHeadsUp(
+      m_currentFPS + " " + std::to_string(cullingStats.drawnPrimitives)
+      + " primitives drawn, " + std::to_string(cullingStats.culledPrimitives)
+      + " culled, " + std::to_string(m_entityModelDrawCalls)
+      + " model draw calls");
   }
 }
 
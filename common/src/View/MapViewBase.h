@@ -107,6 +107,13 @@ private:
    */
   bool m_isCurrent = false;
 
+  /**
+   * The number of draw calls issued to render entity models in the previous frame. Draw
+   * calls are only counted while the render batch is rendered, so the count is shown one
+   * frame late.
+   */
+  size_t m_entityModelDrawCalls = 0;
+
   SignalDelayer* m_updateActionStatesSignalDelayer = nullptr;
 
   NotifierConnection m_notifierConnection;
@@ -108,7 +108,8 @@ RenderView::RenderView(GLContextManager& contextManager, QWidget* parent)
       + " Max time between frames: " + std::to_string(maxFrameTime) + "ms. "
       + std::to_string(m_glContext->vboManager().currentVboCount()) + " current VBOs ("
       + std::to_string(m_glContext->vboManager().peakVboCount()) + " peak) totalling "
-      + std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB";
+      + std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB ("
+      + std::to_string(m_glContext->vboManager().peakVboSize() / 1024u) + " KiB peak)";
   });
 
   fpsCounter->start(1000);
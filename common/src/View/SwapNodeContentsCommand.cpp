@@ -19,6 +19,7 @@
 
 #include "SwapNodeContentsCommand.h"
 
+#include "Error.h" // IWYU pragma: keep
 #include "Model/Brush.h"
 #include "Model/Entity.h"
 #include "Model/Node.h"
@@ -44,6 +45,11 @@ SwapNodeContentsCommand::~SwapNodeContentsCommand() = default;
 std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformDo(
   MapDocumentCommandFacade* document)
 {
+  if (!restoreGeometry(document->worldBounds()))
+  {
+    return std::make_unique<CommandResult>(false);
+  }
+
   document->performSwapNodeContents(m_nodes);
   return std::make_unique<CommandResult>(true);
 }
@@ -51,6 +57,11 @@ std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformDo(
 std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformUndo(
   MapDocumentCommandFacade* document)
 {
+  if (!restoreGeometry(document->worldBounds()))
+  {
+    return std::make_unique<CommandResult>(false);
+  }
+
   document->performSwapNodeContents(m_nodes);
   return std::make_unique<CommandResult>(true);
 }
@@ -72,5 +83,42 @@ bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
 
   return false;
 }
+
+size_t SwapNodeContentsCommand::doGetMemoryUsage() const
+{
+  auto result = UpdateLinkedGroupsCommandBase::doGetMemoryUsage()
+                + m_nodes.capacity() * sizeof(std::pair<Model::Node*, Model::NodeContents>);
+  for (const auto& [node, contents] : m_nodes)
+  {
+    result += contents.memoryUsage() - sizeof(Model::NodeContents);
+  }
+  return result;
+}
+
+bool SwapNodeContentsCommand::restoreGeometry(const vm::bbox3& worldBounds)
+{
+  for (auto& [node, contents] : m_nodes)
+  {
+    if (auto* brush = std::get_if<Model::Brush>(&contents.get()))
+    {
+      if (brush->restoreGeometry(worldBounds).is_error())
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void SwapNodeContentsCommand::doCompact()
+{
+  for (auto& [node, contents] : m_nodes)
+  {
+    if (auto* brush = std::get_if<Model::Brush>(&contents.get()))
+    {
+      brush->discardGeometry();
+    }
+  }
+}
 } // namespace View
 } // namespace TrenchBroom
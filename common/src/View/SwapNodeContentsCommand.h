@@ -23,6 +23,8 @@
 #include "Model/NodeContents.h"
 #include "View/UpdateLinkedGroupsCommandBase.h"
 
+#include "vm/bbox.h"
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -56,6 +58,22 @@ public:
 
   bool doCollateWith(UndoableCommand& command) override;
 
+  size_t doGetMemoryUsage() const override;
+
+  /**
+   * Discards the geometry of the brushes held by this command to save memory. It is
+   * rebuilt when the command is executed or undone again.
+   */
+  void doCompact() override;
+
+private:
+  /**
+   * Rebuilds the discarded geometry of the brushes held by this command. Returns false if
+   * the geometry of any brush cannot be rebuilt.
+   */
+  bool restoreGeometry(const vm::bbox3& worldBounds);
+
+public:
   deleteCopyAndMove(SwapNodeContentsCommand);
 };
 } // namespace View
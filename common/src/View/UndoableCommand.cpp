@@ -39,6 +39,7 @@ UndoableCommand::~UndoableCommand() {}
 std::unique_ptr<CommandResult> UndoableCommand::performDo(
   MapDocumentCommandFacade* document)
 {
+  m_memoryUsage = std::nullopt;
   auto result = Command::performDo(document);
   if (result->success())
   {
@@ -51,6 +52,7 @@ std::unique_ptr<CommandResult> UndoableCommand::performUndo(
   MapDocumentCommandFacade* document)
 {
   m_state = CommandState::Undoing;
+  m_memoryUsage = std::nullopt;
   auto result = doPerformUndo(document);
   if (result->success())
   {
@@ -70,16 +72,39 @@ bool UndoableCommand::collateWith(UndoableCommand& command)
   if (doCollateWith(command))
   {
     m_modificationCount += command.m_modificationCount;
+    m_memoryUsage = std::nullopt;
     return true;
   }
   return false;
 }
 
+size_t UndoableCommand::memoryUsage() const
+{
+  if (!m_memoryUsage)
+  {
+    m_memoryUsage = doGetMemoryUsage();
+  }
+  return *m_memoryUsage;
+}
+
+void UndoableCommand::compact()
+{
+  doCompact();
+  m_memoryUsage = std::nullopt;
+}
+
 bool UndoableCommand::doCollateWith(UndoableCommand&)
 {
   return false;
 }
 
+size_t UndoableCommand::doGetMemoryUsage() const
+{
+  return sizeof(UndoableCommand) + name().capacity();
+}
+
+void UndoableCommand::doCompact() {}
+
 void UndoableCommand::setModificationCount(MapDocumentCommandFacade* document)
 {
   if (document && m_modificationCount)
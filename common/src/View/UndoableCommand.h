@@ -23,6 +23,7 @@
 #include "View/Command.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace TrenchBroom
@@ -35,6 +36,7 @@ class UndoableCommand : public Command
 {
 private:
   size_t m_modificationCount;
+  mutable std::optional<size_t> m_memoryUsage;
 
 protected:
   UndoableCommand(std::string name, bool updateModificationCount);
@@ -47,12 +49,36 @@ public:
 
   virtual bool collateWith(UndoableCommand& command);
 
+  /**
+   * Returns an estimate of the number of bytes of memory held by this command. The
+   * estimate is cached until this command is executed, undone or collated again.
+   */
+  size_t memoryUsage() const;
+
+  /**
+   * Releases data held by this command that can be recomputed when it is executed or
+   * undone again. The command processor calls this for commands that are no longer among
+   * the most recent commands on the undo or redo stack.
+   */
+  void compact();
+
 protected:
   virtual std::unique_ptr<CommandResult> doPerformUndo(
     MapDocumentCommandFacade* document) = 0;
 
   virtual bool doCollateWith(UndoableCommand& command);
 
+  /**
+   * Returns an estimate of the number of bytes of memory held by this command. The
+   * default implementation only accounts for the command itself.
+   */
+  virtual size_t doGetMemoryUsage() const;
+
+  /**
+   * Releases data that can be recomputed. The default implementation does nothing.
+   */
+  virtual void doCompact();
+
   void setModificationCount(MapDocumentCommandFacade* document);
   void resetModificationCount(MapDocumentCommandFacade* document);
 
@@ -218,8 +218,12 @@ public: // Handle selection
     const HandleList allHandles = handleManager().allHandles();
     HandleList selectedHandles;
 
-    lasso.selected(
-      std::begin(allHandles), std::end(allHandles), std::back_inserter(selectedHandles));
+    auto document = kdl::mem_lock(m_document);
+    lasso.selectedVisible(
+      *document,
+      std::begin(allHandles),
+      std::end(allHandles),
+      std::back_inserter(selectedHandles));
     if (!modifySelection)
     {
       handleManager().deselectAll();
@@ -518,10 +522,10 @@ private: // Observers and state management
     auto document = kdl::mem_lock(m_document);
     m_notifierConnection += document->selectionDidChangeNotifier.connect(
       this, &VertexToolBase::selectionDidChange);
-    m_notifierConnection +=
-      document->nodesWillChangeNotifier.connect(this, &VertexToolBase::nodesWillChange);
-    m_notifierConnection +=
-      document->nodesDidChangeNotifier.connect(this, &VertexToolBase::nodesDidChange);
+    m_notifierConnection += document->nodesWillChangeUnbatchedNotifier.connect(
+      this, &VertexToolBase::nodesWillChange);
+    m_notifierConnection += document->nodesDidChangeUnbatchedNotifier.connect(
+      this, &VertexToolBase::nodesDidChange);
     m_notifierConnection +=
       document->commandDoNotifier.connect(this, &VertexToolBase::commandDo);
     m_notifierConnection +=
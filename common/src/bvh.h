@@ -0,0 +1,992 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Exceptions.h"
+#include "octree.h" // for detail::intersects_ray_bbox
+
+#include "kdl/vector_utils.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/scalar.h"
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace detail
+{
+
+template <typename T>
+T surface_area(const vm::bbox<T, 3>& bounds)
+{
+  const auto size = bounds.size();
+  return T(2) * (size.x() * size.y() + size.y() * size.z() + size.z() * size.x());
+}
+
+} // namespace detail
+
+/**
+ * A bounding volume hierarchy that allows for quick ray, bbox and point queries.
+ *
+ * Every leaf stores one data item together with its bounding box, and every inner node
+ * has exactly two children and stores the union of their bounds. Unlike the octree, the
+ * bounds of the tree nodes adapt to the data, so large and small items do not interfere
+ * with each other and queries only return items whose bounding boxes match.
+ *
+ * The tree can be built top down using the surface area heuristic (SAH), see build().
+ * Inserting an item descends to the sibling that increases the surface area of the tree
+ * the least, and the tree is kept balanced by rotating its nodes. Updating the bounds of
+ * an item only refits the bounds of its ancestors without changing the topology of the
+ * tree. Therefore, the tree should be rebuilt after many items were inserted or moved.
+ *
+ * @tparam T the floating point type
+ * @tparam U the node data to store in the leaves
+ */
+template <typename T, typename U>
+class bvh
+{
+private:
+  static constexpr size_t null_index = std::numeric_limits<size_t>::max();
+
+  /**
+   * The number of bins per axis that are evaluated when splitting a set of items during a
+   * top down build.
+   */
+  static constexpr size_t bin_count = 16;
+
+  /**
+   * The depth up to which items are partitioned using the surface area heuristic during
+   * a top down build.
+   */
+  static constexpr size_t max_sah_depth = 48;
+
+  struct node
+  {
+    vm::bbox<T, 3> bounds;
+    size_t parent = null_index;
+    size_t left = null_index;
+    size_t right = null_index;
+    size_t height = 0;
+    U data{};
+
+    bool is_leaf() const { return left == null_index; }
+  };
+
+  struct build_item
+  {
+    vm::bbox<T, 3> bounds;
+    vm::vec<T, 3> center;
+    size_t leaf;
+  };
+
+  std::vector<node> m_nodes;
+  std::vector<size_t> m_free_nodes;
+  size_t m_root = null_index;
+  std::unordered_map<U, size_t> m_leaf_for_data;
+
+public:
+  bvh() = default;
+
+  /**
+   * Indicates whether a leaf with the given data exists in this tree.
+   *
+   * @param data the data to find
+   * @return true if a leaf with the given data exists and false otherwise
+   */
+  bool contains(const U& data) const { return m_leaf_for_data.count(data) > 0; }
+
+  /**
+   * Inserts a leaf with the given bounds and data into this tree.
+   *
+   * The new leaf becomes the sibling of the tree node that minimizes the increase of the
+   * surface area of all inner nodes.
+   *
+   * @throws NodeTreeException if the given bounds are invalid or if the given data is
+   * already in this tree
+   */
+  void insert(const vm::bbox<T, 3>& bounds, U data)
+  {
+    check(bounds);
+
+    if (contains(data))
+    {
+      throw NodeTreeException("Data already in tree");
+    }
+
+    const auto leaf = allocate_node();
+    m_nodes[leaf].bounds = bounds;
+    m_nodes[leaf].data = data;
+    m_leaf_for_data.emplace(std::move(data), leaf);
+
+    insert_leaf(leaf);
+  }
+
+  /**
+   * Removes the leaf with the given data from this tree.
+   *
+   * @param data the data to remove
+   * @return true if a leaf with the given data was removed, and false otherwise
+   */
+  bool remove(const U& data)
+  {
+    const auto i_leaf = m_leaf_for_data.find(data);
+    if (i_leaf == m_leaf_for_data.end())
+    {
+      return false;
+    }
+
+    const auto leaf = i_leaf->second;
+    m_leaf_for_data.erase(i_leaf);
+
+    remove_leaf(leaf);
+    free_node(leaf);
+
+    if (m_leaf_for_data.empty())
+    {
+      clear();
+    }
+
+    return true;
+  }
+
+  /**
+   * Updates the leaf with the given data with the given new bounds. The bounds of the
+   * leaf's ancestors are refit, but the topology of the tree remains unchanged.
+   *
+   * @param newBounds the new bounds of the leaf
+   * @param data the data of the leaf to update
+   *
+   * @throws NodeTreeException if no leaf with the given data can be found in this tree
+   */
+  void update(const vm::bbox<T, 3>& newBounds, const U& data)
+  {
+    check(newBounds);
+
+    const auto i_leaf = m_leaf_for_data.find(data);
+    if (i_leaf == m_leaf_for_data.end())
+    {
+      throw NodeTreeException("node not found");
+    }
+
+    const auto leaf = i_leaf->second;
+    m_nodes[leaf].bounds = newBounds;
+    refit(m_nodes[leaf].parent);
+  }
+
+  /**
+   * Replaces the contents of this tree with the given pairs of bounds and data.
+   *
+   * The tree is built top down. At every level, the items are partitioned along the axis
+   * and at the position that minimize the surface area heuristic.
+   *
+   * @throws NodeTreeException if any of the given bounds are invalid or if any data
+   * occurs more than once
+   */
+  void build(std::vector<std::pair<vm::bbox<T, 3>, U>> items)
+  {
+    clear();
+
+    auto build_items = std::vector<build_item>{};
+    build_items.reserve(items.size());
+    m_nodes.reserve(2 * items.size());
+    m_leaf_for_data.reserve(items.size());
+
+    for (auto& [bounds, data] : items)
+    {
+      try
+      {
+        check(bounds);
+      }
+      catch (const NodeTreeException&)
+      {
+        clear();
+        throw;
+      }
+
+      const auto leaf = allocate_node();
+      if (!m_leaf_for_data.emplace(data, leaf).second)
+      {
+        clear();
+        throw NodeTreeException("Data already in tree");
+      }
+
+      m_nodes[leaf].bounds = bounds;
+      m_nodes[leaf].data = std::move(data);
+      build_items.push_back({bounds, bounds.center(), leaf});
+    }
+
+    if (!build_items.empty())
+    {
+      m_root = build_node(build_items, 0, build_items.size(), 0);
+    }
+  }
+
+  /**
+   * Rebuilds this tree from its current contents, see build().
+   */
+  void rebuild()
+  {
+    auto items = std::vector<std::pair<vm::bbox<T, 3>, U>>{};
+    items.reserve(m_leaf_for_data.size());
+    for (const auto& [data, leaf] : m_leaf_for_data)
+    {
+      items.emplace_back(m_nodes[leaf].bounds, data);
+    }
+    build(std::move(items));
+  }
+
+  /**
+   * Clears this tree.
+   */
+  void clear()
+  {
+    m_nodes.clear();
+    m_free_nodes.clear();
+    m_root = null_index;
+    m_leaf_for_data.clear();
+  }
+
+  /**
+   * Indicates whether this tree is empty.
+   *
+   * @return true if this tree is empty and false otherwise
+   */
+  bool empty() const { return m_root == null_index; }
+
+  /**
+   * Returns the bounds of the given data.
+   *
+   * @throws NodeTreeException if no leaf with the given data can be found in this tree
+   */
+  const vm::bbox<T, 3>& bounds(const U& data) const
+  {
+    const auto i_leaf = m_leaf_for_data.find(data);
+    if (i_leaf == m_leaf_for_data.end())
+    {
+      throw NodeTreeException("node not found");
+    }
+    return m_nodes[i_leaf->second].bounds;
+  }
+
+  /**
+   * Returns the height of this tree, i.e. the number of nodes on the longest path from
+   * the root to a leaf.
+   */
+  size_t height() const { return m_root != null_index ? m_nodes[m_root].height + 1 : 0; }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given ray
+   * and returns a list of those items.
+   *
+   * @param ray the ray to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_intersectors(const vm::ray<T, 3>& ray) const
+  {
+    auto result = std::vector<U>{};
+    find_intersectors(ray, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given ray
+   * or contains its origin and appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param ray the ray to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const vm::ray<T, 3>& ray, O out) const
+  {
+    const auto inverse_direction = vm::vec<T, 3>::one() / ray.direction;
+    find_candidates(
+      [&](const auto& bounds) {
+        return detail::intersects_ray_bbox(ray, inverse_direction, bounds);
+      },
+      out);
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with any of the
+   * given rays and returns a list of pairs of the index of the ray and the data item.
+   *
+   * @see find_intersectors(const std::vector<vm::ray<T, 3>>&, O)
+   */
+  std::vector<std::pair<size_t, U>> find_intersectors(
+    const std::vector<vm::ray<T, 3>>& rays) const
+  {
+    auto result = std::vector<std::pair<size_t, U>>{};
+    find_intersectors(rays, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with any of the
+   * given rays and appends a pair of the index of the ray and the data item to the given
+   * output iterator. A data item is appended once for every ray that intersects with its
+   * bounding box.
+   *
+   * The tree is traversed only once for all rays. A tree node is only tested against the
+   * rays that intersect with its parent node.
+   *
+   * @tparam O the output iterator type
+   * @param rays the rays to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const std::vector<vm::ray<T, 3>>& rays, O out) const
+  {
+    if (m_root != null_index && !rays.empty())
+    {
+      const auto inverse_directions = kdl::vec_transform(
+        rays, [](const auto& ray) { return vm::vec<T, 3>::one() / ray.direction; });
+
+      visit_node_for_queries(
+        rays.size(),
+        [&](const auto& bounds, const size_t i) {
+          return detail::intersects_ray_bbox(rays[i], inverse_directions[i], bounds);
+        },
+        out);
+    }
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given bbox
+   * and returns a list of those items.
+   *
+   * @param bbox the bbox to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_intersectors(const vm::bbox<T, 3>& bbox) const
+  {
+    auto result = std::vector<U>{};
+    find_intersectors(bbox, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given bbox
+   * and appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param bbox the bbox to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const vm::bbox<T, 3>& bbox, O out) const
+  {
+    find_candidates([&](const auto& bounds) { return bbox.intersects(bounds); }, out);
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with any of the
+   * given bboxes and returns a list of pairs of the index of the bbox and the data item.
+   *
+   * @see find_intersectors(const std::vector<vm::bbox<T, 3>>&, O)
+   */
+  std::vector<std::pair<size_t, U>> find_intersectors(
+    const std::vector<vm::bbox<T, 3>>& bboxes) const
+  {
+    auto result = std::vector<std::pair<size_t, U>>{};
+    find_intersectors(bboxes, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with any of the
+   * given bboxes and appends a pair of the index of the bbox and the data item to the
+   * given output iterator. A data item is appended once for every bbox that intersects
+   * with its bounding box.
+   *
+   * The tree is traversed only once for all bboxes.
+   *
+   * @tparam O the output iterator type
+   * @param bboxes the bboxes to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const std::vector<vm::bbox<T, 3>>& bboxes, O out) const
+  {
+    if (m_root != null_index && !bboxes.empty())
+    {
+      visit_node_for_queries(
+        bboxes.size(),
+        [&](const auto& bounds, const size_t i) { return bboxes[i].intersects(bounds); },
+        out);
+    }
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box contains the given point and
+   * returns a list of those items.
+   *
+   * @param point the point to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_containers(const vm::vec<T, 3>& point) const
+  {
+    auto result = std::vector<U>{};
+    find_containers(point, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box contains the given point and
+   * appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param point the point to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_containers(const vm::vec<T, 3>& point, O out) const
+  {
+    find_candidates([&](const auto& bounds) { return bounds.contains(point); }, out);
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box satisfies the given predicate
+   * and returns a list of those items.
+   *
+   * @see find_candidates(const P&, O)
+   */
+  template <typename P>
+  std::vector<U> find_candidates(const P& predicate) const
+  {
+    auto result = std::vector<U>{};
+    find_candidates(predicate, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box satisfies the given predicate
+   * and appends it to the given output iterator.
+   *
+   * The predicate is called with the bounds of the tree nodes. If it rejects an inner
+   * node, then the children of that node are not visited. The predicate must therefore
+   * accept the bounds of an inner node if it accepts the bounds of any of its
+   * descendants.
+   *
+   * @tparam P the predicate type, must accept a `const vm::bbox<T, 3>&` and return bool
+   * @tparam O the output iterator type
+   * @param predicate the predicate to test the tree node bounds with
+   * @param out the output iterator to append to
+   */
+  template <typename P, typename O>
+  void find_candidates(const P& predicate, O out) const
+  {
+    if (m_root == null_index)
+    {
+      return;
+    }
+
+    auto stack = std::vector<size_t>{m_root};
+    while (!stack.empty())
+    {
+      const auto& node = m_nodes[stack.back()];
+      stack.pop_back();
+
+      if (predicate(node.bounds))
+      {
+        if (node.is_leaf())
+        {
+          *out++ = node.data;
+        }
+        else
+        {
+          stack.push_back(node.right);
+          stack.push_back(node.left);
+        }
+      }
+    }
+  }
+
+private:
+  size_t allocate_node()
+  {
+    if (!m_free_nodes.empty())
+    {
+      const auto index = m_free_nodes.back();
+      m_free_nodes.pop_back();
+      m_nodes[index] = node{};
+      return index;
+    }
+
+    m_nodes.emplace_back();
+    return m_nodes.size() - 1;
+  }
+
+  void free_node(const size_t index)
+  {
+    m_nodes[index] = node{};
+    m_free_nodes.push_back(index);
+  }
+
+  /**
+   * Recomputes the bounds of the given inner node and its ancestors from the bounds of
+   * their children.
+   */
+  void refit(size_t index)
+  {
+    while (index != null_index)
+    {
+      auto& node = m_nodes[index];
+      node.bounds = vm::merge(m_nodes[node.left].bounds, m_nodes[node.right].bounds);
+      index = node.parent;
+    }
+  }
+
+  /**
+   * Recomputes the bounds and heights of the given inner node and its ancestors, and
+   * rotates every node whose subtrees differ in height by more than one.
+   */
+  void rebalance(size_t index)
+  {
+    while (index != null_index)
+    {
+      // the height must be up to date before checking whether the node is balanced
+      auto& node = m_nodes[index];
+      const auto& left = m_nodes[node.left];
+      const auto& right = m_nodes[node.right];
+      node.bounds = vm::merge(left.bounds, right.bounds);
+      node.height = 1 + std::max(left.height, right.height);
+
+      index = m_nodes[rotate(index)].parent;
+    }
+  }
+
+  /**
+   * If the subtrees of the given inner node differ in height by more than one, then the
+   * higher child replaces the given node, which in turn adopts one of the children of its
+   * former child. Returns the index of the node that is at the position of the given node
+   * afterwards.
+   */
+  size_t rotate(const size_t a)
+  {
+    if (m_nodes[a].is_leaf() || m_nodes[a].height < 2)
+    {
+      return a;
+    }
+
+    const auto b = m_nodes[a].left;
+    const auto c = m_nodes[a].right;
+    const auto balance = int64_t(m_nodes[c].height) - int64_t(m_nodes[b].height);
+
+    if (balance > 1)
+    {
+      return rotate_up(a, c, b);
+    }
+    if (balance < -1)
+    {
+      return rotate_up(a, b, c);
+    }
+    return a;
+  }
+
+  /**
+   * Makes the given child of the given node its parent. The given sibling remains a child
+   * of the given node, which also adopts the lower child of the given child.
+   */
+  size_t rotate_up(const size_t a, const size_t child, const size_t sibling)
+  {
+    const auto f = m_nodes[child].left;
+    const auto g = m_nodes[child].right;
+
+    // child replaces a
+    const auto parent = m_nodes[a].parent;
+    m_nodes[child].parent = parent;
+    m_nodes[a].parent = child;
+    if (parent == null_index)
+    {
+      m_root = child;
+    }
+    else if (m_nodes[parent].left == a)
+    {
+      m_nodes[parent].left = child;
+    }
+    else
+    {
+      m_nodes[parent].right = child;
+    }
+
+    // child keeps its higher child and a adopts the lower one
+    const auto keep = m_nodes[f].height > m_nodes[g].height ? f : g;
+    const auto adopt = keep == f ? g : f;
+
+    m_nodes[child].left = a;
+    m_nodes[child].right = keep;
+    m_nodes[a].left = sibling;
+    m_nodes[a].right = adopt;
+    m_nodes[adopt].parent = a;
+
+    m_nodes[a].bounds = vm::merge(m_nodes[sibling].bounds, m_nodes[adopt].bounds);
+    m_nodes[a].height = 1 + std::max(m_nodes[sibling].height, m_nodes[adopt].height);
+    m_nodes[child].bounds = vm::merge(m_nodes[a].bounds, m_nodes[keep].bounds);
+    m_nodes[child].height = 1 + std::max(m_nodes[a].height, m_nodes[keep].height);
+
+    return child;
+  }
+
+  void insert_leaf(const size_t leaf)
+  {
+    if (m_root == null_index)
+    {
+      m_root = leaf;
+      return;
+    }
+
+    const auto leaf_bounds = m_nodes[leaf].bounds;
+
+    // Descend to the sibling that increases the surface area of the tree the least. The
+    // cost of descending into a child includes the area that is added to every ancestor.
+    auto sibling = m_root;
+    while (!m_nodes[sibling].is_leaf())
+    {
+      const auto& current = m_nodes[sibling];
+      const auto area = detail::surface_area(current.bounds);
+      const auto merged_area =
+        detail::surface_area(vm::merge(current.bounds, leaf_bounds));
+
+      const auto cost = T(2) * merged_area;
+      const auto inheritance_cost = T(2) * (merged_area - area);
+
+      const auto child_cost = [&](const size_t child) {
+        const auto& child_node = m_nodes[child];
+        const auto child_merged_area =
+          detail::surface_area(vm::merge(child_node.bounds, leaf_bounds));
+        return child_node.is_leaf()
+                 ? child_merged_area + inheritance_cost
+                 : child_merged_area - detail::surface_area(child_node.bounds)
+                     + inheritance_cost;
+      };
+
+      const auto left_cost = child_cost(current.left);
+      const auto right_cost = child_cost(current.right);
+
+      if (cost < left_cost && cost < right_cost)
+      {
+        break;
+      }
+
+      sibling = left_cost < right_cost ? current.left : current.right;
+    }
+
+    const auto old_parent = m_nodes[sibling].parent;
+    const auto new_parent = allocate_node();
+    m_nodes[new_parent].parent = old_parent;
+    m_nodes[new_parent].left = sibling;
+    m_nodes[new_parent].right = leaf;
+    m_nodes[sibling].parent = new_parent;
+    m_nodes[leaf].parent = new_parent;
+
+    if (old_parent == null_index)
+    {
+      m_root = new_parent;
+    }
+    else if (m_nodes[old_parent].left == sibling)
+    {
+      m_nodes[old_parent].left = new_parent;
+    }
+    else
+    {
+      m_nodes[old_parent].right = new_parent;
+    }
+
+    rebalance(new_parent);
+  }
+
+  void remove_leaf(const size_t leaf)
+  {
+    if (leaf == m_root)
+    {
+      m_root = null_index;
+      return;
+    }
+
+    const auto parent = m_nodes[leaf].parent;
+    const auto grand_parent = m_nodes[parent].parent;
+    const auto sibling =
+      m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+    m_nodes[sibling].parent = grand_parent;
+    if (grand_parent == null_index)
+    {
+      m_root = sibling;
+    }
+    else
+    {
+      if (m_nodes[grand_parent].left == parent)
+      {
+        m_nodes[grand_parent].left = sibling;
+      }
+      else
+      {
+        m_nodes[grand_parent].right = sibling;
+      }
+      rebalance(grand_parent);
+    }
+
+    free_node(parent);
+  }
+
+  /**
+   * Builds a subtree for the given range of items and returns the index of its root.
+   *
+   * Beyond a certain depth, the items are split at their median to limit the height of
+   * the tree for unevenly distributed items.
+   */
+  size_t build_node(
+    std::vector<build_item>& items, const size_t begin, const size_t end, size_t depth)
+  {
+    assert(begin < end);
+
+    if (end - begin == 1)
+    {
+      return items[begin].leaf;
+    }
+
+    const auto mid = depth < max_sah_depth ? partition(items, begin, end)
+                                           : partition_median(items, begin, end);
+
+    const auto left = build_node(items, begin, mid, depth + 1);
+    const auto right = build_node(items, mid, end, depth + 1);
+
+    const auto index = allocate_node();
+    m_nodes[index].bounds = vm::merge(m_nodes[left].bounds, m_nodes[right].bounds);
+    m_nodes[index].height = 1 + std::max(m_nodes[left].height, m_nodes[right].height);
+    m_nodes[index].left = left;
+    m_nodes[index].right = right;
+    m_nodes[left].parent = index;
+    m_nodes[right].parent = index;
+    return index;
+  }
+
+  /**
+   * Partitions the given range of items into two non empty ranges and returns the index
+   * of the first item of the second range.
+   *
+   * The items are binned by their centers along each axis, and the split between two
+   * bins with the lowest SAH cost is chosen. If the centers of all items coincide, the
+   * items are split in half.
+   */
+  static size_t partition(
+    std::vector<build_item>& items, const size_t begin, const size_t end)
+  {
+    auto center_bounds = vm::bbox<T, 3>{items[begin].center, items[begin].center};
+    for (size_t i = begin + 1; i < end; ++i)
+    {
+      center_bounds = vm::merge(center_bounds, items[i].center);
+    }
+
+    const auto extent = center_bounds.size();
+    const auto bin_of = [&](const build_item& item, const size_t axis) {
+      const auto relative = (item.center[axis] - center_bounds.min[axis]) / extent[axis];
+      return std::min(size_t(relative * T(bin_count)), bin_count - 1);
+    };
+
+    auto best_cost = std::numeric_limits<T>::max();
+    auto best_axis = size_t(0);
+    auto best_split = size_t(0);
+
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+      if (extent[axis] <= T(0))
+      {
+        continue;
+      }
+
+      auto bin_bounds = std::array<vm::bbox<T, 3>, bin_count>{};
+      auto bin_counts = std::array<size_t, bin_count>{};
+      for (size_t i = begin; i < end; ++i)
+      {
+        const auto bin = bin_of(items[i], axis);
+        bin_bounds[bin] = bin_counts[bin] == 0
+                            ? items[i].bounds
+                            : vm::merge(bin_bounds[bin], items[i].bounds);
+        ++bin_counts[bin];
+      }
+
+      // sweep from the right to compute the cost of the right side of every split
+      auto right_areas = std::array<T, bin_count>{};
+      auto right_bounds = vm::bbox<T, 3>{};
+      auto right_count = size_t(0);
+      for (size_t bin = bin_count - 1; bin > 0; --bin)
+      {
+        if (bin_counts[bin] > 0)
+        {
+          right_bounds =
+            right_count == 0 ? bin_bounds[bin] : vm::merge(right_bounds, bin_bounds[bin]);
+          right_count += bin_counts[bin];
+        }
+        right_areas[bin] =
+          right_count > 0 ? T(right_count) * detail::surface_area(right_bounds) : T(0);
+      }
+
+      // sweep from the left, splitting between bin - 1 and bin
+      auto left_bounds = vm::bbox<T, 3>{};
+      auto left_count = size_t(0);
+      for (size_t bin = 1; bin < bin_count; ++bin)
+      {
+        if (bin_counts[bin - 1] > 0)
+        {
+          left_bounds = left_count == 0 ? bin_bounds[bin - 1]
+                                        : vm::merge(left_bounds, bin_bounds[bin - 1]);
+          left_count += bin_counts[bin - 1];
+        }
+
+        if (left_count > 0 && left_count < end - begin)
+        {
+          const auto cost =
+            T(left_count) * detail::surface_area(left_bounds) + right_areas[bin];
+          if (cost < best_cost)
+          {
+            best_cost = cost;
+            best_axis = axis;
+            best_split = bin;
+          }
+        }
+      }
+    }
+
+    if (best_split == 0)
+    {
+      // all centers coincide, split in half
+      return begin + (end - begin) / 2;
+    }
+
+    const auto i_mid = std::partition(
+      std::next(items.begin(), std::ptrdiff_t(begin)),
+      std::next(items.begin(), std::ptrdiff_t(end)),
+      [&](const auto& item) { return bin_of(item, best_axis) < best_split; });
+    return size_t(std::distance(items.begin(), i_mid));
+  }
+
+  /**
+   * Partitions the given range of items at the median of their centers along the axis
+   * with the largest extent and returns the index of the first item of the second range.
+   */
+  static size_t partition_median(
+    std::vector<build_item>& items, const size_t begin, const size_t end)
+  {
+    auto center_bounds = vm::bbox<T, 3>{items[begin].center, items[begin].center};
+    for (size_t i = begin + 1; i < end; ++i)
+    {
+      center_bounds = vm::merge(center_bounds, items[i].center);
+    }
+
+    const auto axis = vm::find_abs_max_component(center_bounds.size());
+    const auto mid = begin + (end - begin) / 2;
+    std::nth_element(
+      std::next(items.begin(), std::ptrdiff_t(begin)),
+      std::next(items.begin(), std::ptrdiff_t(mid)),
+      std::next(items.begin(), std::ptrdiff_t(end)),
+      [&](const auto& lhs, const auto& rhs) {
+        return lhs.center[axis] < rhs.center[axis];
+      });
+    return mid;
+  }
+
+  /**
+   * Visits the tree nodes for a batch of queries. A node is visited for every query that
+   * it matches, but only if that query matched its parent, too.
+   *
+   * The indices of the queries that are still active are kept in a single buffer which
+   * grows by at most the number of queries per tree level, so no allocation takes place
+   * per visited node.
+   *
+   * @param query_count the number of queries
+   * @param predicate the predicate to test a query against the bounds of a tree node,
+   * must accept a `const vm::bbox<T, 3>&` and the index of the query and return bool
+   * @param out the output iterator to append pairs of query indices and data items to
+   */
+  template <typename P, typename O>
+  void visit_node_for_queries(const size_t query_count, const P& predicate, O& out) const
+  {
+    auto indices = std::vector<size_t>(query_count);
+    std::iota(indices.begin(), indices.end(), size_t(0));
+
+    visit_node_for_queries(m_root, indices, 0, query_count, predicate, out);
+  }
+
+  template <typename P, typename O>
+  void visit_node_for_queries(
+    const size_t index,
+    std::vector<size_t>& indices,
+    const size_t begin,
+    const size_t end,
+    const P& predicate,
+    O& out) const
+  {
+    const auto& node = m_nodes[index];
+
+    // the indices of the queries that match this node are appended to the buffer
+    const auto matching_begin = indices.size();
+    for (size_t i = begin; i < end; ++i)
+    {
+      if (predicate(node.bounds, indices[i]))
+      {
+        indices.push_back(indices[i]);
+      }
+    }
+    const auto matching_end = indices.size();
+
+    if (matching_begin < matching_end)
+    {
+      if (node.is_leaf())
+      {
+        for (size_t i = matching_begin; i < matching_end; ++i)
+        {
+          *out++ = std::pair<size_t, U>{indices[i], node.data};
+        }
+      }
+      else
+      {
+        visit_node_for_queries(
+          node.left, indices, matching_begin, matching_end, predicate, out);
+        visit_node_for_queries(
+          node.right, indices, matching_begin, matching_end, predicate, out);
+      }
+    }
+
+    indices.resize(matching_begin);
+  }
+
+  void check(const vm::bbox<T, 3>& bounds) const
+  {
+    if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max))
+    {
+      throw NodeTreeException("Cannot add node to bvh with invalid bounds");
+    }
+  }
+};
+
+} // namespace TrenchBroom
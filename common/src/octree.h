@@ -37,6 +37,8 @@
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <limits>
+#include <numeric>
 #include <optional>
 #include <ostream>
 #include <unordered_map>
@@ -120,6 +122,46 @@ node_address get_container(const vm::bbox<T, 3>& bounds, const T min_size)
   return min_address;
 }
 
+/**
+ * Tests whether the given ray hits the given bounds or whether its origin is contained in
+ * the bounds. The inverse direction of the ray must be precomputed by the caller so that
+ * it can be reused when testing the same ray against many bounds.
+ */
+template <typename T>
+bool intersects_ray_bbox(
+  const vm::ray<T, 3>& ray,
+  const vm::vec<T, 3>& inverse_direction,
+  const vm::bbox<T, 3>& bounds)
+{
+  auto t_min = -std::numeric_limits<T>::infinity();
+  auto t_max = std::numeric_limits<T>::infinity();
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    if (ray.direction[i] == T(0))
+    {
+      // the ray is parallel to the slab
+      if (ray.origin[i] < bounds.min[i] || ray.origin[i] > bounds.max[i])
+      {
+        return false;
+      }
+    }
+    else
+    {
+      const auto t1 = (bounds.min[i] - ray.origin[i]) * inverse_direction[i];
+      const auto t2 = (bounds.max[i] - ray.origin[i]) * inverse_direction[i];
+      t_min = std::max(t_min, std::min(t1, t2));
+      t_max = std::min(t_max, std::max(t1, t2));
+      if (t_min > t_max)
+      {
+        return false;
+      }
+    }
+  }
+
+  return t_max >= T(0);
+}
+
 } // namespace detail
 
 /**
@@ -554,6 +596,51 @@ public:
     }
   }
 
+  /**
+   * Finds every data item in this tree whose bounding box intersects with any of the
+   * given rays and returns a list of pairs of the index of the ray and the data item.
+   *
+   * @see find_intersectors(const std::vector<vm::ray<T, 3>>&, O)
+   */
+  std::vector<std::pair<size_t, U>> find_intersectors(
+    const std::vector<vm::ray<T, 3>>& rays) const
+  {
+    auto result = std::vector<std::pair<size_t, U>>{};
+    find_intersectors(rays, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with any of the
+   * given rays and appends a pair of the index of the ray and the data item to the given
+   * output iterator. A data item is appended once for every ray that intersects with its
+   * bounding box.
+   *
+   * The tree is traversed only once for all rays. A tree node is only tested against the
+   * rays that intersect with its parent node.
+   *
+   * @tparam O the output iterator type
+   * @param rays the rays to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const std::vector<vm::ray<T, 3>>& rays, O out) const
+  {
+    if (m_root && !rays.empty())
+    {
+      const auto inverse_directions = kdl::vec_transform(
+        rays, [](const auto& ray) { return vm::vec<T, 3>::one() / ray.direction; });
+
+      visit_node_for_queries(
+        *m_root,
+        rays.size(),
+        [&](const auto& bounds, const size_t i) {
+          return detail::intersects_ray_bbox(rays[i], inverse_directions[i], bounds);
+        },
+        out);
+    }
+  }
+
   /**
    * Finds every data item in this tree whose bounding box intersects with the given bbox
    * and returns a list of those items.
@@ -594,6 +681,45 @@ public:
     }
   }
 
+  /**
+   * Finds every data item in this tree whose bounding box intersects with any of the
+   * given bboxes and returns a list of pairs of the index of the bbox and the data item.
+   *
+   * @see find_intersectors(const std::vector<vm::bbox<T, 3>>&, O)
+   */
+  std::vector<std::pair<size_t, U>> find_intersectors(
+    const std::vector<vm::bbox<T, 3>>& bboxes) const
+  {
+    auto result = std::vector<std::pair<size_t, U>>{};
+    find_intersectors(bboxes, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with any of the
+   * given bboxes and appends a pair of the index of the bbox and the data item to the
+   * given output iterator. A data item is appended once for every bbox that intersects
+   * with its bounding box.
+   *
+   * The tree is traversed only once for all bboxes.
+   *
+   * @tparam O the output iterator type
+   * @param bboxes the bboxes to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const std::vector<vm::bbox<T, 3>>& bboxes, O out) const
+  {
+    if (m_root && !bboxes.empty())
+    {
+      visit_node_for_queries(
+        *m_root,
+        bboxes.size(),
+        [&](const auto& bounds, const size_t i) { return bboxes[i].intersects(bounds); },
+        out);
+    }
+  }
+
   /**
    * Finds every data item in this tree whose bounding box contains the given point and
    * returns a list of those items.
@@ -633,9 +759,123 @@ public:
     }
   }
 
+  /**
+   * Finds every data item in this tree that is stored in a tree node whose bounds satisfy
+   * the given predicate and returns a list of those items.
+   *
+   * @see find_candidates(const P&, O)
+   */
+  template <typename P>
+  std::vector<U> find_candidates(const P& predicate) const
+  {
+    auto result = std::vector<U>{};
+    find_candidates(predicate, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree that is stored in a tree node whose bounds satisfy
+   * the given predicate and appends it to the given output iterator.
+   *
+   * The predicate is called with the bounds of the tree nodes. If it rejects a tree node,
+   * then the children of that node are not visited. Since a tree node's bounds contain
+   * the bounds of the items stored in it, the found items are candidates that callers
+   * might want to test against their own bounding boxes.
+   *
+   * @tparam P the predicate type, must accept a `const vm::bbox<T, 3>&` and return bool
+   * @tparam O the output iterator type
+   * @param predicate the predicate to test the tree node bounds with
+   * @param out the output iterator to append to
+   */
+  template <typename P, typename O>
+  void find_candidates(const P& predicate, O out) const
+  {
+    if (m_root)
+    {
+      visit_node_if(
+        *m_root,
+        [&](const auto& node) {
+          const auto& data = get_data(node);
+          std::copy(data.begin(), data.end(), out);
+        },
+        [&](const auto& node) {
+          return predicate(get_address(node).to_bounds(m_min_size));
+        });
+    }
+  }
+
   kdl_reflect_inline(octree, m_root, m_min_size, m_node_address_for_data);
 
 private:
+  /**
+   * Visits the given node and its descendants for a batch of queries. A node is visited
+   * for every query that it matches, but only if that query matched its parent, too.
+   *
+   * The indices of the queries that are still active are kept in a single buffer which
+   * grows by at most the number of queries per tree level, so no allocation takes place
+   * per visited node.
+   *
+   * @param root the node to start at
+   * @param query_count the number of queries
+   * @param predicate the predicate to test a query against the bounds of a tree node,
+   * must accept a `const vm::bbox<T, 3>&` and the index of the query and return bool
+   * @param out the output iterator to append pairs of query indices and data items to
+   */
+  template <typename P, typename O>
+  void visit_node_for_queries(
+    const node& root, const size_t query_count, const P& predicate, O& out) const
+  {
+    auto indices = std::vector<size_t>(query_count);
+    std::iota(indices.begin(), indices.end(), size_t(0));
+
+    visit_node_for_queries(root, indices, 0, query_count, predicate, out);
+  }
+
+  template <typename P, typename O>
+  void visit_node_for_queries(
+    const node& node,
+    std::vector<size_t>& indices,
+    const size_t begin,
+    const size_t end,
+    const P& predicate,
+    O& out) const
+  {
+    const auto bounds = get_address(node).to_bounds(m_min_size);
+
+    // the indices of the queries that match this node are appended to the buffer
+    const auto matching_begin = indices.size();
+    for (size_t i = begin; i < end; ++i)
+    {
+      if (predicate(bounds, indices[i]))
+      {
+        indices.push_back(indices[i]);
+      }
+    }
+    const auto matching_end = indices.size();
+
+    if (matching_begin < matching_end)
+    {
+      for (const auto& data : get_data(node))
+      {
+        for (size_t i = matching_begin; i < matching_end; ++i)
+        {
+          *out++ = std::pair<size_t, U>{indices[i], data};
+        }
+      }
+
+      if (const auto* inner = std::get_if<inner_node>(&node))
+      {
+        for (const auto& child : inner->children)
+        {
+          visit_node_for_queries(
+            child, indices, matching_begin, matching_end, predicate, out);
+        }
+      }
+    }
+
+    indices.resize(matching_begin);
+  }
+
   void check(const vm::bbox<T, 3>& bounds) const
   {
     if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max))
@@ -682,6 +682,37 @@ TEST_CASE("Resource")
     }
   }
 
+  SECTION("Dropping a loading resource cancels its loading task")
+  {
+    auto loaderCalled = false;
+    auto resource = ResourceT{[&]() {
+      loaderCalled = true;
+      return Result<MockResource>{MockResource{}};
+    }};
+
+    setResourceState<ResourceLoading<MockResource>>(
+      resource, mockTaskRunner, processContext);
+    REQUIRE(mockTaskRunner.tasks.size() == 1);
+
+    resource.drop();
+    CHECK(resource.isDropped());
+
+    mockTaskRunner.resolveNextPromise();
+    CHECK(!loaderCalled);
+  }
+
+  SECTION("priority")
+  {
+    auto resource = ResourceT{[&]() { return Result<MockResource>{MockResource{}}; }};
+    CHECK(resource.priority() == ResourcePriority::Normal);
+
+    resource.setPriority(ResourcePriority::High);
+    CHECK(resource.priority() == ResourcePriority::High);
+
+    auto movedResource = std::move(resource);
+    CHECK(movedResource.priority() == ResourcePriority::High);
+  }
+
   SECTION("needsProcessing")
   {
     SECTION("ResourceFailed state")
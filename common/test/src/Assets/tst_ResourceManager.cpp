@@ -230,6 +230,69 @@ TEST_CASE("ResourceManager")
       }
     }
 
+    SECTION("maxLoadingResources")
+    {
+      resourceManager = ResourceManager{1};
+
+      auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
+      resourceManager.addResource(resource1);
+      resourceManager.addResource(resource2);
+
+      CHECK(
+        resourceManager.process(taskRunner, processContext)
+        == std::vector{resource1->id()});
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource1->state()));
+      CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource2->state()));
+      CHECK(resourceManager.loadingResourceCount() == 1);
+
+      mockTaskRunner.resolveNextPromise();
+
+      CHECK(
+        resourceManager.process(taskRunner, processContext)
+        == std::vector{resource1->id(), resource2->id()});
+      CHECK(std::holds_alternative<ResourceLoaded<MockResource>>(resource1->state()));
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource2->state()));
+      CHECK(resourceManager.loadingResourceCount() == 1);
+    }
+
+    SECTION("resources with higher priority are loaded first")
+    {
+      resourceManager = ResourceManager{1};
+
+      auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
+      resource2->setPriority(ResourcePriority::High);
+      resourceManager.addResource(resource1);
+      resourceManager.addResource(resource2);
+
+      CHECK(
+        resourceManager.process(taskRunner, processContext)
+        == std::vector{resource2->id()});
+      CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource1->state()));
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource2->state()));
+    }
+
+    SECTION("dropping unloaded resources doesn't trigger loading")
+    {
+      resourceManager = ResourceManager{1};
+
+      auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
+      resourceManager.addResource(resource1);
+      resourceManager.addResource(resource2);
+
+      resourceManager.process(taskRunner, processContext);
+      REQUIRE(mockTaskRunner.tasks.size() == 1);
+
+      resource2.reset();
+      mockTaskRunner.resolveNextPromise();
+
+      resourceManager.process(taskRunner, processContext);
+      CHECK(mockTaskRunner.tasks.empty());
+      CHECK(resourceManager.resources() == std::vector{resource1});
+    }
+
     SECTION("dropping resources")
     {
       auto mockDropCalls = std::array{std::optional<bool>{}, std::optional<bool>{}};
@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/TaskScheduler.h"
+#include "Error.h"
+#include "Result.h"
+
+#include <future>
+#include <stdexcept>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Assets
+{
+
+TEST_CASE("TaskScheduler")
+{
+  SECTION("threadCount")
+  {
+    CHECK(TaskScheduler{2}.threadCount() == 2);
+    CHECK(TaskScheduler::defaultThreadCount() > 0);
+  }
+
+  SECTION("run")
+  {
+    auto taskScheduler = TaskScheduler{2};
+
+    auto futures = std::vector<std::future<std::unique_ptr<TaskResult>>>{};
+    for (int i = 0; i < 10; ++i)
+    {
+      futures.push_back(taskScheduler.run([i]() -> std::unique_ptr<TaskResult> {
+        return std::make_unique<LoaderTaskResult<int>>(Result<int>{i});
+      }));
+    }
+
+    for (int i = 0; i < 10; ++i)
+    {
+      auto taskResult = futures[size_t(i)].get();
+      auto* loaderTaskResult = static_cast<LoaderTaskResult<int>*>(taskResult.get());
+      CHECK(loaderTaskResult->get() == Result<int>{i});
+    }
+
+    const auto stats = taskScheduler.stats();
+    CHECK(stats.completedTasks == 10);
+    CHECK(stats.queuedTasks == 0);
+    CHECK(stats.runningTasks == 0);
+    CHECK(stats.maxQueuedTasks > 0);
+  }
+
+  SECTION("run propagates exceptions")
+  {
+    auto taskScheduler = TaskScheduler{1};
+    auto future = taskScheduler.run(
+      []() -> std::unique_ptr<TaskResult> { throw std::runtime_error{"error"}; });
+    CHECK_THROWS_AS(future.get(), std::runtime_error);
+  }
+
+  SECTION("destructor discards queued tasks")
+  {
+    auto executed = false;
+    auto future = std::future<std::unique_ptr<TaskResult>>{};
+
+    {
+      // without threads, no task is ever started
+      auto taskScheduler = TaskScheduler{0};
+      future = taskScheduler.run([&]() -> std::unique_ptr<TaskResult> {
+        executed = true;
+        return nullptr;
+      });
+      CHECK(taskScheduler.stats().queuedTasks == 1);
+    }
+
+    CHECK(!executed);
+    CHECK_THROWS_AS(future.get(), std::future_error);
+  }
+}
+
+} // namespace TrenchBroom::Assets
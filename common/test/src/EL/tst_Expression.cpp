@@ -834,6 +834,27 @@ TEST_CASE("ExpressionTest.testOptimize")
   CHECK(IO::ELParser::parseStrict(expression).optimize() == expectedExpression);
 }
 
+TEST_CASE("ExpressionTest.variableNames")
+{
+  using T = std::tuple<std::string, std::vector<std::string>>;
+
+  // clang-format off
+  const auto
+  [expression,                     expectedVariableNames] = GENERATE(values<T>({
+  {"1 + 2",                        {}},
+  {"a",                            {"a"}},
+  {"[b, a, b]",                    {"a", "b"}},
+  {"{x: a, y: -b}",                {"a", "b"}},
+  {"a[b + 1]",                     {"a", "b"}},
+  {"{{ a == 1 -> b, c }}",         {"a", "b", "c"}},
+  }));
+  // clang-format on
+
+  CAPTURE(expression);
+
+  CHECK(IO::ELParser::parseStrict(expression).variableNames() == expectedVariableNames);
+}
+
 namespace
 {
 std::vector<std::string> preorderVisit(const std::string& str)
@@ -0,0 +1,143 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/EntityChunks.h"
+
+#include <string_view>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::IO
+{
+
+using namespace std::string_view_literals;
+
+TEST_CASE("findEntityChunks")
+{
+  SECTION("Empty map")
+  {
+    CHECK(findEntityChunks("", 1024) == std::vector<EntityChunks>{});
+    CHECK(findEntityChunks("  // comment\n", 1024) == std::vector<EntityChunks>{});
+  }
+
+  SECTION("Entities without brushes")
+  {
+    const auto str = R"({
+"classname" "worldspawn"
+}
+{
+"classname" "info_player_start"
+})"sv;
+
+    CHECK(
+      findEntityChunks(str, 1024)
+      == std::vector<EntityChunks>{
+        {{str.substr(0, 27), 1, 1}, {}, 3, 1},
+        {{str.substr(29, 34), 4, 1}, {}, 6, 1},
+      });
+  }
+
+  SECTION("Entities with brushes")
+  {
+    const auto str = R"({
+"classname" "worldspawn"
+{ ( 0 0 0 ) ( 0 0 0 ) ( 0 0 0 ) tex 0 0 0 1 1 }
+{ ( 0 0 0 ) ( 0 0 0 ) ( 0 0 0 ) tex 0 0 0 1 1 }
+// comment
+{ ( 0 0 0 ) ( 0 0 0 ) ( 0 0 0 ) tex 0 0 0 1 1 }
+})"sv;
+
+    SECTION("Large bodies")
+    {
+      CHECK(
+        findEntityChunks(str, 1024)
+        == std::vector<EntityChunks>{
+          {{str.substr(0, 27), 1, 1}, {{str.substr(27, 154), 3, 1}}, 7, 1},
+        });
+    }
+
+    SECTION("Medium bodies")
+    {
+      CHECK(
+        findEntityChunks(str, 64)
+        == std::vector<EntityChunks>{
+          {{str.substr(0, 27), 1, 1},
+           {{str.substr(27, 95), 3, 1}, {str.substr(134, 47), 6, 1}},
+           7,
+           1},
+        });
+    }
+
+    SECTION("Small bodies")
+    {
+      CHECK(
+        findEntityChunks(str, 40)
+        == std::vector<EntityChunks>{
+          {{str.substr(0, 27), 1, 1},
+           {{str.substr(27, 47), 3, 1},
+            {str.substr(75, 47), 4, 1},
+            {str.substr(134, 47), 6, 1}},
+           7,
+           1},
+        });
+    }
+  }
+
+  SECTION("Skips braces in strings, comments and material names")
+  {
+    const auto str = R"({
+"message" "{}}" // }
+; }
+{
+( 0 0 0 ) ( 0 0 0 ) ( 0 0 0 ) {fence 0 0 0 1 1
+( 0 0 0 ) ( 0 0 0 ) ( 0 0 0 ) "}fence" 0 0 0 1 1
+}
+})"sv;
+
+    CHECK(
+      findEntityChunks(str, 1024)
+      == std::vector<EntityChunks>{
+        {{str.substr(0, 27), 1, 1}, {{str.substr(27, 99), 4, 1}}, 8, 1},
+      });
+  }
+
+  SECTION("Keeps track of lines and columns")
+  {
+    const auto str = "{ \"a\" \"b\"\r\n  { ( 0 0 0 ) }  }"sv;
+
+    CHECK(
+      findEntityChunks(str, 1024)
+      == std::vector<EntityChunks>{
+        {{str.substr(0, 13), 1, 1}, {{str.substr(13, 13), 2, 3}}, 2, 18},
+      });
+  }
+
+  SECTION("Unrecognized structure")
+  {
+    CHECK(findEntityChunks("{", 1024) == std::nullopt);
+    CHECK(findEntityChunks("}", 1024) == std::nullopt);
+    CHECK(findEntityChunks("{ { }", 1024) == std::nullopt);
+    CHECK(findEntityChunks("{ \"a\" \"b }", 1024) == std::nullopt);
+    CHECK(findEntityChunks("\"a\" \"b\"", 1024) == std::nullopt);
+    CHECK(findEntityChunks("{ } junk", 1024) == std::nullopt);
+    CHECK(findEntityChunks("/// comment\n{ }", 1024) == std::nullopt);
+  }
+}
+
+} // namespace TrenchBroom::IO
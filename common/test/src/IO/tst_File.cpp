@@ -0,0 +1,119 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Error.h"
+#include "IO/File.h"
+#include "IO/Reader.h"
+
+#include "kdl/result.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::IO
+{
+
+namespace
+{
+const auto fixturePath = std::filesystem::path{"fixture/test/IO/Reader"};
+
+std::string readAll(Reader reader)
+{
+  return reader.readString(reader.size());
+}
+} // namespace
+
+TEST_CASE("CFile.defaultMode")
+{
+  // files are only mapped into memory on request
+  const auto file = createCFile(fixturePath / "10byte") | kdl::value();
+  CHECK(file->mapping() == nullptr);
+  CHECK(readAll(file->reader()) == "abcdefghij");
+}
+
+TEST_CASE("CFile")
+{
+  const auto mode = GENERATE(CFileMode::Stream, CFileMode::MemoryMap);
+  CAPTURE(mode);
+
+  SECTION("Empty file")
+  {
+    const auto file = createCFile(fixturePath / "empty", mode) | kdl::value();
+    CHECK(file->size() == 0u);
+    CHECK(file->mapping() == nullptr);
+    CHECK(file->reader().eof());
+  }
+
+  SECTION("Non empty file")
+  {
+    const auto file = createCFile(fixturePath / "10byte", mode) | kdl::value();
+    CHECK(file->size() == 10u);
+    CHECK((file->mapping() != nullptr) == (mode == CFileMode::MemoryMap));
+    CHECK(readAll(file->reader()) == "abcdefghij");
+
+    const auto buffer = file->buffer();
+    REQUIRE(buffer != nullptr);
+    CHECK(readAll(buffer->reader()) == "abcdefghij");
+  }
+
+  SECTION("File views")
+  {
+    const auto file = createCFile(fixturePath / "10byte", mode) | kdl::value();
+    const auto view = FileView{file, 2, 5};
+    CHECK(view.size() == 5u);
+    CHECK(readAll(view.reader()) == "cdefg");
+    CHECK(readAll(view.reader().buffer()) == "cdefg");
+  }
+
+  SECTION("Concurrent readers")
+  {
+    const auto file = createCFile(fixturePath / "10byte", mode) | kdl::value();
+
+    auto results = std::vector<std::string>(8);
+    auto threads = std::vector<std::thread>{};
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+      threads.emplace_back([&, i]() {
+        auto result = std::string{};
+        for (size_t j = 0; j < 100; ++j)
+        {
+          result = readAll(FileView{file, i % 5, 5}.reader());
+        }
+        results[i] = std::move(result);
+      });
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+      CHECK(results[i] == std::string{"abcdefghij"}.substr(i % 5, 5));
+    }
+  }
+}
+
+} // namespace TrenchBroom::IO
@@ -273,5 +273,45 @@ TEST_CASE("TokenizerTest.simpleLanguageBlockWithNegativeDecimalAttribute")
   CHECK((token = tokenizer.nextToken()).type() == SimpleToken::CBrace);
   CHECK(tokenizer.nextToken().type() == SimpleToken::Eof);
 }
+
+TEST_CASE("TokenizerTest.simpleLanguageLongTokens")
+{
+  const std::string testString(
+    "{\n"
+    "  a_very_long_attribute_name_spanning_several_words =\n"
+    "    12345678901234567;\n"
+    "  another_long_attribute_name = -1234567.8901234567;\n"
+    "}");
+
+  SimpleTokenizer tokenizer(testString);
+  SimpleTokenizer::Token token;
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::OBrace);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::String);
+  CHECK(token.data() == "a_very_long_attribute_name_spanning_several_words");
+  CHECK(token.line() == 2u);
+  CHECK(token.column() == 3u);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::Equals);
+  CHECK(token.line() == 2u);
+  CHECK(token.column() == 53u);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::Integer);
+  CHECK(token.toInteger<long>() == 12345678901234567l);
+  CHECK(token.line() == 3u);
+  CHECK(token.column() == 5u);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::Semicolon);
+  CHECK(token.column() == 22u);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::String);
+  CHECK(token.data() == "another_long_attribute_name");
+  CHECK(token.line() == 4u);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::Equals);
+  CHECK(token.column() == 31u);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::Decimal);
+  CHECK(token.toFloat<double>() == vm::approx(-1234567.8901234567));
+  CHECK(token.column() == 33u);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::Semicolon);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::CBrace);
+  CHECK(token.line() == 5u);
+  CHECK(token.column() == 1u);
+  CHECK(tokenizer.nextToken().type() == SimpleToken::Eof);
+}
 } // namespace IO
 } // namespace TrenchBroom
@@ -19,6 +19,7 @@
 
 #include "IO/DiskIO.h"
 #include "IO/File.h"
+#include "IO/MapCache.h"
 #include "IO/TestParserStatus.h"
 #include "IO/WorldReader.h"
 #include "Model/BezierPatch.h"
@@ -40,7 +41,9 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <filesystem>
+#include <limits>
 #include <string>
 
 #include "CatchUtils/Matchers.h"
@@ -1966,4 +1969,244 @@ TEST_CASE("WorldReader.parseUnknownFormatEmptyMap")
   CHECK(world->mapFormat() == Model::MapFormat::Standard);
 }
 
+namespace
+{
+void checkSameNodes(const Model::Node& lhs, const Model::Node& rhs)
+{
+  CAPTURE(lhs.name(), lhs.lineNumber());
+
+  CHECK(lhs.name() == rhs.name());
+  CHECK(lhs.lineNumber() == rhs.lineNumber());
+  REQUIRE(lhs.childCount() == rhs.childCount());
+
+  if (const auto* lhsBrushNode = dynamic_cast<const Model::BrushNode*>(&lhs))
+  {
+    const auto* rhsBrushNode = dynamic_cast<const Model::BrushNode*>(&rhs);
+    REQUIRE(rhsBrushNode != nullptr);
+    CHECK(*lhsBrushNode == *rhsBrushNode);
+  }
+  else if (const auto* lhsEntityNode = dynamic_cast<const Model::EntityNodeBase*>(&lhs))
+  {
+    const auto* rhsEntityNode = dynamic_cast<const Model::EntityNodeBase*>(&rhs);
+    REQUIRE(rhsEntityNode != nullptr);
+    CHECK(lhsEntityNode->entity().properties() == rhsEntityNode->entity().properties());
+  }
+
+  for (size_t i = 0; i < lhs.childCount(); ++i)
+  {
+    checkSameNodes(*lhs.children()[i], *rhs.children()[i]);
+  }
+}
+} // namespace
+
+TEST_CASE("WorldReader.parseInParallel")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  SECTION("Parallel parsing creates the same nodes as serial parsing")
+  {
+    const auto mapPath =
+      std::filesystem::current_path() / "fixture/test/IO/Map/rtz_q1.map";
+    const auto file = Disk::openFile(mapPath) | kdl::value();
+    auto fileReader = file->reader().buffer();
+
+    auto serialStatus = TestParserStatus{};
+    auto serialReader =
+      WorldReader{fileReader.stringView(), Model::MapFormat::Standard, {}};
+    serialReader.setParallelParsingThreshold(std::numeric_limits<size_t>::max());
+    const auto serialWorldNode = serialReader.read(worldBounds, serialStatus);
+
+    auto parallelStatus = TestParserStatus{};
+    auto parallelReader =
+      WorldReader{fileReader.stringView(), Model::MapFormat::Standard, {}};
+    parallelReader.setParallelParsingThreshold(0);
+    const auto parallelWorldNode = parallelReader.read(worldBounds, parallelStatus);
+
+    checkSameNodes(*serialWorldNode, *parallelWorldNode);
+  }
+
+  SECTION("Errors are reported at the same locations")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+"message" "}" // a brace in a string
+{
+( -64 -64 -16 ) ( -64 -63 -16 ) ( -64 -64 -15 ) {fence 0 0 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) {fence 0 0 0 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) {fence 0 0 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) {fence 0 0 0 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) {fence 0 0 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) {fence 0 0 0 1 1
+}
+}
+{
+"classname" "info_player_start"
+"origin" "1 2 3"
+"origin" "4 5 6"
+}
+{
+"classname" "func_door"
+{
+( -64 -64 -16 ) ( -64 -64 -16 ) ( -64 -64 -16 ) tex 0 0 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) tex 0 0 0 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) tex 0 0 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) tex 0 0 0 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) tex 0 0 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) tex 0 0 0 1 1
+}
+}
+)";
+
+    auto serialStatus = TestParserStatus{};
+    auto serialReader = WorldReader{data, Model::MapFormat::Standard, {}};
+    serialReader.setParallelParsingThreshold(std::numeric_limits<size_t>::max());
+    const auto serialWorldNode = serialReader.read(worldBounds, serialStatus);
+
+    auto parallelStatus = TestParserStatus{};
+    auto parallelReader = WorldReader{data, Model::MapFormat::Standard, {}};
+    parallelReader.setParallelParsingThreshold(0);
+    const auto parallelWorldNode = parallelReader.read(worldBounds, parallelStatus);
+
+    checkSameNodes(*serialWorldNode, *parallelWorldNode);
+
+    CHECK(parallelStatus.countStatus(LogLevel::Warn) > 0u);
+    CHECK(parallelStatus.countStatus(LogLevel::Error) > 0u);
+    CHECK(
+      parallelStatus.messages(LogLevel::Warn)
+      == serialStatus.messages(LogLevel::Warn));
+    CHECK(
+      parallelStatus.messages(LogLevel::Error)
+      == serialStatus.messages(LogLevel::Error));
+  }
+}
+
+
+TEST_CASE("WorldReader.readCache")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  const auto mapPath = std::filesystem::current_path() / "fixture/test/IO/Map/rtz_q1.map";
+  const auto file = Disk::openFile(mapPath) | kdl::value();
+  auto fileReader = file->reader().buffer();
+
+  auto status = TestParserStatus{};
+  auto uncachedReader =
+    WorldReader{fileReader.stringView(), Model::MapFormat::Standard, {}};
+  const auto uncachedWorldNode = uncachedReader.read(worldBounds, status);
+
+  auto writingReader =
+    WorldReader{fileReader.stringView(), Model::MapFormat::Standard, {}};
+  writingReader.setCache("");
+  writingReader.read(worldBounds, status);
+  REQUIRE(writingReader.updatedCache() != std::nullopt);
+
+  const auto cache = *writingReader.updatedCache();
+
+  SECTION("Reading from an up to date cache creates the same nodes")
+  {
+    auto cachedReader =
+      WorldReader{fileReader.stringView(), Model::MapFormat::Standard, {}};
+    cachedReader.setCache(cache);
+    const auto cachedWorldNode = cachedReader.read(worldBounds, status);
+
+    CHECK(cachedReader.updatedCache() == std::nullopt);
+    checkSameNodes(*uncachedWorldNode, *cachedWorldNode);
+  }
+
+  SECTION("A stale cache is ignored and updated")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+}
+)";
+
+    auto staleReader = WorldReader{data, Model::MapFormat::Standard, {}};
+    staleReader.setCache(cache);
+    const auto worldNode = staleReader.read(worldBounds, status);
+
+    CHECK(staleReader.updatedCache() != std::nullopt);
+    CHECK(staleReader.updatedCache() != cache);
+    CHECK(worldNode->defaultLayer()->childCount() == 0u);
+  }
+
+  SECTION("A cache for a different map format is ignored")
+  {
+    const auto key = mapCacheKey(fileReader.stringView());
+    CHECK(
+      readMapCache(cache, key, Model::MapFormat::Standard, Model::MapFormat::Standard)
+        .has_value());
+    CHECK_FALSE(
+      readMapCache(cache, key, Model::MapFormat::Standard, Model::MapFormat::Valve)
+        .has_value());
+  }
+
+  SECTION("A truncated cache is ignored")
+  {
+    auto truncatedReader =
+      WorldReader{fileReader.stringView(), Model::MapFormat::Standard, {}};
+    truncatedReader.setCache(std::string_view{cache}.substr(0, cache.size() / 2));
+    const auto worldNode = truncatedReader.read(worldBounds, status);
+
+    CHECK(truncatedReader.updatedCache() == cache);
+    checkSameNodes(*uncachedWorldNode, *worldNode);
+  }
+
+  SECTION("A cache with a corrupt object count is ignored")
+  {
+    // the object count follows the magic, version, key and map formats
+    const auto objectCountOffset = size_t(8 + 4 + 8 + 4 + 4);
+    auto corruptCache = cache;
+    std::fill_n(corruptCache.begin() + objectCountOffset, 8, char(0xff));
+
+    auto corruptReader =
+      WorldReader{fileReader.stringView(), Model::MapFormat::Standard, {}};
+    corruptReader.setCache(corruptCache);
+    const auto worldNode = corruptReader.read(worldBounds, status);
+
+    CHECK(corruptReader.updatedCache() == cache);
+    checkSameNodes(*uncachedWorldNode, *worldNode);
+  }
+}
+
+TEST_CASE("WorldReader.readCacheMessages")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  const auto data = R"(
+{
+"classname" "worldspawn"
+"message" "first"
+"message" "second"
+{
+( -64 -64 -16 ) ( -64 -64 -16 ) ( -64 -64 -16 ) tex 0 0 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) tex 0 0 0 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) tex 0 0 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) tex 0 0 0 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) tex 0 0 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) tex 0 0 0 1 1
+}
+}
+)";
+
+  auto writingStatus = TestParserStatus{};
+  auto writingReader = WorldReader{data, Model::MapFormat::Standard, {}};
+  writingReader.setCache("");
+  writingReader.read(worldBounds, writingStatus);
+  REQUIRE(writingReader.updatedCache() != std::nullopt);
+  REQUIRE(writingStatus.countStatus(LogLevel::Warn) > 0u);
+  REQUIRE(writingStatus.countStatus(LogLevel::Error) > 0u);
+
+  auto cachedStatus = TestParserStatus{};
+  auto cachedReader = WorldReader{data, Model::MapFormat::Standard, {}};
+  cachedReader.setCache(*writingReader.updatedCache());
+  cachedReader.read(worldBounds, cachedStatus);
+  REQUIRE(cachedReader.updatedCache() == std::nullopt);
+
+  CHECK(cachedStatus.messages(LogLevel::Warn) == writingStatus.messages(LogLevel::Warn));
+  CHECK(
+    cachedStatus.messages(LogLevel::Error) == writingStatus.messages(LogLevel::Error));
+}
+
 } // namespace TrenchBroom::IO
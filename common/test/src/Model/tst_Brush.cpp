@@ -40,6 +40,8 @@
 #include "kdl/vector_utils.h"
 
 #include "vm/approx.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
 #include "vm/polygon.h"
 #include "vm/ray.h"
 #include "vm/segment.h"
@@ -235,6 +237,92 @@ TEST_CASE("BrushTest.resizePastWorldBounds")
   CHECK(!canMoveBoundary(brush1, worldBounds, *rightFaceIndex, vm::vec3(8000, 0, 0)));
 }
 
+TEST_CASE("BrushTest.transform")
+{
+  const auto worldBounds = vm::bbox3{4096.0};
+  const auto builder = BrushBuilder{MapFormat::Valve, worldBounds};
+
+  const auto original =
+    builder.createCuboid(vm::bbox3{{0, 0, 0}, {64, 32, 16}}, "material") | kdl::value();
+
+  using T = std::tuple<vm::mat4x4, bool>;
+
+  // clang-format off
+  const auto
+  [transformation,                                            lockMaterials] = GENERATE(values<T>({
+  {vm::translation_matrix(vm::vec3{16, 32, 8}),               false},
+  {vm::translation_matrix(vm::vec3{16, 32, 8}),               true},
+  {vm::mat4x4::rot_90_z_ccw(),                                true},
+  {vm::rotation_matrix(vm::vec3::pos_z(), vm::to_radians(30.0)), true},
+  {vm::rotation_matrix(vm::vec3{1, 1, 1}, vm::to_radians(45.0)), false},
+  {vm::scaling_matrix(vm::vec3{2, 1, 0.5}),                    true},
+  {vm::mat4x4::mirror_x(),                                    true},
+  }));
+  // clang-format on
+
+  CAPTURE(transformation, lockMaterials);
+
+  auto brush = original;
+  REQUIRE(brush.transform(worldBounds, transformation, lockMaterials).is_success());
+
+  // the geometry must match the faces as if it had been rebuilt from them
+  const auto rebuilt = Brush::create(worldBounds, brush.faces()) | kdl::value();
+  CHECK(brush == rebuilt);
+  CHECK(brush.bounds().min == vm::approx{rebuilt.bounds().min});
+  CHECK(brush.bounds().max == vm::approx{rebuilt.bounds().max});
+  CHECK(brush.vertexCount() == rebuilt.vertexCount());
+  for (const auto& position : brush.vertexPositions())
+  {
+    CHECK(rebuilt.hasVertex(position, 0.01));
+  }
+
+  for (const auto& position : original.vertexPositions())
+  {
+    CHECK(brush.hasVertex(transformation * position, 0.01));
+  }
+}
+
+TEST_CASE("BrushTest.transformPastWorldBounds")
+{
+  const auto worldBounds = vm::bbox3{4096.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto brush =
+    builder.createCuboid(vm::bbox3{{0, 0, 0}, {64, 32, 16}}, "material") | kdl::value();
+  CHECK(brush.transform(
+          worldBounds, vm::translation_matrix(vm::vec3{4096, 0, 0}), false)
+          .is_error());
+}
+
+TEST_CASE("BrushTest.discardAndRestoreGeometry")
+{
+  const auto worldBounds = vm::bbox3{4096.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  const auto original =
+    builder.createCuboid(vm::bbox3{{0, 0, 0}, {64, 32, 16}}, "material") | kdl::value();
+
+  auto brush = original;
+  REQUIRE(brush.hasGeometry());
+
+  brush.discardGeometry();
+  CHECK_FALSE(brush.hasGeometry());
+  CHECK(brush == original);
+
+  const auto copy = brush;
+  CHECK_FALSE(copy.hasGeometry());
+
+  REQUIRE(brush.restoreGeometry(worldBounds).is_success());
+  CHECK(brush.hasGeometry());
+  CHECK(brush == original);
+  CHECK(brush.bounds() == original.bounds());
+  CHECK(brush.vertexCount() == original.vertexCount());
+  for (const auto& face : brush.faces())
+  {
+    CHECK(face.geometry() != nullptr);
+  }
+}
+
 TEST_CASE("BrushTest.expand")
 {
   const vm::bbox3 worldBounds(8192.0);
@@ -202,6 +202,31 @@ TEST_CASE("EntityTest")
     CHECK(
       entity.modelSpecification()
       == Assets::ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+    entity.addOrUpdateProperty("some_key", "2");
+    CHECK(
+      entity.modelSpecification()
+      == Assets::ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+    entity.removeProperty(EntityPropertyKeys::Spawnflags);
+    CHECK(
+      entity.modelSpecification()
+      == Assets::ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+
+    entity.renameProperty("some_key", EntityPropertyKeys::Spawnflags);
+    CHECK(
+      entity.modelSpecification()
+      == Assets::ModelSpecification{"maps/b_shell2.bsp", 0, 0});
+
+    entity.setProperties({{EntityPropertyKeys::Spawnflags, "1"}});
+    CHECK(
+      entity.modelSpecification()
+      == Assets::ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+    entity.removeNumberedProperty(EntityPropertyKeys::Spawnflags);
+    CHECK(
+      entity.modelSpecification()
+      == Assets::ModelSpecification{"maps/b_shell0.bsp", 0, 0});
   }
 
   SECTION("decalSpecification")
@@ -192,6 +192,48 @@ TEST_CASE("EntityNodeIndexTest.addRemoveFloatProperty")
   delete entity1;
 }
 
+TEST_CASE("EntityNodeIndexTest.addPropertyTwice")
+{
+  EntityNodeIndex index;
+
+  EntityNode* entity1 = new EntityNode(Entity{{{"test", "somevalue"}}});
+
+  index.addEntityNode(entity1);
+  index.addProperty(entity1, "test", "somevalue");
+
+  CHECK(
+    findExactExact(index, "test", "somevalue") == std::vector<EntityNodeBase*>{entity1});
+
+  index.removeProperty(entity1, "test", "somevalue");
+  CHECK(
+    findExactExact(index, "test", "somevalue") == std::vector<EntityNodeBase*>{entity1});
+  CHECK(index.allKeys() == std::vector<std::string>{"test"});
+
+  index.removeProperty(entity1, "test", "somevalue");
+  CHECK(findExactExact(index, "test", "somevalue").empty());
+  CHECK(index.allKeys().empty());
+
+  delete entity1;
+}
+
+TEST_CASE("EntityNodeIndexTest.findEntityNodesMatchesValuesExactly")
+{
+  EntityNodeIndex index;
+
+  EntityNode* entity1 = new EntityNode(Entity{{{"test", "somevalue"}}});
+  EntityNode* entity2 = new EntityNode(Entity{{{"test", "some*"}}});
+
+  index.addEntityNode(entity1);
+  index.addEntityNode(entity2);
+
+  CHECK(findExactExact(index, "test", "some*") == std::vector<EntityNodeBase*>{entity2});
+  CHECK(findExactExact(index, "test", "some").empty());
+  CHECK(findExactExact(index, "t*", "somevalue").empty());
+
+  delete entity1;
+  delete entity2;
+}
+
 TEST_CASE("EntityNodeIndexTest.allKeys")
 {
   EntityNodeIndex index;
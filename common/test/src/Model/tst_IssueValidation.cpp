@@ -0,0 +1,125 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Error.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/Group.h"
+#include "Model/GroupNode.h"
+#include "Model/Issue.h"
+#include "Model/IssueValidation.h"
+#include "Model/MapFormat.h"
+#include "Model/Validator.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+
+class CountingValidator : public Validator
+{
+public:
+  mutable std::atomic<size_t> count = 0;
+
+  CountingValidator()
+    : Validator{1, "counting"}
+  {
+  }
+
+private:
+  void doValidate(GroupNode& groupNode, std::vector<std::unique_ptr<Issue>>& issues)
+    const override
+  {
+    ++count;
+    issues.push_back(std::make_unique<Issue>(type(), groupNode, "group"));
+  }
+
+  void doValidate(EntityNodeBase& entityNode, std::vector<std::unique_ptr<Issue>>& issues)
+    const override
+  {
+    ++count;
+    issues.push_back(std::make_unique<Issue>(type(), entityNode, "entity"));
+  }
+
+  void doValidate(BrushNode& brushNode, std::vector<std::unique_ptr<Issue>>& issues)
+    const override
+  {
+    ++count;
+    issues.push_back(std::make_unique<Issue>(type(), brushNode, "brush"));
+  }
+};
+
+} // namespace
+
+TEST_CASE("validateIssues")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto groupNode = GroupNode{Group{"group"}};
+  auto nodes = std::vector<Node*>{&groupNode};
+  for (size_t i = 0; i < 100; ++i)
+  {
+    auto* entityNode = new EntityNode{Entity{}};
+    auto* brushNode = new BrushNode{builder.createCube(64.0, "material") | kdl::value()};
+    entityNode->addChild(brushNode);
+    groupNode.addChild(entityNode);
+
+    nodes.push_back(entityNode);
+    nodes.push_back(brushNode);
+  }
+
+  auto validator = CountingValidator{};
+  const auto validators = std::vector<const Validator*>{&validator};
+
+  const auto stats = validateIssues(nodes, validators);
+  REQUIRE(stats.size() == 1u);
+  CHECK(stats.front().validator == &validator);
+
+  CHECK(validator.count == nodes.size());
+  for (auto* node : nodes)
+  {
+    CHECK(node->issuesValid());
+    CHECK(node->issues(validators).size() == 1u);
+  }
+  CHECK(validator.count == nodes.size());
+
+  SECTION("Only invalidated nodes are validated again")
+  {
+    nodes[1]->invalidateIssues();
+    nodes[2]->invalidateIssues();
+
+    validateIssues(nodes, validators);
+    CHECK(validator.count == nodes.size() + 2u);
+  }
+}
+
+} // namespace TrenchBroom::Model
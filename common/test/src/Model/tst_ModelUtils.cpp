@@ -340,6 +340,79 @@ TEST_CASE("ModelUtils.collectContainedNodes")
       std::vector<Node*>{&groupNode, &entityNode, &brushNode, &patchNode}));
 }
 
+TEST_CASE("ModelUtils.collectTouchingAndContainedNodesInWorld")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  const auto builder = BrushBuilder{mapFormat, worldBounds};
+  const auto createBrushNode = [&](const FloatType size, const vm::vec3d& center) {
+    auto* brushNode =
+      new BrushNode{builder.createCube(size, "material") | kdl::value()};
+    transformNode(*brushNode, vm::translation_matrix(center), worldBounds);
+    return brushNode;
+  };
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+
+  // the group's bounds contain the gap between its brushes
+  auto* groupNode = new GroupNode{Group{"group"}};
+  groupNode->addChild(createBrushNode(64.0, {0, 0, 0}));
+  groupNode->addChild(createBrushNode(64.0, {512, 0, 0}));
+
+  auto* brushNode = createBrushNode(64.0, {-256, 0, 0});
+  auto* entityNode = new EntityNode{Entity{}};
+  transformNode(
+    *entityNode, vm::translation_matrix(vm::vec3d{0, 256, 0}), worldBounds);
+
+  worldNode.defaultLayer()->addChildren({groupNode, brushNode, entityNode});
+
+  auto touchesGroupGap = BrushNode{builder.createCube(24.0, "material") | kdl::value()};
+  transformNode(
+    touchesGroupGap, vm::translation_matrix(vm::vec3d{256, 0, 0}), worldBounds);
+
+  auto touchesBrush = BrushNode{builder.createCube(24.0, "material") | kdl::value()};
+  transformNode(
+    touchesBrush, vm::translation_matrix(vm::vec3d{-224, 0, 0}), worldBounds);
+
+  auto containsEntity = BrushNode{builder.createCube(128.0, "material") | kdl::value()};
+  transformNode(
+    containsEntity, vm::translation_matrix(vm::vec3d{0, 256, 0}), worldBounds);
+
+  auto touchesNothing = BrushNode{builder.createCube(24.0, "material") | kdl::value()};
+  transformNode(
+    touchesNothing, vm::translation_matrix(vm::vec3d{0, -1024, 0}), worldBounds);
+
+  const auto queries = std::vector<std::vector<BrushNode*>>{
+    {&touchesGroupGap},
+    {&touchesBrush},
+    {&containsEntity},
+    {&touchesNothing},
+    {&touchesGroupGap, &touchesBrush, &containsEntity, &touchesNothing},
+  };
+
+  for (const auto& brushes : queries)
+  {
+    CHECK_THAT(
+      collectTouchingNodes(worldNode, brushes),
+      Catch::Matchers::Equals(collectTouchingNodes({&worldNode}, brushes)));
+    CHECK_THAT(
+      collectContainedNodes(worldNode, brushes),
+      Catch::Matchers::Equals(collectContainedNodes({&worldNode}, brushes)));
+  }
+
+  CHECK_THAT(
+    collectTouchingNodes(worldNode, {&touchesGroupGap}),
+    Catch::Matchers::Equals(std::vector<Node*>{groupNode}));
+  CHECK_THAT(
+    collectTouchingNodes(worldNode, {&touchesBrush}),
+    Catch::Matchers::Equals(std::vector<Node*>{brushNode}));
+  CHECK_THAT(
+    collectContainedNodes(worldNode, {&containsEntity}),
+    Catch::Matchers::Equals(std::vector<Node*>{entityNode}));
+  CHECK(collectTouchingNodes(worldNode, {&touchesNothing}).empty());
+}
+
 TEST_CASE("ModelUtils.collectSelectedNodes")
 {
   constexpr auto worldBounds = vm::bbox3d{8192.0};
@@ -23,12 +23,17 @@
 #include "Model/Polyhedron_DefaultPayload.h"
 #include "Model/Polyhedron_Instantiation.h"
 
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
 #include "vm/plane.h"
 #include "vm/scalar.h"
 #include "vm/vec.h"
 #include "vm/vec_io.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iterator>
+#include <random>
 #include <set>
 #include <tuple>
 
@@ -465,6 +470,134 @@ TEST_CASE("PolyhedronTest.constructCube")
   CHECK(p.hasFace({p2, p6, p8, p4}));
 }
 
+TEST_CASE("PolyhedronTest.constructConvexHull")
+{
+  SECTION("Cube with redundant points")
+  {
+    const auto corners = std::vector<vm::vec3d>{
+      {-8, -8, -8},
+      {-8, -8, +8},
+      {-8, +8, -8},
+      {-8, +8, +8},
+      {+8, -8, -8},
+      {+8, -8, +8},
+      {+8, +8, -8},
+      {+8, +8, +8},
+    };
+
+    auto points = corners;
+    for (const auto x : {-8.0, 0.0, 8.0})
+    {
+      for (const auto y : {-8.0, 0.0, 8.0})
+      {
+        for (const auto z : {-8.0, 0.0, 8.0})
+        {
+          // edge midpoints, face centers and the center of the cube
+          points.emplace_back(x, y, z);
+        }
+      }
+    }
+
+    const auto p = Polyhedron3d{points};
+    CHECK(p.closed());
+    CHECK(hasVertices(p, corners));
+    CHECK(p.faceCount() == 6u);
+  }
+
+  SECTION("Vertices of a cylinder")
+  {
+    // when the vertex tool moves a vertex, every point is on the convex hull
+    auto points = std::vector<vm::vec3d>{};
+    for (size_t i = 0; i < 24; ++i)
+    {
+      const auto angle = vm::Cd::two_pi() * double(i) / 24.0;
+      const auto x = vm::round(std::cos(angle) * 64.0);
+      const auto y = vm::round(std::sin(angle) * 64.0);
+      points.emplace_back(x, y, 0.0);
+      points.emplace_back(x, y, 128.0);
+    }
+    points.front() = vm::vec3d{80, 16, -16};
+
+    const auto p = Polyhedron3d{points};
+    CHECK(p.closed());
+    CHECK(Polyhedron3d{p.vertexPositions()}.vertexCount() == p.vertexCount());
+    for (const auto& point : points)
+    {
+      if (!p.hasVertex(point))
+      {
+        CHECK(p.contains(point, vm::Cd::point_status_epsilon()));
+      }
+    }
+
+    CHECK_THAT(
+      p.vertexPositions(),
+      Catch::UnorderedEquals(
+        Polyhedron3d::incrementalConvexHull(points).vertexPositions()));
+  }
+
+  SECTION("Vertices of a sphere")
+  {
+    auto points = std::vector<vm::vec3d>{{0, 0, -512}, {0, 0, 512}};
+    for (size_t i = 1; i < 6; ++i)
+    {
+      const auto polarAngle = vm::Cd::pi() * double(i) / 6.0;
+      for (size_t j = 0; j < 12; ++j)
+      {
+        const auto azimuth = vm::Cd::two_pi() * double(j) / 12.0;
+        points.push_back(vm::round(
+          vm::vec3d{
+            std::sin(polarAngle) * std::cos(azimuth),
+            std::sin(polarAngle) * std::sin(azimuth),
+            -std::cos(polarAngle)}
+          * 512.0));
+      }
+    }
+    points.back() = points.back() * 1.5;
+
+    const auto p = Polyhedron3d{points};
+    CHECK(p.closed());
+    CHECK_THAT(
+      p.vertexPositions(),
+      Catch::UnorderedEquals(
+        Polyhedron3d::incrementalConvexHull(points).vertexPositions()));
+  }
+
+  SECTION("Random points")
+  {
+    auto rng = std::mt19937{0};
+    auto dist = std::uniform_real_distribution<double>{-1024.0, 1024.0};
+
+    auto points = std::vector<vm::vec3d>{};
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      points.push_back(vm::round(vm::vec3d{dist(rng), dist(rng), dist(rng)}));
+    }
+
+    const auto p = Polyhedron3d{points};
+    CHECK(p.closed());
+    CHECK(Polyhedron3d{p.vertexPositions()}.vertexCount() == p.vertexCount());
+    for (const auto* vertex : p.vertices())
+    {
+      CHECK(std::find(std::begin(points), std::end(points), vertex->position())
+            != std::end(points));
+    }
+    for (const auto& point : points)
+    {
+      if (!p.hasVertex(point))
+      {
+        CHECK(p.contains(point, vm::Cd::point_status_epsilon()));
+      }
+    }
+
+    // adding the points one by one is slow in debug builds, so only compare a subset
+    const auto subset = std::vector<vm::vec3d>(points.begin(), points.begin() + 100);
+    CHECK_THAT(
+      Polyhedron3d{subset}.vertexPositions(),
+      Catch::UnorderedEquals(
+        Polyhedron3d::incrementalConvexHull(subset).vertexPositions()));
+  }
+}
+
 TEST_CASE("PolyhedronTest.copy")
 {
   const vm::vec3d p1(0.0, 0.0, 8.0);
@@ -507,6 +640,73 @@ TEST_CASE("PolyhedronTest.swap")
   CHECK(rhs.bounds() == original.bounds());
 }
 
+TEST_CASE("PolyhedronTest.transform")
+{
+  const auto cube = Polyhedron3d{vm::bbox3d{{0, 0, 0}, {8, 8, 8}}};
+
+  const auto checkFacePlanes = [](const Polyhedron3d& p) {
+    for (const auto* face : p.faces())
+    {
+      for (const auto* halfEdge : face->boundary())
+      {
+        CHECK(
+          face->plane().point_status(halfEdge->origin()->position())
+          == vm::plane_status::inside);
+      }
+      // the normal must point away from the center
+      CHECK(vm::dot(face->plane().normal, face->center() - p.bounds().center()) > 0.0);
+    }
+  };
+
+  SECTION("Translation and scaling")
+  {
+    auto p = cube;
+    CHECK(p.transform(
+      vm::translation_matrix(vm::vec3d{8, 16, 32})
+      * vm::scaling_matrix(vm::vec3d{2, 1, 0.5})));
+    CHECK(p == Polyhedron3d{vm::bbox3d{{8, 16, 32}, {24, 24, 36}}});
+    CHECK(p.bounds() == vm::bbox3d{{8, 16, 32}, {24, 24, 36}});
+    checkFacePlanes(p);
+  }
+
+  SECTION("Rotation")
+  {
+    auto p = cube;
+    CHECK(p.transform(vm::mat4x4d::rot_90_z_ccw()));
+    CHECK(p == Polyhedron3d{vm::bbox3d{{-8, 0, 0}, {0, 8, 8}}});
+    checkFacePlanes(p);
+  }
+
+  SECTION("Shearing")
+  {
+    auto p = cube;
+    // clang-format off
+    const auto shear = vm::mat4x4d{
+      1, 1, 0, 0,
+      0, 1, 0, 0,
+      0, 0, 1, 0,
+      0, 0, 0, 1};
+    // clang-format on
+    CHECK(p.transform(shear));
+    CHECK(p.hasVertex(vm::vec3d{16, 8, 8}));
+    checkFacePlanes(p);
+  }
+
+  SECTION("Mirroring is rejected")
+  {
+    auto p = cube;
+    CHECK_FALSE(p.transform(vm::mat4x4d::mirror_x()));
+    CHECK(p == cube);
+  }
+
+  SECTION("Singular transformations are rejected")
+  {
+    auto p = cube;
+    CHECK_FALSE(p.transform(vm::scaling_matrix(vm::vec3d{1, 1, 0})));
+    CHECK(p == cube);
+  }
+}
+
 TEST_CASE("PolyhedronTest.clipCubeWithHorizontalPlane")
 {
   const vm::vec3d p1(-64.0, -64.0, -64.0);
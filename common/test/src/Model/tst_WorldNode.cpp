@@ -19,7 +19,9 @@
 
 #include "Model/BezierPatch.h"
 #include "Model/BrushBuilder.h"
+#include "Model/BrushFaceHandle.h"
 #include "Model/BrushNode.h"
+#include "Model/EditorContext.h"
 #include "Model/Entity.h"
 #include "Model/EntityNode.h"
 #include "Model/Group.h"
@@ -27,18 +29,24 @@
 #include "Model/Layer.h"
 #include "Model/LayerNode.h"
 #include "Model/MapFormat.h"
+#include "Model/NodeTree.h"
 #include "Model/PatchNode.h"
+#include "Model/PickResult.h"
 #include "Model/WorldNode.h"
 #include "TestUtils.h"
-#include "octree.h"
 
 #include "kdl/result.h"
 #include "kdl/result_io.h"
 #include "kdl/string_utils.h"
+#include "kdl/vector_utils.h"
 
 #include "vm/mat.h"
 #include "vm/mat_ext.h"
 #include "vm/mat_io.h"
+#include "vm/ray.h"
+
+#include <tuple>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -106,6 +114,7 @@ TEST_CASE("WorldNodeTest.nodeTreeUpdates")
   constexpr auto mapFormat = MapFormat::Quake3;
 
   auto worldNode = WorldNode{{}, {}, mapFormat};
+  worldNode.setNodeTreeType(GENERATE(NodeTreeType::Octree, NodeTreeType::Bvh));
   auto* layerNode = new LayerNode{Layer{"layer"}};
   auto* groupNode = new GroupNode{Group{"group"}};
   auto* entityNode = new EntityNode{Entity{}};
@@ -285,6 +294,37 @@ TEST_CASE("WorldNodeTest.rebuildNodeTree")
   CHECK(nodeTree.contains(patchNode));
 }
 
+TEST_CASE("WorldNodeTest.setNodeTreeType")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushNode = new BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "material") | kdl::value()};
+
+  worldNode.defaultLayer()->addChildren({entityNode, brushNode});
+
+  const auto& nodeTree = worldNode.nodeTree();
+  REQUIRE(worldNode.nodeTreeType() == NodeTreeType::Octree);
+  REQUIRE(nodeTree.type() == NodeTreeType::Octree);
+
+  worldNode.setNodeTreeType(NodeTreeType::Bvh);
+  CHECK(worldNode.nodeTreeType() == NodeTreeType::Bvh);
+  CHECK(nodeTree.type() == NodeTreeType::Bvh);
+  CHECK(nodeTree.contains(entityNode));
+  CHECK(nodeTree.contains(brushNode));
+  CHECK_THAT(
+    nodeTree.find_containers(vm::vec3d::zero()),
+    Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode}));
+
+  worldNode.setNodeTreeType(NodeTreeType::Octree);
+  CHECK(worldNode.nodeTreeType() == NodeTreeType::Octree);
+  CHECK(nodeTree.contains(entityNode));
+  CHECK(nodeTree.contains(brushNode));
+}
+
 TEST_CASE("WorldNodeTest.disableNodeTreeUpdates")
 {
   constexpr auto worldBounds = vm::bbox3d{8192.0};
@@ -322,6 +362,64 @@ TEST_CASE("WorldNodeTest.disableNodeTreeUpdates")
   CHECK(nodeTree.contains(patchNode));
 }
 
+TEST_CASE("WorldNodeTest.pickWithMultipleRays")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  const auto builder = BrushBuilder{mapFormat, worldBounds};
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  worldNode.setNodeTreeType(GENERATE(NodeTreeType::Octree, NodeTreeType::Bvh));
+
+  for (size_t i = 0; i < 4; ++i)
+  {
+    auto* brushNode =
+      new BrushNode{builder.createCube(64.0, "material") | kdl::value()};
+    transformNode(
+      *brushNode,
+      vm::translation_matrix(vm::vec3d{FloatType(i) * 128.0, 0, 0}),
+      worldBounds);
+    worldNode.defaultLayer()->addChild(brushNode);
+  }
+
+  const auto rays = std::vector<vm::ray3>{
+    {{0, 0, 128}, {0, 0, -1}},
+    {{256, 0, 128}, {0, 0, -1}},
+    {{-128, 0, 0}, {1, 0, 0}},
+    {{64, 0, 128}, {0, 0, -1}},
+    {{0, 1024, 0}, {0, 1, 0}},
+  };
+
+  const auto editorContext = EditorContext{};
+  auto pickResults = std::vector<PickResult>(rays.size());
+  worldNode.pick(editorContext, rays, pickResults);
+
+  for (size_t i = 0; i < rays.size(); ++i)
+  {
+    CAPTURE(i);
+
+    auto expected = PickResult{};
+    worldNode.pick(editorContext, rays[i], expected);
+
+    const auto toTargetsAndDistances = [](const auto& hits) {
+      return kdl::vec_transform(hits, [](const auto& hit) {
+        const auto handle = hit.template target<BrushFaceHandle>();
+        return std::tuple{handle.node(), handle.faceIndex(), hit.distance()};
+      });
+    };
+
+    CHECK(
+      toTargetsAndDistances(pickResults[i].all())
+      == toTargetsAndDistances(expected.all()));
+  }
+
+  CHECK(pickResults[0].all().size() == 1u);
+  CHECK(pickResults[2].all().size() == 4u);
+  CHECK(pickResults[3].all().empty());
+  CHECK(pickResults[4].all().empty());
+}
+
 TEST_CASE("WorldNodeTest.persistentIdOfDefaultLayer")
 {
   auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
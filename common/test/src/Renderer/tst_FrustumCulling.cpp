@@ -0,0 +1,130 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/FrustumCulling.h"
+#include "Renderer/OrthographicCamera.h"
+#include "Renderer/PerspectiveCamera.h"
+
+#include "vm/bbox_io.h"
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+
+TEST_CASE("ViewFrustum")
+{
+  SECTION("intersects")
+  {
+    // the box -1..1 on the x and y axes, unbounded along the z axis
+    const auto frustum = ViewFrustum{{
+      vm::plane3{1.0, vm::vec3{1, 0, 0}},
+      vm::plane3{1.0, vm::vec3{-1, 0, 0}},
+      vm::plane3{1.0, vm::vec3{0, 1, 0}},
+      vm::plane3{1.0, vm::vec3{0, -1, 0}},
+    }};
+
+    using T = std::tuple<vm::bbox3, bool>;
+
+    // clang-format off
+    const auto
+    [bounds,                                       expectedResult] = GENERATE(values<T>({
+    {vm::bbox3{{-0.5, -0.5, -0.5}, {0.5, 0.5, 0.5}}, true},
+    {vm::bbox3{{-4.0, -4.0, 100.0}, {4.0, 4.0, 200.0}}, true},
+    {vm::bbox3{{0.5, 0.5, 0.0}, {4.0, 4.0, 1.0}},     true},
+    {vm::bbox3{{1.0, 0.0, 0.0}, {2.0, 1.0, 1.0}},     true},
+    {vm::bbox3{{1.5, 0.0, 0.0}, {2.0, 1.0, 1.0}},     false},
+    {vm::bbox3{{-2.0, -2.0, 0.0}, {-1.5, 2.0, 1.0}},  false},
+    {vm::bbox3{{0.0, 1.5, 0.0}, {1.0, 2.0, 1.0}},     false},
+    }));
+    // clang-format on
+
+    CAPTURE(bounds);
+
+    CHECK(frustum.intersects(bounds) == expectedResult);
+  }
+
+  SECTION("perspective camera")
+  {
+    const auto camera = PerspectiveCamera{
+      90.0f,
+      1.0f,
+      1000.0f,
+      Camera::Viewport{0, 0, 800, 800},
+      vm::vec3f{0, 0, 0},
+      vm::vec3f{1, 0, 0},
+      vm::vec3f{0, 0, 1}};
+    const auto frustum = ViewFrustum{camera};
+
+    CHECK(frustum.planes().size() == 5u);
+
+    // in front of the camera
+    CHECK(frustum.intersects(vm::bbox3{{100, -8, -8}, {116, 8, 8}}));
+    // contains the camera
+    CHECK(frustum.intersects(vm::bbox3{{-8, -8, -8}, {8, 8, 8}}));
+    // behind the camera
+    CHECK_FALSE(frustum.intersects(vm::bbox3{{-116, -8, -8}, {-100, 8, 8}}));
+    // to the left of the camera
+    CHECK_FALSE(frustum.intersects(vm::bbox3{{100, 200, -8}, {116, 216, 8}}));
+    // above the camera
+    CHECK_FALSE(frustum.intersects(vm::bbox3{{100, -8, 200}, {116, 8, 216}}));
+    // beyond the far plane
+    CHECK_FALSE(frustum.intersects(vm::bbox3{{1100, -8, -8}, {1116, 8, 8}}));
+  }
+
+  SECTION("orthographic camera")
+  {
+    const auto camera = OrthographicCamera{
+      1.0f,
+      1000.0f,
+      Camera::Viewport{0, 0, 200, 100},
+      vm::vec3f{0, 0, 500},
+      vm::vec3f{0, 0, -1},
+      vm::vec3f{0, 1, 0}};
+    const auto frustum = ViewFrustum{camera};
+
+    CHECK(frustum.planes().size() == 4u);
+
+    CHECK(frustum.intersects(vm::bbox3{{-8, -8, -8}, {8, 8, 8}}));
+    CHECK(frustum.intersects(vm::bbox3{{90, 40, 0}, {110, 60, 8}}));
+    CHECK_FALSE(frustum.intersects(vm::bbox3{{110, -8, -8}, {120, 8, 8}}));
+    CHECK_FALSE(frustum.intersects(vm::bbox3{{-8, -70, -8}, {8, -60, 8}}));
+  }
+}
+
+TEST_CASE("mergeIndexRanges")
+{
+  CHECK(mergeIndexRanges({}) == std::vector<IndexRange>{});
+  CHECK(mergeIndexRanges({{0, 3}}) == std::vector<IndexRange>{{0, 3}});
+  CHECK(
+    mergeIndexRanges({{6, 3}, {0, 3}, {3, 3}}) == std::vector<IndexRange>{{0, 9}});
+  CHECK(
+    mergeIndexRanges({{12, 6}, {0, 3}, {3, 3}, {9, 3}})
+    == std::vector<IndexRange>{{0, 6}, {9, 9}});
+}
+
+TEST_CASE("CullingStats")
+{
+  auto stats = CullingStats{};
+  stats.add(10, 5);
+  stats.add(2, 3);
+  CHECK(stats == CullingStats{12, 8});
+}
+
+} // namespace TrenchBroom::Renderer
@@ -0,0 +1,79 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/PackedNormal.h"
+
+#include "vm/approx.h"
+#include "vm/vec.h"
+#include "vm/vec_io.h"
+
+#include <random>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+
+TEST_CASE("PackedNormal")
+{
+  SECTION("packNormal")
+  {
+    CHECK(packNormal(vm::vec3f{0, 0, 1}) == vm::vec<GLshort, 2>{0, 0});
+    CHECK(packNormal(vm::vec3f{1, 0, 0}) == vm::vec<GLshort, 2>{32767, 0});
+    CHECK(packNormal(vm::vec3f{0, -1, 0}) == vm::vec<GLshort, 2>{0, -32767});
+    CHECK(packNormal(vm::vec3f{0, 0, -1}) == vm::vec<GLshort, 2>{32767, 32767});
+  }
+
+  SECTION("unpackNormal restores the packed normal")
+  {
+    const auto normal = vm::normalize(GENERATE(values<vm::vec3f>({
+      {1, 0, 0},
+      {-1, 0, 0},
+      {0, 1, 0},
+      {0, -1, 0},
+      {0, 0, 1},
+      {0, 0, -1},
+      {1, 1, 0},
+      {1, 1, 1},
+      {-1, 1, -1},
+      {-1, -1, -1},
+      {0.1f, -0.2f, -3.0f},
+      {-4.0f, 0.3f, 0.02f},
+    })));
+
+    CAPTURE(normal);
+    CHECK(unpackNormal(packNormal(normal)) == vm::approx<vm::vec3f>{normal, 0.0001f});
+  }
+
+  SECTION("unpackNormal restores random normals")
+  {
+    auto rng = std::mt19937{};
+    auto dist = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      const auto normal = vm::normalize(vm::vec3f{dist(rng), dist(rng), dist(rng)});
+
+      CAPTURE(normal);
+      CHECK(unpackNormal(packNormal(normal)) == vm::approx<vm::vec3f>{normal, 0.0001f});
+    }
+  }
+}
+
+} // namespace TrenchBroom::Renderer
@@ -28,8 +28,10 @@
 #include <chrono>
 #include <memory>
 #include <optional>
+#include <string>
 #include <thread>
 #include <variant>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -242,6 +244,17 @@ public:
   }
 };
 
+class CompactableCommand : public NullCommand
+{
+public:
+  bool compacted = false;
+
+  using NullCommand::NullCommand;
+
+private:
+  void doCompact() override { compacted = true; }
+};
+
 TEST_CASE("CommandProcessorTest.doAndUndoSuccessfulCommand")
 {
   /*
@@ -818,5 +831,97 @@ TEST_CASE("CommandProcessorTest.collateTransactions")
 
   commandProcessor.undo();
 }
+
+TEST_CASE("CommandProcessorTest.memoryBudget")
+{
+  auto commandProcessor = CommandProcessor{nullptr};
+
+  CHECK(commandProcessor.memoryUsage() == 0u);
+
+  commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 1"));
+  const auto commandMemoryUsage = commandProcessor.memoryUsage();
+  CHECK(commandMemoryUsage > 0u);
+
+  commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 2"));
+  commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 3"));
+  CHECK(commandProcessor.memoryUsage() == 3u * commandMemoryUsage);
+
+  SECTION("Evicts the oldest commands when the budget is reduced")
+  {
+    commandProcessor.setMemoryBudget(2u * commandMemoryUsage);
+    CHECK(commandProcessor.memoryUsage() == 2u * commandMemoryUsage);
+
+    CHECK(commandProcessor.undo()->success());
+    CHECK(commandProcessor.undoCommandName() == "command 2");
+    CHECK(commandProcessor.undo()->success());
+    CHECK_FALSE(commandProcessor.canUndo());
+  }
+
+  SECTION("Counts the redo stack")
+  {
+    commandProcessor.undo();
+    CHECK(commandProcessor.memoryUsage() == 3u * commandMemoryUsage);
+
+    commandProcessor.setMemoryBudget(2u * commandMemoryUsage);
+    CHECK(commandProcessor.memoryUsage() == 2u * commandMemoryUsage);
+    CHECK(commandProcessor.undoCommandName() == "command 2");
+    CHECK(commandProcessor.redoCommandName() == "command 3");
+  }
+
+  SECTION("Evicts commands when storing a new command")
+  {
+    commandProcessor.setMemoryBudget(3u * commandMemoryUsage);
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 4"));
+    CHECK(commandProcessor.memoryUsage() == 3u * commandMemoryUsage);
+
+    commandProcessor.undo();
+    commandProcessor.undo();
+    CHECK(commandProcessor.undoCommandName() == "command 2");
+    commandProcessor.undo();
+    CHECK_FALSE(commandProcessor.canUndo());
+  }
+
+  SECTION("Never evicts the most recent command")
+  {
+    commandProcessor.setMemoryBudget(0u);
+    CHECK(commandProcessor.memoryUsage() == commandMemoryUsage);
+    CHECK(commandProcessor.undoCommandName() == "command 3");
+  }
+
+  SECTION("Clearing resets the memory usage")
+  {
+    commandProcessor.clear();
+    CHECK(commandProcessor.memoryUsage() == 0u);
+  }
+}
+
+TEST_CASE("CommandProcessorTest.compactOldCommands")
+{
+  auto commandProcessor = CommandProcessor{nullptr};
+
+  auto commands = std::vector<CompactableCommand*>{};
+  for (size_t i = 0; i < UncompactedCommandCount + 2; ++i)
+  {
+    auto command = std::make_unique<CompactableCommand>("command " + std::to_string(i));
+    commands.push_back(command.get());
+    commandProcessor.executeAndStore(std::move(command));
+  }
+
+  CHECK(commands[0]->compacted);
+  CHECK(commands[1]->compacted);
+  CHECK_FALSE(commands[2]->compacted);
+  CHECK_FALSE(commands.back()->compacted);
+
+  SECTION("Compacts old commands on the redo stack")
+  {
+    for (size_t i = 0; i < UncompactedCommandCount + 1; ++i)
+    {
+      CHECK(commandProcessor.undo()->success());
+    }
+
+    CHECK(commands.back()->compacted);
+    CHECK_FALSE(commands[2]->compacted);
+  }
+}
 } // namespace View
 } // namespace TrenchBroom
@@ -76,6 +76,31 @@ TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.swapBrushes")
   CHECK(brushNode->brush() == originalBrush);
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.undoVertexMove")
+{
+  auto* brushNode = createBrushNode();
+  document->addNodes({{document->parentForNodes(), {brushNode}}});
+  document->selectNodes({brushNode});
+
+  const auto originalPositions = brushNode->brush().vertexPositions();
+
+  // moving a vertex off the grid creates faces whose planes do not intersect exactly at
+  // the vertex positions
+  REQUIRE(
+    document->moveVertices({vm::vec3::fill(16.0)}, vm::vec3{1.0, 2.5, 3.0}).success);
+  const auto movedPositions = brushNode->brush().vertexPositions();
+  REQUIRE(movedPositions != originalPositions);
+
+  document->undoCommand();
+  CHECK(brushNode->brush().vertexPositions() == originalPositions);
+
+  document->redoCommand();
+  CHECK(brushNode->brush().vertexPositions() == movedPositions);
+
+  document->undoCommand();
+  CHECK(brushNode->brush().vertexPositions() == originalPositions);
+}
+
 TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.swapPatches")
 {
   auto* patchNode = createPatchNode();
@@ -24,6 +24,9 @@
 
 #include "vm/mat_ext.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom::View
@@ -86,4 +89,38 @@ TEST_CASE_METHOD(MapDocumentTest, "Transaction")
   }
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "Transaction.notifiesOfChangedNodesOnCommit")
+{
+  auto changedNodes = std::vector<std::vector<Model::Node*>>{};
+  auto connection = document->nodesDidChangeNotifier.connect(
+    [&](const auto& nodes) { changedNodes.push_back(nodes); });
+
+  auto* entityNode = new Model::EntityNode{Model::Entity{}};
+
+  auto transaction = Transaction{document};
+  document->addNodes({{document->parentForNodes(), {entityNode}}});
+  document->selectNodes({entityNode});
+  document->transformObjects("translate", vm::translation_matrix(vm::vec3{1, 0, 0}));
+  document->transformObjects("translate", vm::translation_matrix(vm::vec3{1, 0, 0}));
+
+  CHECK(changedNodes.empty());
+
+  SECTION("Changed nodes are notified once")
+  {
+    transaction.commit();
+
+    REQUIRE(changedNodes.size() == 1);
+    CHECK(std::ranges::count(changedNodes.front(), entityNode) == 1);
+  }
+
+  SECTION("Removed nodes are not notified")
+  {
+    document->deleteObjects();
+    transaction.commit();
+
+    REQUIRE(changedNodes.size() == 1);
+    CHECK(std::ranges::count(changedNodes.front(), entityNode) == 0);
+  }
+}
+
 } // namespace TrenchBroom::View
@@ -0,0 +1,142 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapDocumentTest.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/WorldNode.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/Lasso.h"
+#include "View/MapDocument.h"
+#include "View/VertexHandleManager.h"
+#include "View/VertexTool.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+#include "vm/vec_io.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::View
+{
+
+TEST_CASE_METHOD(MapDocumentTest, "VertexToolTest.undoAndRedoVertexMove")
+{
+  auto* brushNode = createBrushNode();
+  document->addNodes({{document->parentForNodes(), {brushNode}}});
+  document->selectNodes({brushNode});
+
+  auto tool = VertexTool{document};
+  REQUIRE(tool.activate());
+
+  auto& handles = tool.handleManager();
+  const auto originalPositions = brushNode->brush().vertexPositions();
+  REQUIRE_THAT(handles.allHandles(), Catch::UnorderedEquals(originalPositions));
+
+  const auto vertex = vm::vec3::fill(16.0);
+  const auto delta = vm::vec3{0, 0, 16};
+  handles.select(vertex);
+
+  // moveVertices executes its command in a transaction of its own
+  REQUIRE(document->moveVertices({vertex}, delta).success);
+
+  const auto movedPositions = brushNode->brush().vertexPositions();
+  CHECK_THAT(handles.allHandles(), Catch::UnorderedEquals(movedPositions));
+  CHECK(handles.selectedHandles() == std::vector<vm::vec3>{vertex + delta});
+
+  document->undoCommand();
+  CHECK_THAT(handles.allHandles(), Catch::UnorderedEquals(originalPositions));
+  CHECK(handles.selectedHandles() == std::vector<vm::vec3>{vertex});
+
+  document->redoCommand();
+  CHECK_THAT(handles.allHandles(), Catch::UnorderedEquals(movedPositions));
+  CHECK(handles.selectedHandles() == std::vector<vm::vec3>{vertex + delta});
+
+  // the handles are only removed if they were not added more than once
+  document->deselectAll();
+  CHECK(handles.totalHandleCount() == 0u);
+}
+
+TEST_CASE_METHOD(MapDocumentTest, "VertexToolTest.lassoSkipsOccludedVertices")
+{
+  auto* brushNode = createBrushNode();
+  document->addNodes({{document->parentForNodes(), {brushNode}}});
+  document->selectNodes({brushNode});
+
+  auto tool = VertexTool{document};
+  REQUIRE(tool.activate());
+
+  // Camera at 0 -200 0 looking towards +y
+  const auto camera = Renderer::PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8000.0f,
+    Renderer::Camera::Viewport{0, 0, 1920, 1080},
+    vm::vec3f{0.0f, -200.0f, 0.0f},
+    vm::vec3f::pos_y(),
+    vm::vec3f::pos_z()};
+
+  // the lasso contains the projections of all of the brush's vertices
+  const auto distance = 64.0;
+  const auto center = vm::vec3{camera.defaultPoint(static_cast<float>(distance))};
+  auto lasso = Lasso{camera, distance, center + vm::vec3{-100, 0, -100}};
+  lasso.update(center + vm::vec3{100, 0, 100});
+
+  auto& handles = tool.handleManager();
+
+  SECTION("Vertices behind the selected brush are selected")
+  {
+    tool.select(lasso, false);
+    CHECK_THAT(
+      handles.selectedHandles(),
+      Catch::UnorderedEquals(brushNode->brush().vertexPositions()));
+  }
+
+  SECTION("Vertices behind an unselected brush are not selected")
+  {
+    // a wall between the camera and the vertices with a positive x coordinate
+    const auto builder =
+      Model::BrushBuilder{document->world()->mapFormat(), document->worldBounds()};
+    auto* wallNode = new Model::BrushNode{
+      builder.createCuboid(
+        vm::bbox3{vm::vec3{4, -100, -64}, vm::vec3{64, -90, 64}}, "material")
+      | kdl::value()};
+    document->addNodes({{document->parentForNodes(), {wallNode}}});
+
+    auto expected = brushNode->brush().vertexPositions();
+    expected.erase(
+      std::remove_if(
+        expected.begin(),
+        expected.end(),
+        [](const auto& position) { return position.x() > 0.0; }),
+      expected.end());
+    REQUIRE(expected.size() == 4u);
+
+    tool.select(lasso, false);
+    CHECK_THAT(handles.selectedHandles(), Catch::UnorderedEquals(expected));
+  }
+}
+
+} // namespace TrenchBroom::View
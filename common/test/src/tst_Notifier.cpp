@@ -417,4 +417,110 @@ TEST_CASE("NotifyBeforeAndAfter")
     CHECK(moveCount <= 3);
   }
 }
+
+TEST_CASE("NotificationBatch")
+{
+  using Calls = std::vector<std::vector<int>>;
+
+  auto before = Notifier<const std::vector<int>&>{};
+  auto after = Notifier<const std::vector<int>&>{};
+  auto unbatchedBefore = Notifier<const std::vector<int>&>{};
+  auto unbatchedAfter = Notifier<const std::vector<int>&>{};
+
+  auto beforeCalls = Calls{};
+  auto afterCalls = Calls{};
+  auto unbatchedBeforeCalls = Calls{};
+  auto unbatchedAfterCalls = Calls{};
+
+  auto con = NotifierConnection{};
+  con += before.connect([&](const auto& objects) { beforeCalls.push_back(objects); });
+  con += after.connect([&](const auto& objects) { afterCalls.push_back(objects); });
+  con += unbatchedBefore.connect(
+    [&](const auto& objects) { unbatchedBeforeCalls.push_back(objects); });
+  con += unbatchedAfter.connect(
+    [&](const auto& objects) { unbatchedAfterCalls.push_back(objects); });
+
+  auto batch = NotificationBatch<int>{before, after, unbatchedBefore, unbatchedAfter};
+
+  SECTION("Notifies immediately if no batch is open")
+  {
+    {
+      const auto objects = std::vector<int>{1, 2};
+      auto notify = NotifyBeforeAndAfterInBatch{batch, objects};
+      CHECK(beforeCalls == Calls{{1, 2}});
+      CHECK(afterCalls == Calls{});
+    }
+    CHECK(afterCalls == Calls{{1, 2}});
+  }
+
+  SECTION("Coalesces notifications while a batch is open")
+  {
+    batch.begin();
+    batch.notifyBefore({1, 2});
+    batch.notifyAfter({1, 2});
+    batch.notifyBefore({2, 3});
+    batch.notifyAfter({2, 3});
+
+    CHECK(beforeCalls == Calls{{1, 2}, {3}});
+    CHECK(afterCalls == Calls{});
+
+    CHECK(batch.end() == 3);
+    CHECK(beforeCalls == Calls{{1, 2}, {3}});
+    CHECK(afterCalls == Calls{{1, 2, 3}});
+  }
+
+  SECTION("Notifies when the outermost batch ends")
+  {
+    batch.begin();
+    batch.notifyBefore({1});
+    batch.notifyAfter({1});
+
+    batch.begin();
+    batch.notifyBefore({1, 2});
+    batch.notifyAfter({1, 2});
+    CHECK(batch.end() == 0);
+    CHECK(afterCalls == Calls{});
+
+    CHECK(batch.end() == 2);
+    CHECK(afterCalls == Calls{{1, 2}});
+  }
+
+  SECTION("Does not notify of discarded objects")
+  {
+    batch.begin();
+    batch.notifyBefore({1, 2, 3});
+    batch.notifyAfter({1, 2, 3});
+    batch.discardIf([](const int i) { return i == 2; });
+
+    CHECK(batch.end() == 2);
+    CHECK(afterCalls == Calls{{1, 3}});
+  }
+
+  SECTION("Notifies the unbatched notifiers immediately")
+  {
+    batch.begin();
+    batch.notifyBefore({1, 2});
+    CHECK(unbatchedBeforeCalls == Calls{{1, 2}});
+    CHECK(unbatchedAfterCalls == Calls{});
+
+    batch.notifyAfter({1, 2});
+    CHECK(unbatchedAfterCalls == Calls{{1, 2}});
+
+    batch.notifyBefore({2, 3});
+    batch.notifyAfter({2, 3});
+    CHECK(unbatchedBeforeCalls == Calls{{1, 2}, {2, 3}});
+    CHECK(unbatchedAfterCalls == Calls{{1, 2}, {2, 3}});
+
+    batch.end();
+    CHECK(unbatchedAfterCalls == Calls{{1, 2}, {2, 3}});
+  }
+
+  SECTION("Does not notify if nothing changed")
+  {
+    batch.begin();
+    CHECK(batch.end() == 0);
+    CHECK(beforeCalls == Calls{});
+    CHECK(afterCalls == Calls{});
+  }
+}
 } // namespace TrenchBroom
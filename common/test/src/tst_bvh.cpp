@@ -0,0 +1,378 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bvh.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+
+namespace
+{
+
+template <typename T>
+std::vector<T> sorted(std::vector<T> v)
+{
+  std::sort(v.begin(), v.end());
+  return v;
+}
+
+template <typename P>
+std::vector<int> findMatching(const std::map<int, vm::bbox3d>& items, const P& predicate)
+{
+  auto result = std::vector<int>{};
+  for (const auto& [data, bounds] : items)
+  {
+    if (predicate(bounds))
+    {
+      result.push_back(data);
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("bvh.insert")
+{
+  auto tree = bvh<double, int>{};
+  REQUIRE(tree.empty());
+  REQUIRE(tree.height() == 0u);
+
+  tree.insert({{0, 0, 0}, {16, 16, 16}}, 1);
+  CHECK_FALSE(tree.empty());
+  CHECK(tree.height() == 1u);
+  CHECK(tree.bounds(1) == vm::bbox3d{{0, 0, 0}, {16, 16, 16}});
+
+  tree.insert({{32, 32, 32}, {64, 64, 64}}, 2);
+  CHECK(tree.height() == 2u);
+  CHECK(tree.bounds(2) == vm::bbox3d{{32, 32, 32}, {64, 64, 64}});
+
+  CHECK_THROWS_AS(tree.insert(vm::bbox3d{{0, 0, 0}, {2, 1, 1}}, 1), NodeTreeException);
+  CHECK_THROWS_AS(
+    tree.insert(vm::bbox3d{{0, 0, 0}, {std::nan(""), 1, 1}}, 3), NodeTreeException);
+}
+
+TEST_CASE("bvh.insert_keeps_tree_balanced")
+{
+  auto tree = bvh<double, int>{};
+
+  // inserting sorted items degenerates an unbalanced tree into a list
+  for (int i = 0; i < 1024; ++i)
+  {
+    const auto x = double(i) * 64.0;
+    tree.insert({{x, 0, 0}, {x + 32, 32, 32}}, i);
+  }
+
+  CHECK(tree.height() <= 20u);
+}
+
+TEST_CASE("bvh.insert_rotates_new_parent")
+{
+  auto tree = bvh<double, int>{};
+  tree.insert({{0, 0, 0}, {16, 16, 16}}, 1);
+  tree.insert({{32, 0, 0}, {48, 16, 16}}, 2);
+  tree.insert({{64, 0, 0}, {80, 16, 16}}, 3);
+  REQUIRE(tree.height() == 3u);
+
+  // the new leaf becomes the sibling of the root, so the new root must be rotated
+  tree.insert({{-1024, -1024, -1024}, {1024, 1024, 1024}}, 4);
+  CHECK(tree.height() == 3u);
+}
+
+TEST_CASE("bvh.remove")
+{
+  auto tree = bvh<double, int>{};
+
+  CHECK_FALSE(tree.remove(1));
+
+  tree.insert({{0, 0, 0}, {16, 16, 16}}, 1);
+  tree.insert({{32, 32, 32}, {64, 64, 64}}, 2);
+  tree.insert({{-64, -64, -64}, {-32, -32, -32}}, 3);
+
+  CHECK(tree.remove(2));
+  CHECK_FALSE(tree.contains(2));
+  CHECK_FALSE(tree.remove(2));
+  CHECK(tree.find_containers({48, 48, 48}).empty());
+  CHECK(tree.find_containers({-48, -48, -48}) == std::vector<int>{3});
+
+  CHECK(tree.remove(1));
+  CHECK(tree.remove(3));
+  CHECK(tree.empty());
+  CHECK(tree.height() == 0u);
+}
+
+TEST_CASE("bvh.update")
+{
+  auto tree = bvh<double, int>{};
+
+  CHECK_THROWS_AS(tree.update({{0, 0, 0}, {16, 16, 16}}, 1), NodeTreeException);
+
+  tree.insert({{0, 0, 0}, {16, 16, 16}}, 1);
+  tree.insert({{32, 32, 32}, {64, 64, 64}}, 2);
+
+  tree.update({{128, 128, 128}, {144, 144, 144}}, 1);
+  CHECK(tree.contains(1));
+  CHECK(tree.bounds(1) == vm::bbox3d{{128, 128, 128}, {144, 144, 144}});
+  CHECK(tree.find_containers({8, 8, 8}).empty());
+  CHECK(tree.find_containers({136, 136, 136}) == std::vector<int>{1});
+  CHECK(tree.find_containers({48, 48, 48}) == std::vector<int>{2});
+}
+
+TEST_CASE("bvh.build")
+{
+  auto tree = bvh<double, int>{};
+  tree.insert({{0, 0, 0}, {16, 16, 16}}, 1);
+
+  SECTION("replaces the contents of the tree")
+  {
+    tree.build({
+      {{{32, 32, 32}, {64, 64, 64}}, 2},
+      {{{-64, -64, -64}, {-32, -32, -32}}, 3},
+      {{{-64, -64, -64}, {-32, -32, -32}}, 4},
+    });
+
+    CHECK_FALSE(tree.contains(1));
+    CHECK(tree.contains(2));
+    CHECK(tree.contains(3));
+    CHECK(tree.contains(4));
+    CHECK(sorted(tree.find_containers({-48, -48, -48})) == std::vector<int>{3, 4});
+  }
+
+  SECTION("empty input")
+  {
+    tree.build({});
+    CHECK(tree.empty());
+  }
+
+  SECTION("duplicate data")
+  {
+    CHECK_THROWS_AS(
+      tree.build({
+        {{{32, 32, 32}, {64, 64, 64}}, 2},
+        {{{-64, -64, -64}, {-32, -32, -32}}, 2},
+      }),
+      NodeTreeException);
+    CHECK(tree.empty());
+  }
+
+  SECTION("invalid bounds")
+  {
+    CHECK_THROWS_AS(
+      tree.build({
+        {{{32, 32, 32}, {64, 64, 64}}, 1},
+        {{{0, 0, 0}, {std::nan(""), 1, 1}}, 2},
+      }),
+      NodeTreeException);
+    CHECK(tree.empty());
+    CHECK_FALSE(tree.contains(1));
+  }
+
+  SECTION("builds a balanced tree")
+  {
+    auto items = std::vector<std::pair<vm::bbox3d, int>>{};
+    for (int i = 0; i < 1024; ++i)
+    {
+      const auto x = double(i % 32) * 64.0;
+      const auto y = double(i / 32) * 64.0;
+      items.emplace_back(vm::bbox3d{{x, y, 0}, {x + 32, y + 32, 32}}, i);
+    }
+    tree.build(std::move(items));
+    CHECK(tree.height() <= 16u);
+  }
+}
+
+TEST_CASE("bvh.find_intersectors-ray")
+{
+  auto tree = bvh<double, int>{};
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_intersectors(vm::ray3d{{0, 0, 0}, {1, 0, 0}}).empty());
+  }
+
+  SECTION("single node")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+
+    CHECK(tree.find_intersectors(vm::ray3d{{48, 48, 0}, {0, 0, -1}}).empty());
+    CHECK(
+      tree.find_intersectors(vm::ray3d{{48, 48, 48}, {0, 0, -1}}) == std::vector<int>{1});
+    CHECK(
+      tree.find_intersectors(vm::ray3d{{48, 48, 0}, {0, 0, 1}}) == std::vector<int>{1});
+
+    // unlike the octree, only the bounds of the item are tested
+    CHECK(tree.find_intersectors(vm::ray3d{{0, 16, 16}, {0, 0, 1}}).empty());
+  }
+}
+
+TEST_CASE("bvh.find_intersectors-rays")
+{
+  using Hits = std::vector<std::pair<size_t, int>>;
+
+  auto tree = bvh<double, int>{};
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_intersectors(std::vector<vm::ray3d>{{{0, 0, 0}, {1, 0, 0}}}).empty());
+  }
+
+  SECTION("multiple nodes")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+    tree.insert({{-64, -64, -64}, {-32, -32, -32}}, 2);
+
+    CHECK(tree.find_intersectors(std::vector<vm::ray3d>{}).empty());
+
+    const auto rays = std::vector<vm::ray3d>{
+      {{48, 48, 0}, {0, 0, -1}},
+      {{48, 48, 48}, {0, 0, -1}},
+      {{48, 48, 0}, {0, 0, 1}},
+      {{-48, -48, 0}, {0, 0, -1}},
+      {{0, 0, 0}, vm::normalize(vm::vec3d{1, 1, 1})},
+      {{-128, -48, -48}, {1, 0, 0}},
+    };
+
+    CHECK(
+      sorted(tree.find_intersectors(rays))
+      == Hits{
+        {1, 1},
+        {2, 1},
+        {3, 2},
+        {4, 1},
+        {5, 2},
+      });
+  }
+}
+
+TEST_CASE("bvh.find_intersectors-bboxes")
+{
+  using Hits = std::vector<std::pair<size_t, int>>;
+
+  auto tree = bvh<double, int>{};
+  tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+  tree.insert({{-64, -64, -64}, {-32, -32, -32}}, 2);
+
+  CHECK(tree.find_intersectors(vm::bbox3d{{0, 0, 0}, {16, 16, 16}}).empty());
+  CHECK(
+    sorted(tree.find_intersectors(vm::bbox3d{{-48, -48, -48}, {48, 48, 48}}))
+    == std::vector<int>{1, 2});
+
+  CHECK(
+    sorted(tree.find_intersectors(std::vector<vm::bbox3d>{
+      {{0, 0, 0}, {16, 16, 16}},
+      {{-48, -48, -48}, {48, 48, 48}},
+      {{60, 60, 60}, {70, 70, 70}},
+    }))
+    == Hits{{1, 1}, {1, 2}, {2, 1}});
+}
+
+TEST_CASE("bvh.find_candidates")
+{
+  auto tree = bvh<double, int>{};
+  tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+  tree.insert({{-64, -64, -64}, {-32, -32, -32}}, 2);
+
+  CHECK(
+    sorted(tree.find_candidates([](const auto&) { return true; }))
+    == std::vector<int>{1, 2});
+  CHECK(
+    tree.find_candidates([](const auto& bounds) { return bounds.max.x() > 0.0; })
+    == std::vector<int>{1});
+}
+
+TEST_CASE("bvh.queries_match_brute_force")
+{
+  auto rng = std::mt19937{0};
+  auto position = std::uniform_real_distribution<double>{-1024.0, 1024.0};
+  auto size = std::uniform_real_distribution<double>{0.0, 256.0};
+
+  const auto randomBounds = [&]() {
+    const auto min = vm::vec3d{position(rng), position(rng), position(rng)};
+    return vm::bbox3d{min, min + vm::vec3d{size(rng), size(rng), size(rng)}};
+  };
+
+  auto tree = bvh<double, int>{};
+  auto items = std::map<int, vm::bbox3d>{};
+  auto nextData = 0;
+
+  for (size_t i = 0; i < 2000; ++i)
+  {
+    const auto operation = rng() % 10;
+    if (operation < 5 || items.empty())
+    {
+      const auto bounds = randomBounds();
+      tree.insert(bounds, nextData);
+      items.emplace(nextData++, bounds);
+    }
+    else if (operation < 7)
+    {
+      const auto it = std::next(items.begin(), std::ptrdiff_t(rng() % items.size()));
+      REQUIRE(tree.remove(it->first));
+      items.erase(it);
+    }
+    else if (operation < 9)
+    {
+      const auto it = std::next(items.begin(), std::ptrdiff_t(rng() % items.size()));
+      it->second = randomBounds();
+      tree.update(it->second, it->first);
+    }
+    else
+    {
+      tree.rebuild();
+    }
+
+    if (i % 20 == 0)
+    {
+      const auto bbox = randomBounds();
+      CHECK(
+        sorted(tree.find_intersectors(bbox))
+        == findMatching(items, [&](const auto& b) { return bbox.intersects(b); }));
+
+      const auto point = vm::vec3d{position(rng), position(rng), position(rng)};
+      CHECK(
+        sorted(tree.find_containers(point))
+        == findMatching(items, [&](const auto& b) { return b.contains(point); }));
+
+      const auto ray = vm::ray3d{
+        {position(rng), position(rng), position(rng)},
+        vm::normalize(vm::vec3d{position(rng), position(rng), position(rng)})};
+      const auto inverseDirection = vm::vec3d::one() / ray.direction;
+      CHECK(
+        sorted(tree.find_intersectors(ray))
+        == findMatching(items, [&](const auto& b) {
+             return detail::intersects_ray_bbox(ray, inverseDirection, b);
+           }));
+    }
+  }
+}
+
+} // namespace TrenchBroom
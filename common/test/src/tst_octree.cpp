@@ -26,6 +26,10 @@
 #include "vm/ray.h"
 #include "vm/vec.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom
@@ -620,6 +624,65 @@ TEST_CASE("octree.find_intersectors-ray")
   }
 }
 
+TEST_CASE("octree.find_intersectors-rays")
+{
+  using Hits = std::vector<std::pair<size_t, int>>;
+
+  auto tree = octree<double, int>{32.0};
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_intersectors(std::vector<vm::ray3d>{{{0, 0, 0}, {1, 0, 0}}}).empty());
+  }
+
+  SECTION("multiple nodes")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+    tree.insert({{-64, -64, -64}, {-32, -32, -32}}, 2);
+
+    SECTION("no rays")
+    {
+      CHECK(tree.find_intersectors(std::vector<vm::ray3d>{}).empty());
+    }
+
+    SECTION("every ray finds the same items as a single query")
+    {
+      const auto rays = std::vector<vm::ray3d>{
+        {{48, 48, 0}, {0, 0, -1}},
+        {{48, 48, 48}, {0, 0, -1}},
+        {{48, 48, 0}, {0, 0, 1}},
+        {{-48, -48, 0}, {0, 0, -1}},
+        {{0, 0, 0}, vm::normalize(vm::vec3d{1, 1, 1})},
+        {{-128, -48, -48}, {1, 0, 0}},
+      };
+
+      auto hits = tree.find_intersectors(rays);
+      std::sort(hits.begin(), hits.end());
+
+      auto expected = Hits{};
+      for (size_t i = 0; i < rays.size(); ++i)
+      {
+        for (const auto data : tree.find_intersectors(rays[i]))
+        {
+          expected.emplace_back(i, data);
+        }
+      }
+      std::sort(expected.begin(), expected.end());
+
+      CHECK(hits == expected);
+      CHECK(
+        hits
+        == Hits{
+          {1, 1},
+          {2, 1},
+          {3, 2},
+          {4, 1},
+          {5, 2},
+        });
+    }
+  }
+}
+
 TEST_CASE("octree.find_intersectors-bbox")
 {
   auto tree = octree<double, int>{32.0};
@@ -682,6 +745,42 @@ TEST_CASE("octree.find_intersectors-bbox")
   }
 }
 
+TEST_CASE("octree.find_intersectors-bboxes")
+{
+  using Hits = std::vector<std::pair<size_t, int>>;
+
+  auto tree = octree<double, int>{32.0};
+
+  SECTION("empty tree")
+  {
+    CHECK(
+      tree.find_intersectors(std::vector<vm::bbox3d>{{{0, 0, 0}, {1, 1, 1}}}).empty());
+  }
+
+  SECTION("multiple nodes")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+    tree.insert({{-64, -64, -64}, {-32, -32, -32}}, 2);
+
+    const auto bboxes = std::vector<vm::bbox3d>{
+      {{0, 0, 0}, {16, 16, 16}},
+      {{40, 40, 40}, {48, 48, 48}},
+      {{-48, -48, -48}, {48, 48, 48}},
+    };
+
+    auto hits = tree.find_intersectors(bboxes);
+    std::sort(hits.begin(), hits.end());
+
+    CHECK(
+      hits
+      == Hits{
+        {1, 1},
+        {2, 1},
+        {2, 2},
+      });
+  }
+}
+
 TEST_CASE("octree.find_containers")
 {
   auto tree = octree<double, int>{32.0};
@@ -724,4 +823,35 @@ TEST_CASE("octree.find_containers")
     CHECK(tree.find_containers({64, 64, 64}) == std::vector<int>{1});
   }
 }
+
+TEST_CASE("octree.find_candidates")
+{
+  auto tree = octree<double, int>{32.0};
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_candidates([](const auto&) { return true; }).empty());
+  }
+
+  SECTION("multiple nodes")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+    tree.insert({{-64, -64, -64}, {-32, -32, -32}}, 2);
+
+    CHECK_THAT(
+      tree.find_candidates([](const auto&) { return true; }),
+      Catch::UnorderedEquals(std::vector<int>{1, 2}));
+    CHECK(tree.find_candidates([](const auto&) { return false; }).empty());
+
+    // only visit tree nodes with non-negative x coordinates
+    CHECK(
+      tree.find_candidates([](const auto& bounds) { return bounds.max.x() > 0.0; })
+      == std::vector<int>{1});
+
+    // a tree node containing the data matches, but the data itself does not
+    CHECK_THAT(
+      tree.find_candidates([](const auto& bounds) { return bounds.min.x() < 40.0; }),
+      Catch::UnorderedEquals(std::vector<int>{1, 2}));
+  }
+}
 } // namespace TrenchBroom
@@ -0,0 +1,171 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace kdl
+{
+namespace detail
+{
+
+/**
+ * Stores each distinct string once. The table is split into shards with separate locks
+ * so that strings can be interned concurrently with little contention.
+ *
+ * The table is never destroyed so that interned strings remain valid during static
+ * destruction.
+ */
+class string_table
+{
+private:
+  static constexpr std::size_t shard_count = 32;
+
+  struct string_hash
+  {
+    using is_transparent = void;
+
+    std::size_t operator()(const std::string_view str) const noexcept
+    {
+      return std::hash<std::string_view>{}(str);
+    }
+  };
+
+  struct shard
+  {
+    std::mutex mutex;
+    std::unordered_set<std::string, string_hash, std::equal_to<>> strings;
+  };
+
+  std::array<shard, shard_count> m_shards;
+
+public:
+  static string_table& instance()
+  {
+    static auto* table = new string_table{};
+    return *table;
+  }
+
+  const std::string* intern(const std::string_view str)
+  {
+    auto& s = m_shards[string_hash{}(str) % shard_count];
+
+    auto lock = std::lock_guard{s.mutex};
+    auto it = s.strings.find(str);
+    if (it == s.strings.end())
+    {
+      it = s.strings.emplace(str).first;
+    }
+
+    // element addresses of unordered sets are stable
+    return &*it;
+  }
+};
+
+} // namespace detail
+
+/**
+ * A handle to a string that is stored once in a process wide table. Copying an interned
+ * string copies a pointer, and two interned strings are equal if and only if they refer
+ * to the same table entry, so equality comparison and hashing are constant time.
+ *
+ * Interning is thread safe. Interned strings are never released.
+ */
+class interned_string
+{
+private:
+  const std::string* m_str;
+
+public:
+  interned_string()
+    : interned_string{std::string_view{}}
+  {
+  }
+
+  explicit interned_string(const std::string_view str)
+    : m_str{detail::string_table::instance().intern(str)}
+  {
+  }
+
+  const std::string& str() const { return *m_str; }
+
+  operator const std::string&() const { return *m_str; }
+
+  bool empty() const { return m_str->empty(); }
+
+  /**
+   * Returns a value that uniquely identifies the interned string.
+   */
+  std::size_t id() const { return reinterpret_cast<std::size_t>(m_str); }
+
+  friend bool operator==(const interned_string& lhs, const interned_string& rhs)
+  {
+    return lhs.m_str == rhs.m_str;
+  }
+
+  friend bool operator!=(const interned_string& lhs, const interned_string& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  friend bool operator<(const interned_string& lhs, const interned_string& rhs)
+  {
+    return lhs != rhs && *lhs.m_str < *rhs.m_str;
+  }
+
+  friend bool operator<=(const interned_string& lhs, const interned_string& rhs)
+  {
+    return !(rhs < lhs);
+  }
+
+  friend bool operator>(const interned_string& lhs, const interned_string& rhs)
+  {
+    return rhs < lhs;
+  }
+
+  friend bool operator>=(const interned_string& lhs, const interned_string& rhs)
+  {
+    return !(lhs < rhs);
+  }
+
+  friend std::ostream& operator<<(std::ostream& str, const interned_string& s)
+  {
+    return str << *s.m_str;
+  }
+};
+
+} // namespace kdl
+
+template <>
+struct std::hash<kdl::interned_string>
+{
+  std::size_t operator()(const kdl::interned_string& s) const noexcept
+  {
+    return std::hash<std::size_t>{}(s.id());
+  }
+};
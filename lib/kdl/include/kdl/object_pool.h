@@ -0,0 +1,242 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace kdl
+{
+namespace detail
+{
+
+struct free_block
+{
+  free_block* next;
+};
+
+/**
+ * A list of free blocks that are linked through their first bytes.
+ */
+struct free_list
+{
+  free_block* head = nullptr;
+  std::size_t size = 0;
+
+  void push(void* ptr) noexcept
+  {
+    auto* block = static_cast<free_block*>(ptr);
+    block->next = head;
+    head = block;
+    ++size;
+  }
+
+  void* pop() noexcept
+  {
+    auto* block = head;
+    head = block->next;
+    --size;
+    return block;
+  }
+
+  /**
+   * Removes the first n blocks from this list and returns them as a new list.
+   */
+  free_list split(const std::size_t n) noexcept
+  {
+    auto result = free_list{head, n};
+    auto* last = head;
+    for (std::size_t i = 1; i < n; ++i)
+    {
+      last = last->next;
+    }
+    head = last->next;
+    last->next = nullptr;
+    size -= n;
+    return result;
+  }
+};
+
+/**
+ * A pool of fixed size memory blocks that is shared by all threads.
+ *
+ * Memory is requested from the system in slabs of `batch_size` blocks, which are handed
+ * out to the per thread caches in batches. Batches that are returned by the thread caches
+ * are kept for reuse. The memory is never returned to the system.
+ */
+template <std::size_t BlockSize, std::size_t BlockAlign, std::size_t BatchSize>
+class shared_block_pool
+{
+private:
+  std::mutex m_mutex;
+  std::vector<free_list> m_batches;
+
+public:
+  static shared_block_pool& instance()
+  {
+    // never destroyed so that threads exiting during static destruction can still return
+    // their cached blocks
+    static auto* pool = new shared_block_pool{};
+    return *pool;
+  }
+
+  free_list acquire_batch()
+  {
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      if (!m_batches.empty())
+      {
+        auto result = m_batches.back();
+        m_batches.pop_back();
+        return result;
+      }
+    }
+
+    auto* slab = static_cast<std::byte*>(
+      ::operator new(BlockSize * BatchSize, std::align_val_t{BlockAlign}));
+
+    auto result = free_list{};
+    for (std::size_t i = 0; i < BatchSize; ++i)
+    {
+      result.push(slab + (BatchSize - i - 1) * BlockSize);
+    }
+    return result;
+  }
+
+  void release_batch(const free_list batch)
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    m_batches.push_back(batch);
+  }
+};
+
+/**
+ * Caches free blocks for the current thread so that most allocations and deallocations
+ * don't need to synchronize with other threads.
+ *
+ * The cache is trivially destructible so that it remains usable while other thread local
+ * or static objects are destroyed.
+ */
+template <std::size_t BlockSize, std::size_t BlockAlign, std::size_t BatchSize>
+class thread_block_cache
+{
+private:
+  using shared_pool = shared_block_pool<BlockSize, BlockAlign, BatchSize>;
+
+  free_list m_free;
+
+public:
+  void* allocate()
+  {
+    if (m_free.size == 0)
+    {
+      m_free = shared_pool::instance().acquire_batch();
+    }
+    return m_free.pop();
+  }
+
+  void deallocate(void* ptr) noexcept
+  {
+    m_free.push(ptr);
+    if (m_free.size >= 2 * BatchSize)
+    {
+      // return one batch so that blocks freed by one thread can be reused by others
+      shared_pool::instance().release_batch(m_free.split(BatchSize));
+    }
+  }
+
+  /**
+   * Returns all cached blocks to the shared pool.
+   */
+  void flush()
+  {
+    while (m_free.size > 0)
+    {
+      shared_pool::instance().release_batch(
+        m_free.split(std::min(m_free.size, BatchSize)));
+    }
+  }
+};
+
+/**
+ * Flushes the given cache when the current thread exits.
+ */
+template <typename Cache>
+struct thread_block_cache_flusher
+{
+  Cache& cache;
+
+  ~thread_block_cache_flusher() { cache.flush(); }
+};
+
+} // namespace detail
+
+/**
+ * Allocates memory for objects of type T from a pool of fixed size blocks.
+ *
+ * Each thread keeps a cache of free blocks, so that allocating and deallocating is
+ * usually just a matter of pushing or popping a block from a thread local list. Blocks
+ * may be deallocated by a different thread than the one that allocated them. Types of the
+ * same size and alignment share the memory held by the pool.
+ *
+ * The memory held by the pool is never returned to the system, but it is reused for
+ * subsequent allocations.
+ *
+ * This is meant to be used in class specific allocation functions:
+ *
+ * static void* operator new(std::size_t) { return kdl::object_pool<T>::allocate(); }
+ * static void operator delete(void* ptr) { kdl::object_pool<T>::deallocate(ptr); }
+ */
+template <typename T, std::size_t BatchSize = 256>
+class object_pool
+{
+private:
+  static auto& cache()
+  {
+    constexpr auto block_align = std::max(alignof(T), alignof(detail::free_block));
+    constexpr auto block_size =
+      (std::max(sizeof(T), sizeof(detail::free_block)) + block_align - 1) / block_align
+      * block_align;
+
+    using cache_type = detail::thread_block_cache<block_size, block_align, BatchSize>;
+
+    static thread_local auto cache = cache_type{};
+    [[maybe_unused]] static thread_local auto flusher =
+      detail::thread_block_cache_flusher<cache_type>{cache};
+    return cache;
+  }
+
+public:
+  static void* allocate() { return cache().allocate(); }
+
+  static void deallocate(void* ptr) noexcept
+  {
+    if (ptr)
+    {
+      cache().deallocate(ptr);
+    }
+  }
+};
+
+} // namespace kdl
@@ -20,84 +20,170 @@
 
 #pragma once
 
+#include "kdl/task_scheduler.h"
 #include "kdl/vector_utils.h"
 
-#ifdef _WIN32
-#include <ppl.h>
-#endif
-
+#include <algorithm>
 #include <atomic>
-#include <future> // for std::async
+#include <exception>
+#include <mutex>
 #include <optional>
 #include <thread>
-#include <utility> // for std::declval
+#include <utility> // for std::declval, std::exchange
 #include <vector>
 
 namespace kdl
 {
+namespace detail
+{
+inline bool& run_serially()
+{
+  thread_local auto value = false;
+  return value;
+}
+} // namespace detail
+
 /**
- * Runs the given lambda `count` times, passing it indices `0` through `count - 1`.
+ * While an instance of this class exists, the parallel loops started by the thread that
+ * created it run all of their work on that thread. This is useful to measure how much a
+ * parallel loop gains over a serial one, or to debug the work done by a parallel loop.
+ */
+class serial_scope
+{
+private:
+  bool m_previous;
+
+public:
+  serial_scope()
+    : m_previous{std::exchange(detail::run_serially(), true)}
+  {
+  }
+
+  ~serial_scope() { detail::run_serially() = m_previous; }
+
+  serial_scope(const serial_scope&) = delete;
+  serial_scope(serial_scope&&) = delete;
+  serial_scope& operator=(const serial_scope&) = delete;
+  serial_scope& operator=(serial_scope&&) = delete;
+};
+
+/**
+ * Splits the range `0` through `count - 1` into chunks of at most `grain_size` indices
+ * and runs the given lambda once per chunk, passing it the chunk's first index and the
+ * index one past its last.
+ *
+ * The chunks are executed by the process wide task scheduler (see
+ * `global_task_scheduler`). The calling thread participates in executing the chunks
+ * and returns once all of them have completed, so this may be called from within
+ * another parallel loop.
  *
- * Lambda is executed in parallel, using the number of threads returned by
- * std::thread::hardware_concurrency().
+ * If the lambda throws, the remaining chunks are still executed, and the first exception
+ * is rethrown on the calling thread.
  *
- * Because the threads are spawned with std::async(std::launch::async, ...) and no thread
- * pool is used, there is a relatively large overhead and this should only be used on
- * large/slow to process data sets.
+ * If the calling thread has created a `serial_scope`, the chunks are executed in order on
+ * the calling thread.
  *
  * @tparam L type of lambda
- * @param count the maximum value (exclusive) to pass to lambda
- * @param lambda the lambda to run
+ * @param count the maximum value (exclusive) of the range
+ * @param grain_size the maximum number of indices per chunk, 0 means that a chunk size
+ * is chosen depending on the number of workers
+ * @param lambda the lambda to run, must be of type `void(size_t, size_t)`
  */
 template <class L>
-void parallel_for(const size_t count, L&& lambda)
+void parallel_for_chunked(const size_t count, size_t grain_size, L&& lambda)
 {
-#ifdef _WIN32
-  concurrency::parallel_for<size_t>(0, count, lambda);
-#else
-  size_t numThreads = static_cast<size_t>(std::thread::hardware_concurrency());
-  if (numThreads == 0)
+  if (count == 0)
   {
-    numThreads = 1;
+    return;
   }
 
-  std::atomic<size_t> nextIndex(0);
-
-  std::vector<std::future<void>> threads;
-  threads.resize(numThreads);
+  auto& scheduler = global_task_scheduler();
+  if (grain_size == 0)
+  {
+    // create a few chunks per thread so that stealing can balance uneven workloads
+    const auto max_chunk_count = (scheduler.worker_count() + 1) * 4;
+    grain_size = (count + max_chunk_count - 1) / max_chunk_count;
+  }
 
-  for (size_t i = 0; i < numThreads; ++i)
+  const auto chunk_count = (count + grain_size - 1) / grain_size;
+  if (chunk_count == 1 || scheduler.worker_count() == 0 || detail::run_serially())
   {
-    threads[i] = std::async(std::launch::async, [&]() {
-      while (true)
+    for (size_t begin = 0; begin < count; begin += grain_size)
+    {
+      lambda(begin, std::min(begin + grain_size, count));
+    }
+    return;
+  }
+
+  auto remaining = std::atomic<size_t>{chunk_count};
+  auto exception_mutex = std::mutex{};
+  auto exception = std::exception_ptr{};
+
+  const auto run_chunk = [&](const size_t chunk) {
+    const auto begin = chunk * grain_size;
+    const auto end = std::min(begin + grain_size, count);
+    try
+    {
+      lambda(begin, end);
+    }
+    catch (...)
+    {
+      auto lock = std::lock_guard{exception_mutex};
+      if (!exception)
       {
-        const size_t ourIndex = std::atomic_fetch_add(&nextIndex, static_cast<size_t>(1));
-        if (ourIndex >= count)
-        {
-          break;
-        }
-        lambda(ourIndex);
+        exception = std::current_exception();
       }
-    });
+    }
+    --remaining;
+  };
+
+  for (size_t chunk = 1; chunk < chunk_count; ++chunk)
+  {
+    scheduler.submit([&, chunk]() { run_chunk(chunk); });
   }
+  run_chunk(0);
 
-  for (size_t i = 0; i < numThreads; ++i)
+  while (remaining > 0)
   {
-    threads[i].wait();
+    if (!scheduler.run_pending_task())
+    {
+      std::this_thread::yield();
+    }
   }
-#endif
+
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+/**
+ * Runs the given lambda `count` times, passing it indices `0` through `count - 1`.
+ *
+ * The indices are split into chunks which are executed in parallel by the process wide
+ * task scheduler, see `parallel_for_chunked`.
+ *
+ * @tparam L type of lambda
+ * @param count the maximum value (exclusive) to pass to lambda
+ * @param lambda the lambda to run
+ */
+template <class L>
+void parallel_for(const size_t count, L&& lambda)
+{
+  parallel_for_chunked(count, 0, [&](const size_t begin, const size_t end) {
+    for (size_t i = begin; i < end; ++i)
+    {
+      lambda(i);
+    }
+  });
 }
 
 /**
  * Applies the given lambda to each element of the input (passing elements as rvalue
  * references), and returns a vector of the resulting values, in their original order.
  *
- * The lambda is executed in parallel, using the number of threads returned by
- * std::thread::hardware_concurrency().
- *
- * Because the threads are spawned with std::async(std::launch::async, ...) and no thread
- * pool is used, there is a relatively large overhead and this should only be used on
- * large/slow to process data sets.
+ * The lambda is executed in parallel by the process wide task scheduler, see
+ * `parallel_for`.
  *
  * @tparam T the type of the vector elements
  * @tparam L the type of the lambda to apply
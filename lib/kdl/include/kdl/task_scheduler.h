@@ -0,0 +1,338 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace kdl
+{
+
+/**
+ * A work stealing task scheduler backed by a fixed set of persistent worker threads.
+ *
+ * Every worker owns a task queue. Tasks submitted from a worker thread are pushed onto
+ * that worker's queue and are taken from the back (LIFO) by the owner, while idle
+ * workers steal from the front (FIFO) of other workers' queues. Tasks submitted from
+ * other threads are placed in a shared injection queue.
+ *
+ * Threads waiting for submitted tasks to complete should call `run_pending_task` in a
+ * loop instead of blocking. This lets the waiting thread help execute the outstanding
+ * work and makes it safe to submit and wait for tasks from within a running task, i.e.,
+ * nested parallelism does not deadlock even if all workers are busy.
+ *
+ * A scheduler with zero workers is valid. In that case, submitted tasks are only
+ * executed by threads calling `run_pending_task`.
+ */
+class task_scheduler
+{
+public:
+  using task = std::function<void()>;
+
+private:
+  struct task_queue
+  {
+    std::mutex mutex;
+    std::deque<task> tasks;
+  };
+
+  static constexpr std::size_t no_worker = static_cast<std::size_t>(-1);
+
+  task_queue m_injected;
+  std::vector<std::unique_ptr<task_queue>> m_queues;
+  std::vector<std::thread> m_workers;
+
+  std::atomic<std::size_t> m_pending = 0;
+  std::mutex m_sleep_mutex;
+  std::condition_variable m_sleep_condition;
+  bool m_stop = false;
+
+  struct worker_identity
+  {
+    const task_scheduler* scheduler = nullptr;
+    std::size_t index = no_worker;
+  };
+
+  static worker_identity& current_worker()
+  {
+    static thread_local auto identity = worker_identity{};
+    return identity;
+  }
+
+public:
+  /**
+   * Creates a scheduler and starts the given number of worker threads.
+   */
+  explicit task_scheduler(const std::size_t worker_count)
+  {
+    m_queues.reserve(worker_count);
+    for (std::size_t i = 0; i < worker_count; ++i)
+    {
+      m_queues.push_back(std::make_unique<task_queue>());
+    }
+
+    m_workers.reserve(worker_count);
+    for (std::size_t i = 0; i < worker_count; ++i)
+    {
+      m_workers.emplace_back([this, i]() { run_worker(i); });
+    }
+  }
+
+  /**
+   * Stops all workers after they have drained the pending tasks and joins them.
+   */
+  ~task_scheduler()
+  {
+    {
+      auto lock = std::lock_guard{m_sleep_mutex};
+      m_stop = true;
+    }
+    m_sleep_condition.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+      worker.join();
+    }
+  }
+
+  task_scheduler(const task_scheduler&) = delete;
+  task_scheduler(task_scheduler&&) = delete;
+  task_scheduler& operator=(const task_scheduler&) = delete;
+  task_scheduler& operator=(task_scheduler&&) = delete;
+
+  /**
+   * Returns the number of worker threads owned by this scheduler.
+   */
+  std::size_t worker_count() const { return m_workers.size(); }
+
+  /**
+   * Indicates whether the calling thread is one of this scheduler's workers.
+   */
+  bool is_worker_thread() const { return current_worker().scheduler == this; }
+
+  /**
+   * Submits the given task for execution. The task must not throw; callers that need
+   * exception propagation must catch and transport exceptions themselves.
+   */
+  void submit(task t)
+  {
+    {
+      // count the task before publishing it so that m_pending never underflows
+      auto lock = std::lock_guard{m_sleep_mutex};
+      ++m_pending;
+    }
+
+    auto& queue = own_queue();
+    {
+      auto lock = std::lock_guard{queue.mutex};
+      queue.tasks.push_back(std::move(t));
+    }
+    m_sleep_condition.notify_one();
+  }
+
+  /**
+   * Takes a single pending task and executes it on the calling thread.
+   *
+   * @return true if a task was executed and false if no task was available
+   */
+  bool run_pending_task()
+  {
+    if (auto t = take_task())
+    {
+      (*t)();
+      return true;
+    }
+    return false;
+  }
+
+private:
+  std::size_t own_index() const
+  {
+    const auto& identity = current_worker();
+    return identity.scheduler == this ? identity.index : no_worker;
+  }
+
+  task_queue& own_queue()
+  {
+    const auto index = own_index();
+    return index != no_worker ? *m_queues[index] : m_injected;
+  }
+
+  std::optional<task> take_task()
+  {
+    const auto index = own_index();
+
+    if (index != no_worker)
+    {
+      if (auto t = pop_back(*m_queues[index]))
+      {
+        return t;
+      }
+    }
+
+    if (auto t = pop_front(m_injected))
+    {
+      return t;
+    }
+
+    const auto queue_count = m_queues.size();
+    const auto first = index != no_worker ? index + 1 : 0;
+    for (std::size_t i = 0; i < queue_count; ++i)
+    {
+      const auto victim = (first + i) % queue_count;
+      if (victim != index)
+      {
+        if (auto t = pop_front(*m_queues[victim]))
+        {
+          return t;
+        }
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  std::optional<task> pop_back(task_queue& queue)
+  {
+    auto lock = std::lock_guard{queue.mutex};
+    if (queue.tasks.empty())
+    {
+      return std::nullopt;
+    }
+
+    auto t = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    --m_pending;
+    return t;
+  }
+
+  std::optional<task> pop_front(task_queue& queue)
+  {
+    auto lock = std::lock_guard{queue.mutex};
+    if (queue.tasks.empty())
+    {
+      return std::nullopt;
+    }
+
+    auto t = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    --m_pending;
+    return t;
+  }
+
+  void run_worker(const std::size_t index)
+  {
+    current_worker() = worker_identity{this, index};
+
+    while (true)
+    {
+      if (run_pending_task())
+      {
+        continue;
+      }
+
+      auto lock = std::unique_lock{m_sleep_mutex};
+      m_sleep_condition.wait(lock, [&]() { return m_stop || m_pending > 0; });
+      if (m_stop && m_pending == 0)
+      {
+        return;
+      }
+    }
+  }
+};
+
+namespace detail
+{
+inline std::size_t default_worker_count()
+{
+  // the thread that submits work also helps executing it
+  const auto hardware_threads =
+    static_cast<std::size_t>(std::thread::hardware_concurrency());
+  return hardware_threads > 1 ? hardware_threads - 1 : 0;
+}
+
+struct global_task_scheduler_state
+{
+  std::mutex mutex;
+  std::optional<std::size_t> worker_count;
+  std::unique_ptr<task_scheduler> scheduler;
+};
+
+inline global_task_scheduler_state& global_task_scheduler()
+{
+  static auto state = global_task_scheduler_state{};
+  return state;
+}
+} // namespace detail
+
+/**
+ * Sets the number of worker threads used by the process wide task scheduler returned by
+ * `global_task_scheduler`.
+ *
+ * This only has an effect if it is called before the global scheduler is used for the
+ * first time.
+ *
+ * @param worker_count the number of workers, 0 means that all work is done by the
+ * threads that wait for it
+ * @return true if the worker count was applied and false if the scheduler is already
+ * running
+ */
+inline bool set_global_task_scheduler_worker_count(const std::size_t worker_count)
+{
+  auto& state = detail::global_task_scheduler();
+  auto lock = std::lock_guard{state.mutex};
+  if (state.scheduler)
+  {
+    return false;
+  }
+
+  state.worker_count = worker_count;
+  return true;
+}
+
+/**
+ * Returns the process wide task scheduler, creating it on first use.
+ *
+ * Unless configured otherwise using `set_global_task_scheduler_worker_count`, the
+ * scheduler creates one worker less than the number of hardware threads since the
+ * thread that waits for submitted work participates in executing it.
+ */
+inline task_scheduler& global_task_scheduler()
+{
+  auto& state = detail::global_task_scheduler();
+  auto lock = std::lock_guard{state.mutex};
+  if (!state.scheduler)
+  {
+    state.scheduler = std::make_unique<task_scheduler>(
+      state.worker_count.value_or(detail::default_worker_count()));
+  }
+  return *state.scheduler;
+}
+
+} // namespace kdl
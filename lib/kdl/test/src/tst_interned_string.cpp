@@ -0,0 +1,113 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/interned_string.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "catch2.h"
+
+namespace kdl
+{
+
+TEST_CASE("interned_string")
+{
+  SECTION("default constructor")
+  {
+    CHECK(interned_string{}.empty());
+    CHECK(interned_string{} == interned_string{""});
+  }
+
+  SECTION("equal strings are interned once")
+  {
+    const auto s = std::string{"some string"};
+    const auto a = interned_string{s};
+    const auto b = interned_string{"some string"};
+
+    CHECK(a == b);
+    CHECK(a.id() == b.id());
+    CHECK(&a.str() == &b.str());
+    CHECK(a.str() == s);
+    CHECK(static_cast<const std::string&>(a) == s);
+  }
+
+  SECTION("different strings")
+  {
+    const auto a = interned_string{"a"};
+    const auto b = interned_string{"b"};
+
+    CHECK(a != b);
+    CHECK(a.id() != b.id());
+    CHECK(a < b);
+    CHECK_FALSE(b < a);
+    CHECK_FALSE(a < a);
+    CHECK(a <= a);
+    CHECK(b > a);
+    CHECK(b >= a);
+  }
+
+  SECTION("hash")
+  {
+    const auto set = std::unordered_set<interned_string>{
+      interned_string{"a"}, interned_string{"b"}, interned_string{"a"}};
+    CHECK(set.size() == 2u);
+    CHECK(set.count(interned_string{"b"}) == 1u);
+  }
+
+  SECTION("stream insertion")
+  {
+    auto str = std::stringstream{};
+    str << interned_string{"name"};
+    CHECK(str.str() == "name");
+  }
+
+  SECTION("concurrent interning")
+  {
+    constexpr auto thread_count = 4u;
+    constexpr auto string_count = 1000u;
+
+    auto results = std::vector<std::vector<interned_string>>(thread_count);
+    auto threads = std::vector<std::thread>{};
+    for (size_t t = 0; t < thread_count; ++t)
+    {
+      threads.emplace_back([&, t]() {
+        for (size_t i = 0; i < string_count; ++i)
+        {
+          results[t].emplace_back("concurrent " + std::to_string(i));
+        }
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    for (size_t t = 1; t < thread_count; ++t)
+    {
+      CHECK(results[t] == results[0]);
+    }
+  }
+}
+
+} // namespace kdl
@@ -0,0 +1,103 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/object_pool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "catch2.h"
+
+namespace kdl
+{
+namespace
+{
+struct pooled
+{
+  std::uint64_t value;
+  char padding[24];
+
+  explicit pooled(const std::uint64_t i_value)
+    : value{i_value}
+  {
+  }
+
+  static void* operator new(std::size_t) { return object_pool<pooled, 16>::allocate(); }
+  static void operator delete(void* ptr) { object_pool<pooled, 16>::deallocate(ptr); }
+};
+} // namespace
+
+TEST_CASE("object_pool")
+{
+  SECTION("allocated objects don't overlap")
+  {
+    auto objects = std::vector<pooled*>{};
+    for (std::uint64_t i = 0; i < 100; ++i)
+    {
+      objects.push_back(new pooled{i});
+    }
+
+    for (std::uint64_t i = 0; i < 100; ++i)
+    {
+      CHECK(objects[i]->value == i);
+    }
+
+    auto sorted = objects;
+    std::sort(sorted.begin(), sorted.end());
+    CHECK(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+
+    for (auto* object : objects)
+    {
+      delete object;
+    }
+  }
+
+  SECTION("freed blocks are reused")
+  {
+    auto* first = new pooled{1};
+    delete first;
+
+    auto* second = new pooled{2};
+    CHECK(second == first);
+    delete second;
+  }
+
+  SECTION("objects can be freed by another thread")
+  {
+    auto objects = std::vector<pooled*>{};
+    auto allocator = std::thread{[&]() {
+      for (std::uint64_t i = 0; i < 1000; ++i)
+      {
+        objects.push_back(new pooled{i});
+      }
+    }};
+    allocator.join();
+
+    for (std::uint64_t i = 0; i < 1000; ++i)
+    {
+      CHECK(objects[i]->value == i);
+      delete objects[i];
+    }
+  }
+}
+
+} // namespace kdl
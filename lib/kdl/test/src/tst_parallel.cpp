@@ -22,11 +22,14 @@
 
 #include "kdl/parallel.h"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "catch2.h"
@@ -73,6 +76,97 @@ TEST_CASE("for 10000")
   }
 }
 
+TEST_CASE("for nested")
+{
+  constexpr size_t OuterSize = 64;
+  constexpr size_t InnerSize = 64;
+
+  auto counter = std::atomic<size_t>{0};
+  kdl::parallel_for(OuterSize, [&](const size_t) {
+    kdl::parallel_for(InnerSize, [&](const size_t) {
+      std::atomic_fetch_add(&counter, static_cast<size_t>(1));
+    });
+  });
+
+  CHECK(static_cast<size_t>(counter) == OuterSize * InnerSize);
+}
+
+TEST_CASE("for rethrows exception")
+{
+  CHECK_THROWS_AS(
+    kdl::parallel_for(
+      1000,
+      [](const size_t i) {
+        if (i == 500)
+        {
+          throw std::runtime_error{"error"};
+        }
+      }),
+    std::runtime_error);
+}
+
+TEST_CASE("for chunked")
+{
+  constexpr size_t TestSize = 1'000;
+
+  std::array<std::atomic<size_t>, TestSize> visits;
+  for (auto& visit : visits)
+  {
+    visit = 0;
+  }
+
+  auto chunkCount = std::atomic<size_t>{0};
+  auto maxChunkSize = std::atomic<size_t>{0};
+  kdl::parallel_for_chunked(TestSize, 100, [&](const size_t begin, const size_t end) {
+    std::atomic_fetch_add(&chunkCount, static_cast<size_t>(1));
+
+    // Catch2 assertions are not thread safe, so only record the chunk size here
+    auto currentMax = maxChunkSize.load();
+    while (currentMax < end - begin
+           && !maxChunkSize.compare_exchange_weak(currentMax, end - begin))
+    {
+    }
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      std::atomic_fetch_add(&visits[i], static_cast<size_t>(1));
+    }
+  });
+
+  CHECK(chunkCount <= 10);
+  CHECK(maxChunkSize <= 100);
+  for (const auto& visit : visits)
+  {
+    CHECK(visit == 1);
+  }
+}
+
+TEST_CASE("serial scope")
+{
+  constexpr size_t TestSize = 1'000;
+
+  const auto callingThread = std::this_thread::get_id();
+  auto visits = std::vector<size_t>{};
+  auto otherThreadCount = size_t(0);
+  {
+    const auto serial = kdl::serial_scope{};
+    kdl::parallel_for_chunked(TestSize, 10, [&](const size_t begin, const size_t end) {
+      if (std::this_thread::get_id() != callingThread)
+      {
+        ++otherThreadCount;
+      }
+      for (size_t i = begin; i < end; ++i)
+      {
+        visits.push_back(i);
+      }
+    });
+  }
+
+  CHECK(otherThreadCount == 0);
+  CHECK(visits.size() == TestSize);
+  CHECK(std::is_sorted(visits.begin(), visits.end()));
+}
+
 TEST_CASE("transform")
 {
   const auto L = [](const int& v) { return v * 10; };
@@ -0,0 +1,117 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/task_scheduler.h"
+
+#include <atomic>
+#include <thread>
+
+#include "catch2.h"
+
+namespace kdl
+{
+namespace
+{
+void wait_for(task_scheduler& scheduler, const std::atomic<size_t>& counter, size_t n)
+{
+  while (counter < n)
+  {
+    if (!scheduler.run_pending_task())
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("task_scheduler.worker_count")
+{
+  CHECK(task_scheduler{0}.worker_count() == 0u);
+  CHECK(task_scheduler{3}.worker_count() == 3u);
+}
+
+TEST_CASE("task_scheduler.run_pending_task")
+{
+  auto scheduler = task_scheduler{0};
+  CHECK_FALSE(scheduler.run_pending_task());
+
+  auto counter = std::atomic<size_t>{0};
+  scheduler.submit([&]() { ++counter; });
+  scheduler.submit([&]() { ++counter; });
+
+  CHECK(scheduler.run_pending_task());
+  CHECK(scheduler.run_pending_task());
+  CHECK_FALSE(scheduler.run_pending_task());
+  CHECK(counter == 2u);
+}
+
+TEST_CASE("task_scheduler.submit")
+{
+  auto scheduler = task_scheduler{4};
+  CHECK_FALSE(scheduler.is_worker_thread());
+
+  auto counter = std::atomic<size_t>{0};
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    scheduler.submit([&]() { ++counter; });
+  }
+
+  wait_for(scheduler, counter, 1000);
+  CHECK(counter == 1000u);
+}
+
+TEST_CASE("task_scheduler.nested_submit")
+{
+  auto scheduler = task_scheduler{2};
+
+  auto counter = std::atomic<size_t>{0};
+  for (size_t i = 0; i < 10; ++i)
+  {
+    scheduler.submit([&]() {
+      auto innerCounter = std::atomic<size_t>{0};
+      for (size_t j = 0; j < 10; ++j)
+      {
+        scheduler.submit([&]() { ++innerCounter; });
+      }
+
+      // waiting inside of a task must not deadlock
+      wait_for(scheduler, innerCounter, 10);
+      counter += innerCounter;
+    });
+  }
+
+  wait_for(scheduler, counter, 100);
+  CHECK(counter == 100u);
+}
+
+TEST_CASE("task_scheduler.destructor_drains_tasks")
+{
+  auto counter = std::atomic<size_t>{0};
+  {
+    auto scheduler = task_scheduler{2};
+    for (size_t i = 0; i < 100; ++i)
+    {
+      scheduler.submit([&]() { ++counter; });
+    }
+  }
+
+  CHECK(counter == 100u);
+}
+} // namespace kdl
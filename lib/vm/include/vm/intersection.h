@@ -30,7 +30,10 @@
 #include "vm/util.h"
 #include "vm/vec.h"
 
+#include <cstddef>
+#include <limits>
 #include <optional>
+#include <utility>
 
 namespace vm
 {
@@ -377,6 +380,74 @@ std::optional<T> intersect_ray_polygon(
   return std::nullopt;
 }
 
+/**
+ * Computes the point at which the given ray enters the convex polyhedron bounded by the
+ * given planes. The normals of the planes must point out of the polyhedron.
+ *
+ * The planes are passed in structure of arrays layout, i.e., the components of their
+ * normals and their distances are stored in separate arrays of equal length. This allows
+ * the compiler to vectorize the loop over the planes, and it avoids testing the ray
+ * against the polygons of the polyhedron's faces.
+ *
+ * @tparam T the component type
+ * @param r the ray
+ * @param normals_x the x components of the plane normals
+ * @param normals_y the y components of the plane normals
+ * @param normals_z the z components of the plane normals
+ * @param distances the plane distances
+ * @param count the number of planes
+ * @return the distance from the origin of the ray to the point at which the ray enters the
+ * polyhedron and the index of the plane through which it enters, or nullopt if the ray
+ * does not intersect the polyhedron or if its origin is inside of the polyhedron
+ */
+template <typename T>
+std::optional<std::pair<T, size_t>> intersect_ray_convex_polyhedron(
+  const ray<T, 3>& r,
+  const T* normals_x,
+  const T* normals_y,
+  const T* normals_z,
+  const T* distances,
+  const size_t count)
+{
+  constexpr auto epsilon = constants<T>::almost_zero();
+
+  auto entry_distance = -std::numeric_limits<T>::infinity();
+  auto exit_distance = std::numeric_limits<T>::infinity();
+  auto entry_index = count;
+  auto outside = false;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto d = normals_x[i] * r.direction.x() + normals_y[i] * r.direction.y()
+                   + normals_z[i] * r.direction.z();
+    const auto n = distances[i]
+                   - (normals_x[i] * r.origin.x() + normals_y[i] * r.origin.y()
+                      + normals_z[i] * r.origin.z());
+
+    const auto front = d < -epsilon;
+    const auto back = d > epsilon;
+    const auto s = n / (front || back ? d : T(1));
+
+    // a ray parallel to a plane misses if its origin is above that plane
+    outside = outside || (!front && !back && n < -epsilon);
+    exit_distance = back && s < exit_distance ? s : exit_distance;
+    if (front && s > entry_distance)
+    {
+      entry_distance = s;
+      entry_index = i;
+    }
+  }
+
+  if (
+    outside || entry_index == count || entry_distance < -epsilon
+    || entry_distance > exit_distance + epsilon)
+  {
+    return std::nullopt;
+  }
+
+  return std::pair{entry_distance, entry_index};
+}
+
 /**
  * Computes the point of intersection between the given ray and the given bounding box,
  * and returns the distance on the given ray from the ray's origin to that point.
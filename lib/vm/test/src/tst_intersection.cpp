@@ -313,6 +313,46 @@ TEST_CASE("intersection.intersect_ray_bbox")
   CHECK(intersect_ray_bbox(ray3f(origin, dir), bounds) == approx(length(diff)));
 }
 
+TEST_CASE("intersection.intersect_ray_convex_polyhedron")
+{
+  // the cube from (-1, -1, -1) to (1, 1, 1)
+  const auto nx = std::array<double, 6>{-1, 1, 0, 0, 0, 0};
+  const auto ny = std::array<double, 6>{0, 0, -1, 1, 0, 0};
+  const auto nz = std::array<double, 6>{0, 0, 0, 0, -1, 1};
+  const auto d = std::array<double, 6>{1, 1, 1, 1, 1, 1};
+
+  const auto intersect = [&](const ray3d& r) {
+    return intersect_ray_convex_polyhedron(
+      r, nx.data(), ny.data(), nz.data(), d.data(), nx.size());
+  };
+
+  CHECK(intersect(ray3d(vec3d(-3, 0, 0), vec3d::pos_x())) == std::pair{2.0, size_t(0)});
+  CHECK(intersect(ray3d(vec3d(3, 0, 0), vec3d::neg_x())) == std::pair{2.0, size_t(1)});
+  CHECK(intersect(ray3d(vec3d(0, 0, 5), vec3d::neg_z())) == std::pair{4.0, size_t(5)});
+  CHECK(intersect(ray3d(vec3d(0.5, -2, 0.5), vec3d::pos_y())) == std::pair{1.0, size_t(2)});
+
+  // through an edge and a corner
+  CHECK(intersect(ray3d(vec3d(-2, 1, 0), vec3d::pos_x())) == std::pair{1.0, size_t(0)});
+  const auto hit = intersect(ray3d(vec3d(-2, -2, -2), normalize(vec3d(1, 1, 1))));
+  REQUIRE(hit != std::nullopt);
+  CHECK(hit->first == approx(std::sqrt(3.0)));
+
+  // misses
+  CHECK(intersect(ray3d(vec3d(-3, 0, 0), vec3d::neg_x())) == std::nullopt);
+  CHECK(intersect(ray3d(vec3d(-3, 2, 0), vec3d::pos_x())) == std::nullopt);
+  CHECK(intersect(ray3d(vec3d(-3, 0, 0), vec3d::pos_y())) == std::nullopt);
+  CHECK(intersect(ray3d(vec3d(-3, 0, 0), normalize(vec3d(1, 1, 0)))) == std::nullopt);
+
+  // origin inside of the polyhedron
+  CHECK(intersect(ray3d(vec3d(0, 0, 0), vec3d::pos_x())) == std::nullopt);
+
+  // no planes
+  CHECK(
+    intersect_ray_convex_polyhedron(
+      ray3d(vec3d(0, 0, 0), vec3d::pos_x()), nx.data(), ny.data(), nz.data(), d.data(), 0)
+    == std::nullopt);
+}
+
 TEST_CASE("intersection.intersect_ray_sphere")
 {
   const ray3f ray(vec3f::zero(), vec3f::pos_z());